@@ -24,27 +24,139 @@ EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+
+    m_tick = 0;
+    m_eventCount = 0;
+    m_slots = NULL;
+    m_overflow = NULL;
+    for (uint32 i = 0; i < EVENT_WHEEL_LEVELS; ++i)
+        m_slotMask[i] = 0;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    delete [] m_slots;
 }
 
-uint32 EventProcessor::Update(uint32 p_time)
+void EventProcessor::Append(BasicEvent*& tail, BasicEvent* Event)
+{
+    if (tail)
+    {
+        Event->m_nextEvent = tail->m_nextEvent;
+        tail->m_nextEvent = Event;
+    }
+    else
+        Event->m_nextEvent = Event;
+
+    tail = Event;
+}
+
+// returns first event of the list, events are linked until NULL
+BasicEvent* EventProcessor::Detach(BasicEvent*& tail)
+{
+    if (!tail)
+        return NULL;
+
+    BasicEvent* head = tail->m_nextEvent;
+    tail->m_nextEvent = NULL;
+    tail = NULL;
+    return head;
+}
+
+// unlinks first event of the list
+BasicEvent* EventProcessor::PopFront(BasicEvent*& tail)
+{
+    if (!tail)
+        return NULL;
+
+    BasicEvent* head = tail->m_nextEvent;
+    if (head == tail)
+        tail = NULL;
+    else
+        tail->m_nextEvent = head->m_nextEvent;
+
+    head->m_nextEvent = NULL;
+    return head;
+}
+
+void EventProcessor::Schedule(BasicEvent* Event)
+{
+    // events already due go to current tick
+    uint64 e_time = Event->m_execTime > m_tick ? Event->m_execTime : m_tick;
+    uint64 delta = e_time - m_tick;
+
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS; ++level)
+    {
+        if (delta < (uint64(1) << (EVENT_WHEEL_BITS * (level + 1))))
+        {
+            uint32 slot = uint32(e_time >> (EVENT_WHEEL_BITS * level)) & EVENT_WHEEL_MASK;
+            Append(m_slots[level * EVENT_WHEEL_SIZE + slot], Event);
+            m_slotMask[level] |= 1u << slot;
+            return;
+        }
+    }
+
+    Append(m_overflow, Event);
+}
+
+// move events of the slots time just reached one level down, upper level
+// slot is reached only when the lower level wrapped around
+void EventProcessor::Cascade()
+{
+    for (uint32 level = 1; level < EVENT_WHEEL_LEVELS; ++level)
+    {
+        uint32 slot = uint32(m_tick >> (EVENT_WHEEL_BITS * level)) & EVENT_WHEEL_MASK;
+        if (m_slotMask[level] & (1u << slot))
+        {
+            m_slotMask[level] &= ~(1u << slot);
+            for (BasicEvent* Event = Detach(m_slots[level * EVENT_WHEEL_SIZE + slot]); Event;)
+            {
+                BasicEvent* next = Event->m_nextEvent;
+                Schedule(Event);
+                Event = next;
+            }
+        }
+
+        if (slot)
+            return;
+    }
+
+    for (BasicEvent* Event = Detach(m_overflow); Event;)
+    {
+        BasicEvent* next = Event->m_nextEvent;
+        Schedule(Event);
+        Event = next;
+    }
+}
+
+// next non empty level 0 slot in this revolution, or start of the next one
+uint64 EventProcessor::GetNextTick() const
+{
+    uint32 slot = uint32(m_tick) & EVENT_WHEEL_MASK;
+    uint32 mask = slot == EVENT_WHEEL_MASK ? 0 : m_slotMask[0] & ~((2u << slot) - 1);
+
+    if (!mask)
+        return (m_tick | EVENT_WHEEL_MASK) + 1;
+
+    while (!(mask & (1u << slot)))
+        ++slot;
+
+    return (m_tick & ~uint64(EVENT_WHEEL_MASK)) + slot;
+}
+
+uint32 EventProcessor::ExecuteSlot(uint32 p_time)
 {
     uint32 count = 0;
-    // update time
-    m_time += p_time;
+    uint32 slot = uint32(m_tick) & EVENT_WHEEL_MASK;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // events are taken one by one, so the rest stays in the slot, where KillAllEvents
+    // and HasEventOfType called from Execute see them. events added for current tick
+    // while executing land in the same slot
+    while (BasicEvent* Event = PopFront(m_slots[slot]))
     {
+        --m_eventCount;
         count++;
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
 
         if (!Event->to_Abort)
         {
@@ -60,6 +172,40 @@ uint32 EventProcessor::Update(uint32 p_time)
             delete Event;
         }
     }
+
+    m_slotMask[0] &= ~(1u << slot);
+    return count;
+}
+
+uint32 EventProcessor::Update(uint32 p_time)
+{
+    uint32 count = 0;
+    // update time
+    m_time += p_time;
+
+    // main event loop, visits only non empty slots and revolution starts
+    while (m_eventCount)
+    {
+        count += ExecuteSlot(p_time);
+
+        if (m_tick == m_time)
+            break;
+
+        uint64 next = GetNextTick();
+        if (next > m_time)
+        {
+            m_tick = m_time;
+            continue;
+        }
+
+        m_tick = next;
+        if (!(m_tick & EVENT_WHEEL_MASK))
+            Cascade();
+    }
+
+    if (!m_eventCount)
+        m_tick = m_time;
+
     return count;
 }
 
@@ -68,26 +214,40 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
+    if (!m_eventCount)
+        return;
+
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    BasicEvent* kept = NULL;
+    for (uint32 i = 0; i <= EVENT_WHEEL_LEVELS * EVENT_WHEEL_SIZE; ++i)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        BasicEvent*& tail = i < EVENT_WHEEL_LEVELS * EVENT_WHEEL_SIZE ? m_slots[i] : m_overflow;
+        if (i < EVENT_WHEEL_LEVELS * EVENT_WHEEL_SIZE)
+            m_slotMask[i / EVENT_WHEEL_SIZE] &= ~(1u << (i & EVENT_WHEEL_MASK));
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if(force || i_old->second->IsDeletable())
+        for (BasicEvent* Event = Detach(tail); Event;)
         {
-            delete i_old->second;
+            BasicEvent* next = Event->m_nextEvent;
+            --m_eventCount;
 
-            if(!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            Event->to_Abort = true;
+            Event->Abort(m_time);
+            if (force || Event->IsDeletable())
+                delete Event;
+            else                                            // need per-element cleanup
+                Append(kept, Event);
+
+            Event = next;
         }
     }
 
-    // fast clear event list (in force case)
-    if(force)
-        m_events.clear();
+    for (BasicEvent* Event = Detach(kept); Event;)
+    {
+        BasicEvent* next = Event->m_nextEvent;
+        Schedule(Event);
+        ++m_eventCount;
+        Event = next;
+    }
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -97,7 +257,38 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         e_time += m_time;
     }
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    if (!m_slots)
+    {
+        m_slots = new BasicEvent*[EVENT_WHEEL_LEVELS * EVENT_WHEEL_SIZE];
+        for (uint32 i = 0; i < EVENT_WHEEL_LEVELS * EVENT_WHEEL_SIZE; ++i)
+            m_slots[i] = NULL;
+    }
+
+    Schedule(Event);
+    ++m_eventCount;
 }
 
+bool EventProcessor::HasEventOfType(BasicEvent* type)
+{
+    if (!m_eventCount)
+        return false;
+
+    for (uint32 i = 0; i <= EVENT_WHEEL_LEVELS * EVENT_WHEEL_SIZE; ++i)
+    {
+        BasicEvent* tail = i < EVENT_WHEEL_LEVELS * EVENT_WHEEL_SIZE ? m_slots[i] : m_overflow;
+        if (!tail)
+            continue;
+
+        BasicEvent* Event = tail;
+        do
+        {
+            Event = Event->m_nextEvent;
+            if (typeid(*Event) == typeid(*type))
+                return true;
+        }
+        while (Event != tail);
+    }
 
+    return false;
+}
@@ -23,15 +23,15 @@
 
 #include "Platform/Define.h"
 
-#include <map>
 #include <typeinfo>
-#include <algorithm>
 // Note. All times are in milliseconds here.
 
 class HELLGROUND_IMPORT_EXPORT BasicEvent
 {
+    friend class EventProcessor;
+
     public:
-        BasicEvent() { to_Abort = false; }
+        BasicEvent() { to_Abort = false; m_nextEvent = NULL; }
         virtual ~BasicEvent()                               // override destructor to perform some actions on event removal
         {
         };
@@ -50,9 +50,21 @@ class HELLGROUND_IMPORT_EXPORT BasicEvent
 
         // these can be used for time offset control
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+
+    private:
+        BasicEvent* m_nextEvent;                            // next event in the same wheel slot
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+#define EVENT_WHEEL_LEVELS  4
+#define EVENT_WHEEL_BITS    5
+#define EVENT_WHEEL_SIZE    (1 << EVENT_WHEEL_BITS)
+#define EVENT_WHEEL_MASK    (EVENT_WHEEL_SIZE - 1)
+
+// Events are kept in a hierarchical timing wheel. Level 0 has one slot per
+// millisecond, each next level slot covers a whole revolution of the level
+// below and is moved down when time reaches it. Events further than all
+// levels cover wait in an overflow list. Slots are circular lists linked
+// through the events themselves, so adding an event allocates nothing.
 
 class HELLGROUND_IMPORT_EXPORT EventProcessor
 {
@@ -64,15 +76,30 @@ class HELLGROUND_IMPORT_EXPORT EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
 
-        bool HasEventOfType(BasicEvent* type)
-        {
-            return std::any_of(m_events.begin(), m_events.end(), [&type](std::pair<uint64, BasicEvent*> i) { return typeid(*i.second) == typeid(*type); });
-        };
+        bool HasEventOfType(BasicEvent* type);
 
     protected:
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+        EventProcessor(EventProcessor const&);
+        EventProcessor& operator=(EventProcessor const&);
+
+        void Schedule(BasicEvent* Event);
+        uint32 ExecuteSlot(uint32 p_time);
+        void Cascade();
+        uint64 GetNextTick() const;
+
+        static void Append(BasicEvent*& tail, BasicEvent* Event);
+        static BasicEvent* Detach(BasicEvent*& tail);
+        static BasicEvent* PopFront(BasicEvent*& tail);
+
+        uint64 m_tick;                                      // last tick of the wheel, m_time once update is done
+        uint32 m_eventCount;
+        BasicEvent** m_slots;                               // tails of slot lists, allocated with first event
+        uint32 m_slotMask[EVENT_WHEEL_LEVELS];              // non empty slots of each level
+        BasicEvent* m_overflow;
 };
 
 #endif
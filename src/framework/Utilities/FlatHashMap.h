@@ -0,0 +1,581 @@
+/*
+ * Copyright (C) 2008-2017 Hellground <http://wow-hellground.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef HELLGROUND_FLAT_HASH_MAP_H
+#define HELLGROUND_FLAT_HASH_MAP_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/*
+ * Open addressing hash containers for integer keys (guids).
+ *
+ * Slots live in one array and are probed linearly, so a lookup usually
+ * touches a single cache line instead of walking a node list. One key
+ * value (Empty, 0 by default) marks free slots and can not be stored.
+ */
+
+namespace FlatHash
+{
+    // fibonacci hashing, top bits of the product index the table
+    template<class K>
+    inline size_t Index(K key, uint32 shift)
+    {
+        return size_t((uint64(key) * UI64LIT(0x9E3779B97F4A7C15)) >> shift);
+    }
+
+    template<class K>
+    inline K const& KeyOf(K const& slot) { return slot; }
+
+    template<class K, class V>
+    inline K const& KeyOf(std::pair<K, V> const& slot) { return slot.first; }
+
+    template<class K>
+    inline void MakeEmpty(K& slot, K empty) { slot = empty; }
+
+    template<class K, class V>
+    inline void MakeEmpty(std::pair<K, V>& slot, K empty) { slot.first = empty; slot.second = V(); }
+}
+
+/// Table shared by FlatHashMap and FlatHashSet, Slot is the stored value.
+/// Not thread safe, erase keeps the table free of tombstones by shifting
+/// following entries back, so iterators are invalidated by any change.
+template<class K, class Slot, K Empty>
+class FlatHashTable
+{
+    public:
+        template<class S>
+        class iterator_base
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef S value_type;
+                typedef ptrdiff_t difference_type;
+                typedef S* pointer;
+                typedef S& reference;
+
+                iterator_base() : m_slot(NULL), m_end(NULL) {}
+                iterator_base(S* slot, S* end) : m_slot(slot), m_end(end) { skip(); }
+
+                S& operator*() const { return *m_slot; }
+                S* operator->() const { return m_slot; }
+
+                iterator_base& operator++() { ++m_slot; skip(); return *this; }
+                iterator_base operator++(int) { iterator_base tmp = *this; ++*this; return tmp; }
+
+                // iterator converts to const_iterator
+                operator iterator_base<S const>() const { return iterator_base<S const>(m_slot, m_end); }
+
+                bool operator==(iterator_base const& other) const { return m_slot == other.m_slot; }
+                bool operator!=(iterator_base const& other) const { return m_slot != other.m_slot; }
+
+            private:
+                void skip()
+                {
+                    while (m_slot != m_end && FlatHash::KeyOf(*m_slot) == Empty)
+                        ++m_slot;
+                }
+
+                S* m_slot;
+                S* m_end;
+        };
+
+        typedef iterator_base<Slot> iterator;
+        typedef iterator_base<Slot const> const_iterator;
+
+        FlatHashTable() : m_slots(NULL), m_mask(0), m_shift(64), m_size(0) {}
+
+        FlatHashTable(FlatHashTable const& other) : m_slots(NULL), m_mask(0), m_shift(64), m_size(0)
+        {
+            *this = other;
+        }
+
+        ~FlatHashTable() { delete [] m_slots; }
+
+        FlatHashTable& operator=(FlatHashTable const& other)
+        {
+            if (this == &other)
+                return *this;
+
+            delete [] m_slots;
+            m_slots = NULL;
+            m_mask = other.m_mask;
+            m_shift = other.m_shift;
+            m_size = other.m_size;
+
+            if (other.m_slots)
+            {
+                m_slots = new Slot[m_mask + 1];
+                for (size_t i = 0; i <= m_mask; ++i)
+                    m_slots[i] = other.m_slots[i];
+            }
+
+            return *this;
+        }
+
+        iterator begin() { return iterator(m_slots, m_slots + capacity()); }
+        iterator end() { return iterator(m_slots + capacity(), m_slots + capacity()); }
+        const_iterator begin() const { return const_iterator(m_slots, m_slots + capacity()); }
+        const_iterator end() const { return const_iterator(m_slots + capacity(), m_slots + capacity()); }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        size_t capacity() const { return m_slots ? m_mask + 1 : 0; }
+
+        iterator find(K key)
+        {
+            Slot* slot = lookup(key);
+            return slot ? iterator(slot, m_slots + capacity()) : end();
+        }
+
+        const_iterator find(K key) const
+        {
+            Slot const* slot = const_cast<FlatHashTable*>(this)->lookup(key);
+            return slot ? const_iterator(slot, m_slots + capacity()) : end();
+        }
+
+        size_t count(K key) const { return const_cast<FlatHashTable*>(this)->lookup(key) ? 1 : 0; }
+
+        size_t erase(K key)
+        {
+            if (!m_size)
+                return 0;
+
+            size_t i = FlatHash::Index(key, m_shift);
+            for (;;)
+            {
+                K const& k = FlatHash::KeyOf(m_slots[i]);
+                if (k == Empty)
+                    return 0;
+                if (k == key)
+                    break;
+                i = (i + 1) & m_mask;
+            }
+
+            // pull back every following entry that probed past the freed slot
+            size_t hole = i;
+            for (size_t j = (i + 1) & m_mask; FlatHash::KeyOf(m_slots[j]) != Empty; j = (j + 1) & m_mask)
+            {
+                size_t home = FlatHash::Index(FlatHash::KeyOf(m_slots[j]), m_shift);
+                if (((j - home) & m_mask) >= ((j - hole) & m_mask))
+                {
+                    m_slots[hole] = m_slots[j];
+                    hole = j;
+                }
+            }
+
+            FlatHash::MakeEmpty(m_slots[hole], Empty);
+            --m_size;
+            return 1;
+        }
+
+        void clear()
+        {
+            for (size_t i = 0; i < capacity(); ++i)
+                FlatHash::MakeEmpty(m_slots[i], Empty);
+            m_size = 0;
+        }
+
+        void reserve(size_t count)
+        {
+            size_t cap = 16;
+            while (cap * 3 < count * 4)
+                cap <<= 1;
+
+            if (cap > capacity())
+                rehash(cap);
+        }
+
+    protected:
+        Slot* lookup(K key)
+        {
+            if (!m_size)
+                return NULL;
+
+            for (size_t i = FlatHash::Index(key, m_shift);; i = (i + 1) & m_mask)
+            {
+                K const& k = FlatHash::KeyOf(m_slots[i]);
+                if (k == key)
+                    return &m_slots[i];
+                if (k == Empty)
+                    return NULL;
+            }
+        }
+
+        // slot holding key or free slot for it, second is true if it was free
+        std::pair<Slot*, bool> prepare(K key)
+        {
+            assert(key != Empty);
+
+            // grow at 3/4 load, linear probing degrades quickly above that
+            if ((m_size + 1) * 4 > capacity() * 3)
+                rehash(capacity() ? capacity() * 2 : 16);
+
+            for (size_t i = FlatHash::Index(key, m_shift);; i = (i + 1) & m_mask)
+            {
+                K const& k = FlatHash::KeyOf(m_slots[i]);
+                if (k == key)
+                    return std::make_pair(&m_slots[i], false);
+                if (k == Empty)
+                {
+                    ++m_size;
+                    return std::make_pair(&m_slots[i], true);
+                }
+            }
+        }
+
+        void rehash(size_t cap)
+        {
+            Slot* old = m_slots;
+            size_t oldCap = capacity();
+
+            m_slots = new Slot[cap];
+            m_mask = cap - 1;
+            m_shift = 64;
+            for (size_t c = cap; c > 1; c >>= 1)
+                --m_shift;
+
+            for (size_t i = 0; i < cap; ++i)
+                FlatHash::MakeEmpty(m_slots[i], Empty);
+
+            for (size_t i = 0; i < oldCap; ++i)
+            {
+                K const& k = FlatHash::KeyOf(old[i]);
+                if (k == Empty)
+                    continue;
+
+                size_t j = FlatHash::Index(k, m_shift);
+                while (FlatHash::KeyOf(m_slots[j]) != Empty)
+                    j = (j + 1) & m_mask;
+                m_slots[j] = old[i];
+            }
+
+            delete [] old;
+        }
+
+        Slot* m_slots;
+        size_t m_mask;
+        uint32 m_shift;
+        size_t m_size;
+};
+
+template<class K, class V, K Empty = 0>
+class FlatHashMap : public FlatHashTable<K, std::pair<K, V>, Empty>
+{
+    typedef FlatHashTable<K, std::pair<K, V>, Empty> Base;
+
+    public:
+        typedef std::pair<K, V> value_type;
+        typedef typename Base::iterator iterator;
+        typedef typename Base::const_iterator const_iterator;
+
+        std::pair<iterator, bool> insert(value_type const& value)
+        {
+            std::pair<value_type*, bool> slot = Base::prepare(value.first);
+            if (slot.second)
+                *slot.first = value;
+
+            return std::make_pair(iterator(slot.first, Base::m_slots + Base::capacity()), slot.second);
+        }
+
+        V& operator[](K key)
+        {
+            std::pair<value_type*, bool> slot = Base::prepare(key);
+            if (slot.second)
+                *slot.first = value_type(key, V());
+
+            return slot.first->second;
+        }
+};
+
+template<class K, K Empty = 0>
+class FlatHashSet : public FlatHashTable<K, K, Empty>
+{
+    typedef FlatHashTable<K, K, Empty> Base;
+
+    public:
+        typedef K value_type;
+        typedef typename Base::const_iterator iterator;
+        typedef typename Base::const_iterator const_iterator;
+
+        std::pair<iterator, bool> insert(K key)
+        {
+            std::pair<K*, bool> slot = Base::prepare(key);
+            if (slot.second)
+                *slot.first = key;
+
+            return std::make_pair(iterator(slot.first, Base::m_slots + Base::capacity()), slot.second);
+        }
+
+        // keys can not be changed through set iterators
+        const_iterator begin() const { return Base::begin(); }
+        const_iterator end() const { return Base::end(); }
+        const_iterator find(K key) const { return Base::find(key); }
+};
+
+/// Key -> pointer map whose lookups need no lock.
+/// Writers must be serialized by the caller. A key keeps its slot once
+/// inserted and erase only clears the pointer, so a reader racing with a
+/// writer finds either the old or the new pointer. Tables replaced by a
+/// rehash stay allocated until ReclaimRetired(), which must be called at
+/// a point where no reader can still hold one of them. Erase clears the
+/// key in retired tables as well, so a lookup that started before a rehash
+/// does not find pointers erased after it.
+template<class K, class T, K Empty = 0>
+class FlatConcurrentPtrMap
+{
+    struct Slot
+    {
+        std::atomic<K> key;
+        std::atomic<T*> value;
+    };
+
+    struct Table
+    {
+        explicit Table(size_t cap) : slots(new Slot[cap]), mask(cap - 1), shift(64), used(0), live(0)
+        {
+            for (size_t c = cap; c > 1; c >>= 1)
+                --shift;
+
+            for (size_t i = 0; i < cap; ++i)
+            {
+                slots[i].key.store(Empty, std::memory_order_relaxed);
+                slots[i].value.store(NULL, std::memory_order_relaxed);
+            }
+        }
+
+        ~Table() { delete [] slots; }
+
+        Slot* slots;
+        size_t mask;
+        uint32 shift;
+        size_t used;                                        // slots with a key, cleared ones included
+        size_t live;                                        // slots with a pointer
+    };
+
+    public:
+        /// iteration is only consistent while writers are held off
+        class const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef std::pair<K, T*> value_type;
+                typedef ptrdiff_t difference_type;
+                typedef value_type const* pointer;
+                typedef value_type const& reference;
+
+                const_iterator() : m_slot(NULL), m_end(NULL) {}
+                const_iterator(Slot* slot, Slot* end) : m_slot(slot), m_end(end) { skip(); }
+
+                std::pair<K, T*> const& operator*() const { return m_value; }
+                std::pair<K, T*> const* operator->() const { return &m_value; }
+
+                const_iterator& operator++() { ++m_slot; skip(); return *this; }
+
+                bool operator==(const_iterator const& other) const { return m_slot == other.m_slot; }
+                bool operator!=(const_iterator const& other) const { return m_slot != other.m_slot; }
+
+            private:
+                void skip()
+                {
+                    for (; m_slot != m_end; ++m_slot)
+                    {
+                        m_value.second = m_slot->value.load(std::memory_order_acquire);
+                        if (m_value.second)
+                        {
+                            m_value.first = m_slot->key.load(std::memory_order_relaxed);
+                            return;
+                        }
+                    }
+                }
+
+                Slot* m_slot;
+                Slot* m_end;
+                std::pair<K, T*> m_value;
+        };
+
+        typedef const_iterator iterator;
+
+        FlatConcurrentPtrMap() : m_table(new Table(64)) {}
+
+        ~FlatConcurrentPtrMap()
+        {
+            ReclaimRetired();
+            delete m_table.load(std::memory_order_relaxed);
+        }
+
+        const_iterator begin() const
+        {
+            Table* t = m_table.load(std::memory_order_acquire);
+            return const_iterator(t->slots, t->slots + t->mask + 1);
+        }
+
+        const_iterator end() const
+        {
+            Table* t = m_table.load(std::memory_order_acquire);
+            return const_iterator(t->slots + t->mask + 1, t->slots + t->mask + 1);
+        }
+
+        size_t size() const { return m_table.load(std::memory_order_acquire)->live; }
+        bool empty() const { return size() == 0; }
+
+        /// safe from any thread. Lookup racing with Erase may still return the erased
+        /// pointer, callers must not keep it past the point where erased objects are freed
+        /// (for object registries: past the map update the lookup was made in)
+        T* Find(K key) const
+        {
+            return Find(m_table.load(std::memory_order_acquire), key);
+        }
+
+        /// writer side, false if key already has a pointer
+        bool Insert(K key, T* value)
+        {
+            assert(key != Empty && value);
+
+            Table* t = m_table.load(std::memory_order_relaxed);
+            if ((t->used + 1) * 4 > (t->mask + 1) * 3)
+                t = Rehash();
+
+            for (size_t i = FlatHash::Index(key, t->shift);; i = (i + 1) & t->mask)
+            {
+                Slot& slot = t->slots[i];
+                K k = slot.key.load(std::memory_order_relaxed);
+                if (k == key)
+                {
+                    if (slot.value.load(std::memory_order_relaxed))
+                        return false;
+
+                    slot.value.store(value, std::memory_order_release);
+                    ++t->live;
+                    return true;
+                }
+
+                if (k == Empty)
+                {
+                    // pointer first, readers that see the key see it too
+                    slot.value.store(value, std::memory_order_relaxed);
+                    slot.key.store(key, std::memory_order_release);
+                    ++t->used;
+                    ++t->live;
+                    return true;
+                }
+            }
+        }
+
+        /// writer side, false if key has no pointer
+        bool Erase(K key)
+        {
+            Table* t = m_table.load(std::memory_order_relaxed);
+            for (size_t i = FlatHash::Index(key, t->shift);; i = (i + 1) & t->mask)
+            {
+                Slot& slot = t->slots[i];
+                K k = slot.key.load(std::memory_order_relaxed);
+                if (k == key)
+                {
+                    if (!slot.value.load(std::memory_order_relaxed))
+                        return false;
+
+                    slot.value.store(NULL, std::memory_order_release);
+                    --t->live;
+
+                    // readers still probing a retired table must not find it either
+                    for (typename std::vector<Table*>::iterator itr = m_retired.begin(); itr != m_retired.end(); ++itr)
+                        if (Slot* retired = FindSlot(*itr, key))
+                            retired->value.store(NULL, std::memory_order_release);
+
+                    return true;
+                }
+
+                if (k == Empty)
+                    return false;
+            }
+        }
+
+        /// writer side, frees tables replaced by rehash
+        void ReclaimRetired()
+        {
+            for (typename std::vector<Table*>::iterator itr = m_retired.begin(); itr != m_retired.end(); ++itr)
+                delete *itr;
+            m_retired.clear();
+        }
+
+        size_t RetiredCount() const { return m_retired.size(); }
+
+    private:
+        FlatConcurrentPtrMap(FlatConcurrentPtrMap const&);
+        FlatConcurrentPtrMap& operator=(FlatConcurrentPtrMap const&);
+
+        static Slot* FindSlot(Table* t, K key)
+        {
+            for (size_t i = FlatHash::Index(key, t->shift);; i = (i + 1) & t->mask)
+            {
+                K k = t->slots[i].key.load(std::memory_order_acquire);
+                if (k == key)
+                    return &t->slots[i];
+                if (k == Empty)
+                    return NULL;
+            }
+        }
+
+        static T* Find(Table* t, K key)
+        {
+            Slot* slot = FindSlot(t, key);
+            return slot ? slot->value.load(std::memory_order_acquire) : NULL;
+        }
+
+        // copies live entries to a table sized for them, drops cleared keys
+        Table* Rehash()
+        {
+            Table* old = m_table.load(std::memory_order_relaxed);
+
+            size_t cap = 64;
+            while (cap * 3 < (old->live + 1) * 8)
+                cap <<= 1;
+
+            Table* t = new Table(cap);
+            for (size_t i = 0; i <= old->mask; ++i)
+            {
+                T* value = old->slots[i].value.load(std::memory_order_relaxed);
+                if (!value)
+                    continue;
+
+                K key = old->slots[i].key.load(std::memory_order_relaxed);
+                size_t j = FlatHash::Index(key, t->shift);
+                while (t->slots[j].key.load(std::memory_order_relaxed) != Empty)
+                    j = (j + 1) & t->mask;
+
+                t->slots[j].value.store(value, std::memory_order_relaxed);
+                t->slots[j].key.store(key, std::memory_order_relaxed);
+                ++t->used;
+                ++t->live;
+            }
+
+            m_table.store(t, std::memory_order_release);
+            m_retired.push_back(old);
+            return t;
+        }
+
+        std::atomic<Table*> m_table;
+        std::vector<Table*> m_retired;
+};
+
+#endif
@@ -624,22 +624,6 @@ void WorldSession::HandleAuctionListItems(WorldPacket & recv_data)
     // always return pointer
     AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(auctionHouseEntry);
 
-    // Sort
-    AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
-    std::vector<AuctionEntry*> auctions;
-
-    bool sortEnabled = sWorld.getConfig(CONFIG_ENABLE_SORT_AUCTIONS);
-
-    if (sortEnabled)
-    {
-        auctions.reserve(aucs.size());
-        for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = aucs.begin(); itr != aucs.end(); ++itr)
-            auctions.push_back(itr->second);
-
-        AuctionSorter sorter(Sort, GetPlayer());
-        std::sort(auctions.begin(), auctions.end(), sorter);
-    }
-
     // remove fake death
     if (GetPlayer()->HasFlag(UNIT_FIELD_FLAGS_2, UNIT_FLAG2_FEIGN_DEATH))
         GetPlayer()->RemoveSpellsCausingAura(SPELL_AURA_FEIGN_DEATH);
@@ -659,15 +643,31 @@ void WorldSession::HandleAuctionListItems(WorldPacket & recv_data)
 
     wstrToLower(wsearchedname);
 
-    if (sortEnabled)
+    // candidates come from name index, or from class index when name is too short for it,
+    // other filters check only those
+    std::vector<AuctionEntry*> auctions;
+    if (isFull)
+        auctionHouse->GetAuctionsByClass(0xffffffff, 0xffffffff, auctions);
+    else if (!auctionHouse->GetAuctionsByName(wsearchedname, auctions))
+        auctionHouse->GetAuctionsByClass(auctionMainCategory, auctionSubCategory, auctions);
+
+    FilterAuctionItems(auctions, wsearchedname, levelmin, levelmax, usable, auctionSlotID, auctionMainCategory, auctionSubCategory, quality, isFull);
+
+    totalcount = auctions.size();
+    uint32 listBegin = isFull ? 0 : std::min<uint32>(listfrom, totalcount);
+    uint32 listEnd = isFull ? totalcount : std::min<uint32>(listBegin + 50, totalcount);
+
+    // only auctions up to requested page need to be in order
+    if (sWorld.getConfig(CONFIG_ENABLE_SORT_AUCTIONS) && listBegin < listEnd)
     {
-        BuildListAuctionItems(auctions, data, wsearchedname, listfrom, levelmin, levelmax, usable,
-            auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull);
+        AuctionSorter sorter(Sort, GetPlayer());
+        std::partial_sort(auctions.begin(), auctions.begin() + listEnd, auctions.end(), sorter);
     }
-    else
+
+    for (uint32 i = listBegin; i < listEnd; ++i)
     {
-        BuildListAuctionItems(aucs, data, wsearchedname, listfrom, levelmin, levelmax, usable,
-            auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull);
+        ++count;
+        auctions[i]->BuildAuctionInfo(data);
     }
 
     data.put<uint32>(0, count);
@@ -563,6 +563,126 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+#define AUCTION_CLASS_KEY(itemClass, itemSubClass) ((itemClass) << 16 | (itemSubClass))
+#define AUCTION_NAME_GRAM 3
+
+// key of three chars of name starting at pos, code points fit in 21 bits
+static uint64 AuctionNameGram(std::wstring const& name, size_t pos)
+{
+    return uint64(name[pos] & 0x1FFFFF) << 42 | uint64(name[pos + 1] & 0x1FFFFF) << 21 | uint64(name[pos + 2] & 0x1FFFFF);
+}
+
+static bool AuctionIdLess(AuctionEntry const* auc1, AuctionEntry const* auc2)
+{
+    return auc1->Id < auc2->Id;
+}
+
+void AuctionHouseObject::AddAuction(AuctionEntry *ah)
+{
+    ASSERT(ah);
+    AuctionsMap[ah->Id] = ah;
+
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(ah->itemTemplate);
+    if (!proto)
+        return;
+
+    if (Utf8toWStr(proto->Name1, ah->itemName))
+        wstrToLower(ah->itemName);
+
+    AuctionsByClass[AUCTION_CLASS_KEY(proto->Class, proto->SubClass)][ah->Id] = ah;
+
+    // new auctions get highest id, so this is mostly an append. a gram repeated in name is added once
+    for (size_t i = 0; i + AUCTION_NAME_GRAM <= ah->itemName.size(); ++i)
+    {
+        AuctionPostingList& list = AuctionsByName[AuctionNameGram(ah->itemName, i)];
+        AuctionPostingList::iterator pos = std::lower_bound(list.begin(), list.end(), ah, AuctionIdLess);
+        if (pos == list.end() || *pos != ah)
+            list.insert(pos, ah);
+    }
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    RemoveFromIndexes(itr->second);
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::RemoveFromIndexes(AuctionEntry* ah)
+{
+    for (size_t i = 0; i + AUCTION_NAME_GRAM <= ah->itemName.size(); ++i)
+    {
+        AuctionNameIndex::iterator itr = AuctionsByName.find(AuctionNameGram(ah->itemName, i));
+        if (itr == AuctionsByName.end())
+            continue;
+
+        AuctionPostingList::iterator pos = std::lower_bound(itr->second.begin(), itr->second.end(), ah, AuctionIdLess);
+        if (pos == itr->second.end() || *pos != ah)
+            continue;
+
+        itr->second.erase(pos);
+        if (itr->second.empty())
+            AuctionsByName.erase(itr);
+    }
+
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(ah->itemTemplate);
+    if (!proto)
+        return;
+
+    AuctionClassIndex::iterator itr = AuctionsByClass.find(AUCTION_CLASS_KEY(proto->Class, proto->SubClass));
+    if (itr == AuctionsByClass.end())
+        return;
+
+    itr->second.erase(ah->Id);
+    if (itr->second.empty())
+        AuctionsByClass.erase(itr);
+}
+
+void AuctionHouseObject::GetAuctionsByClass(uint32 itemClass, uint32 itemSubClass, std::vector<AuctionEntry*>& auctions) const
+{
+    AuctionClassIndex::const_iterator begin = AuctionsByClass.begin();
+    AuctionClassIndex::const_iterator end = AuctionsByClass.end();
+    if (itemClass != 0xffffffff)
+    {
+        begin = AuctionsByClass.lower_bound(AUCTION_CLASS_KEY(itemClass, itemSubClass != 0xffffffff ? itemSubClass : 0));
+        end = AuctionsByClass.upper_bound(AUCTION_CLASS_KEY(itemClass, itemSubClass != 0xffffffff ? itemSubClass : 0xffff));
+    }
+
+    for (AuctionClassIndex::const_iterator itr = begin; itr != end; ++itr)
+    {
+        if (itemSubClass != 0xffffffff && (itr->first & 0xffff) != itemSubClass)
+            continue;
+
+        for (AuctionEntryMap::const_iterator aItr = itr->second.begin(); aItr != itr->second.end(); ++aItr)
+            auctions.push_back(aItr->second);
+    }
+}
+
+bool AuctionHouseObject::GetAuctionsByName(std::wstring const& name, std::vector<AuctionEntry*>& auctions) const
+{
+    if (name.size() < AUCTION_NAME_GRAM)
+        return false;
+
+    // every part must be in the name, auctions of the rarest one are enough to check
+    AuctionPostingList const* rarest = NULL;
+    for (size_t i = 0; i + AUCTION_NAME_GRAM <= name.size(); ++i)
+    {
+        AuctionNameIndex::const_iterator itr = AuctionsByName.find(AuctionNameGram(name, i));
+        if (itr == AuctionsByName.end())
+            return true;
+
+        if (!rarest || itr->second.size() < rarest->size())
+            rarest = &itr->second;
+    }
+
+    auctions.insert(auctions.end(), rarest->begin(), rarest->end());
+    return true;
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
@@ -584,6 +704,7 @@ void AuctionHouseObject::Update()
 
                 itr->second->DeleteFromDB();
                 sAuctionMgr.RemoveAItem(itr->second->itemGuidLow);
+                RemoveFromIndexes(itr->second);
                 delete itr->second;
                 AuctionsMap.erase(itr++);
             }
@@ -771,11 +892,11 @@ bool AuctionSorter::operator()(const AuctionEntry *auc1, const AuctionEntry *auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
-    uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull)
+// drops auctions not matching search, order of the rest is kept
+void WorldSession::FilterAuctionItems(std::vector<AuctionEntry*>& auctions, std::wstring const& wsearchedname, uint32 levelmin,
+    uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, bool isFull)
 {
-    int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
-
+    std::vector<AuctionEntry*>::iterator last = auctions.begin();
     for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
     {
         AuctionEntry *Aentry = *itr;
@@ -783,12 +904,7 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
         if (!item)
             continue;
 
-        if (isFull)
-        {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
-        }
-        else
+        if (!isFull)
         {
             ItemPrototype const *proto = item->GetProto();
 
@@ -810,79 +926,14 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
             if (usable != 0x00 && !_player->CanUseItem(proto))
                 continue;
 
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
+            if (!wsearchedname.empty() && Aentry->itemName.find(wsearchedname) == std::wstring::npos)
                 continue;
-
-            if (count < 50 && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
         }
 
-        ++totalcount;
+        *last++ = Aentry;
     }
-}
-
-void WorldSession::BuildListAuctionItems(AuctionHouseObject::AuctionEntryMap const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
-    uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull)
-{
-    int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
-
-    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
-    {
-        AuctionEntry *Aentry = itr->second;
-        Item *item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
-            continue;
 
-        if (isFull)
-        {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
-        }
-        else
-        {
-            ItemPrototype const *proto = item->GetProto();
-
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-                continue;
-
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-                continue;
-
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-                continue;
-
-            if (quality != 0xffffffff && proto->Quality != quality)
-                continue;
-
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-                continue;
-
-            if (usable != 0x00 && !_player->CanUseItem(proto))
-                continue;
-
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
-
-            if (count < 50 && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
-        }
-
-        ++totalcount;
-    }
+    auctions.erase(last, auctions.end());
 }
 
 AuctionEntry* AuctionHouseObject::AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* it, uint32 etime, uint32 bid, uint32 buyout, uint32 deposit, Player * pl /*= NULL*/)
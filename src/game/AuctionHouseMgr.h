@@ -65,6 +65,7 @@ struct AuctionEntry
     int32 itemRandomPropertyId;
     uint32 owner;                                           // player low guid, can be 0 for server generated auction
     std::wstring ownerName;                                 // cache name for sorting
+    std::wstring itemName;                                  // cache lower case item name for searching
     uint32 startbid;                                        // start minimal bid value
     uint32 bid;                                             // current bid, =0 meaning no bids
     uint32 buyout;
@@ -102,6 +103,9 @@ class AuctionHouseObject
 
         typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
         typedef std::pair<AuctionEntryMap::const_iterator, AuctionEntryMap::const_iterator> AuctionEntryMapBounds;
+        typedef std::map<uint32, AuctionEntryMap> AuctionClassIndex;   // item class << 16 | subclass -> auctions
+        typedef std::vector<AuctionEntry*> AuctionPostingList;        // ordered by auction id
+        typedef UNORDERED_MAP<uint64, AuctionPostingList> AuctionNameIndex; // three chars of lower case item name -> auctions
 
         uint32 GetCount() { return AuctionsMap.size(); }
 
@@ -109,11 +113,7 @@ class AuctionHouseObject
 
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry *ah)
-        {
-            ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry *ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -121,10 +121,13 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : NULL;
         }
 
-        bool RemoveAuction(uint32 id)
-        {
-            return AuctionsMap.erase(id);
-        }
+        bool RemoveAuction(uint32 id);
+
+        // auctions of item class and subclass, 0xffffffff matches any, ordered by subclass then id
+        void GetAuctionsByClass(uint32 itemClass, uint32 itemSubClass, std::vector<AuctionEntry*>& auctions) const;
+        // auctions having all three char parts of lower case name, superset of auctions containing the name,
+        // ordered by id. false when name is too short for the index
+        bool GetAuctionsByName(std::wstring const& name, std::vector<AuctionEntry*>& auctions) const;
 
         void Update();
 
@@ -133,7 +136,11 @@ class AuctionHouseObject
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player * pl = NULL);
     private:
+        void RemoveFromIndexes(AuctionEntry* ah);
+
         AuctionEntryMap AuctionsMap;
+        AuctionClassIndex AuctionsByClass;
+        AuctionNameIndex AuctionsByName;
 };
 
 class AuctionSorter
@@ -0,0 +1,643 @@
+/*
+ * Copyright (C) 2008-2017 Hellground <http://wow-hellground.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/// \file
+/// .debug *bench commands, they time production code on the running server
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+#include "Player.h"
+#include "Chat.h"
+#include "World.h"
+#include "GridMap.h"
+#include "ObjectMgr.h"
+#include "AuctionHouseMgr.h"
+#include "MapManager.h"
+#include "UpdateData.h"
+#include "vmap/VMapFactory.h"
+#include "vmap/VMapCluster.h"
+#include "vmap/LoSPool.h"
+#include "Utilities/EventProcessor.h"
+#include "DelayExecutor.h"
+#include "LockedQueue.h"
+#include "MPSCQueue.h"
+
+// shared part of the bench commands: numeric arguments and timing of the measured variants
+class DebugBench
+{
+    public:
+        DebugBench(ChatHandler& handler, const char* args) : m_handler(handler), m_valid(true)
+        {
+            for (char* arg = strtok((char*)args, " "); arg; arg = strtok(NULL, " "))
+                m_args.push_back(atoi(arg));
+        }
+
+        // argument at index or def if not given, 0 or more than max makes the bench invalid
+        uint32 Arg(uint32 index, uint32 def, uint32 max)
+        {
+            uint32 value = index < m_args.size() ? uint32(m_args[index]) : def;
+            if (!value || value > max)
+                m_valid = false;
+
+            return value;
+        }
+
+        bool IsValid() const { return m_valid; }
+
+        // runs body once and reports ops done by it per second as "name: rate unit/s"
+        template<class Body>
+        void Run(char const* name, char const* unit, uint32 ops, Body body)
+        {
+            ACE_Time_Value start = ACE_OS::gettimeofday();
+            body();
+            ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+
+            uint64 usec = uint64(elapsed.sec()) * 1000000 + elapsed.usec();
+            m_handler.PSendSysMessage("%s: %u %s/s", name, usec ? uint32(uint64(ops) * 1000000 / usec) : 0, unit);
+        }
+
+    private:
+        ChatHandler& m_handler;
+        std::vector<int> m_args;
+        bool m_valid;
+};
+
+bool ChatHandler::HandleDebugLoSBenchCommand(const char* args)
+{
+    DebugBench bench(*this, args);
+    uint32 count = bench.Arg(0, 10000, 1000000);
+    if (!bench.IsValid())
+        return false;
+
+    Player* player = m_session->GetPlayer();
+    VMAP::IVMapManager* mgr = VMAP::VMapFactory::createOrGetVMapManager();
+
+    // random rays around player, same set for every backend
+    std::vector<VMAP::LoSRequest> requests(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        VMAP::LoSRequest& req = requests[i];
+        req.mapId = player->GetMapId();
+        req.x1 = player->GetPositionX();
+        req.y1 = player->GetPositionY();
+        req.z1 = player->GetPositionZ() + 2.0f;
+        req.x2 = req.x1 + frand(-40.0f, 40.0f);
+        req.y2 = req.y1 + frand(-40.0f, 40.0f);
+        req.z2 = req.z1 + frand(-10.0f, 10.0f);
+        req.alsom2 = false;
+        req.result = true;
+    }
+
+    uint32 blocked = 0;
+    bench.Run("LoS local", "rays", count, [&]()
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            VMAP::LoSRequest const& req = requests[i];
+            if (!mgr->isInLineOfSight2(req.mapId, req.x1, req.y1, req.z1, req.x2, req.y2, req.z2))
+                ++blocked;
+        }
+    });
+
+    if (sLoSPool.GetThreads())
+        bench.Run("LoS pool", "rays", count, [&]() { sLoSPool.Check(mgr, &requests[0], count); });
+
+    if (mgr->isClusterComputingEnabled())
+    {
+        bench.Run("LoS cluster", "rays", count, [&]()
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                VMAP::LoSRequest const& req = requests[i];
+                sLoSProxy.isInLineOfSight(req.mapId, req.x1, req.y1, req.z1, req.x2, req.y2, req.z2);
+            }
+        });
+    }
+
+    VMAP::LoSPoolStats stats = sLoSPool.GetStats();
+    PSendSysMessage("%u of %u rays blocked, %u pool threads", blocked, count, sLoSPool.GetThreads());
+    PSendSysMessage("LoS pool totals: " UI64FMTD " batches, " UI64FMTD " rays, " UI64FMTD " traced by helpers",
+        stats.batches, stats.rays, stats.helperRays);
+    return true;
+}
+
+bool ChatHandler::HandleDebugTerrainBenchCommand(const char* args)
+{
+    DebugBench bench(*this, args);
+    uint32 count = bench.Arg(0, 100000, 10000000);
+    if (!bench.IsValid())
+        return false;
+
+    Player* player = m_session->GetPlayer();
+    TerrainInfo const* terrain = player->GetTerrain();
+
+    // heights inside current grid, data of loaded grid only, no vmaps
+    float x = player->GetPositionX();
+    float y = player->GetPositionY();
+    float z = player->GetPositionZ();
+
+    float sum = 0.0f;
+    bench.Run("GetHeight", "calls", count, [&]()
+    {
+        for (uint32 i = 0; i < count; ++i)
+            sum += terrain->GetHeight(x + frand(-30.0f, 30.0f), y + frand(-30.0f, 30.0f), z, false);
+    });
+
+    // same query through the batch api, 16 points per call like a ground LoS check
+    bench.Run("GetHeights", "points", (count + 15) & ~15, [&]()
+    {
+        TerrainPoint points[16];
+        for (uint32 i = 0; i < count; i += 16)
+        {
+            for (uint32 j = 0; j < 16; ++j)
+            {
+                points[j].x = x + frand(-30.0f, 30.0f);
+                points[j].y = y + frand(-30.0f, 30.0f);
+                points[j].z = z;
+            }
+
+            terrain->GetHeights(points, 16, TERRAIN_QUERY_HEIGHT, false);
+            for (uint32 j = 0; j < 16; ++j)
+                sum += points[j].height;
+        }
+    });
+
+    // grid load latency, file stays in page cache after the first load so this is the warm cost
+    uint32 gx = uint32(32 - x / SIZE_OF_GRIDS);
+    uint32 gy = uint32(32 - y / SIZE_OF_GRIDS);
+    std::string path = sWorld.GetDataPath() + "maps/%03u%02u%02u.map";
+    char filename[512];
+    snprintf(filename, sizeof(filename), path.c_str(), player->GetMapId(), gx, gy);
+
+    GridMap probe;
+    if (!probe.loadFromFile(filename))
+    {
+        PSendSysMessage("Failed to load %s", filename);
+        return true;
+    }
+
+    const uint32 loads = 50;
+    for (uint32 mapped = 0; mapped < 2; ++mapped)
+    {
+        bench.Run(mapped ? "Grid load (mapped)" : "Grid load (read)", "loads", loads, [&]()
+        {
+            for (uint32 i = 0; i < loads; ++i)
+            {
+                GridMap grid;
+                if (mapped ? grid.loadFromMapping(filename) : grid.loadFromFile(filename))
+                    sum += grid.getHeight(x, y);            // touch one height so mapped load pays for its first page
+            }
+        });
+    }
+
+    PSendSysMessage("%s grids, checksum %.1f", sWorld.getConfig(CONFIG_GRIDMAP_MMAP) ? "mapped" : "read", sum);
+    return true;
+}
+
+bool ChatHandler::HandleDebugGuidBenchCommand(const char* args)
+{
+    DebugBench bench(*this, args);
+    uint32 rounds = bench.Arg(0, 100, 100000);
+    if (!bench.IsValid())
+        return false;
+
+    Player* player = m_session->GetPlayer();
+
+    // objects currently at client plus the same number of misses, in random order
+    std::vector<uint64> trace;
+    for (Player::ClientGUIDs::const_iterator itr = player->m_clientGUIDs.begin(); itr != player->m_clientGUIDs.end(); ++itr)
+    {
+        trace.push_back(*itr);
+        trace.push_back(*itr ^ UI64LIT(0x0000000000800000));
+    }
+
+    if (trace.empty())
+    {
+        PSendSysMessage("Nothing visible to build a trace from.");
+        return true;
+    }
+
+    std::random_shuffle(trace.begin(), trace.end());
+
+    // node based containers the flat ones replaced
+    std::set<uint64> treeSet(player->m_clientGUIDs.begin(), player->m_clientGUIDs.end());
+    std::unordered_map<uint64, Player*> nodeMap;
+    FlatConcurrentPtrMap<uint64, Player> flatMap;
+    for (Player::ClientGUIDs::const_iterator itr = player->m_clientGUIDs.begin(); itr != player->m_clientGUIDs.end(); ++itr)
+    {
+        nodeMap[*itr] = player;
+        flatMap.Insert(*itr, player);
+    }
+
+    uint32 lookups = rounds * trace.size();
+    uint32 found = 0;
+
+    bench.Run("std::set", "lookups", lookups, [&]()
+    {
+        for (uint32 r = 0; r < rounds; ++r)
+            for (std::vector<uint64>::const_iterator itr = trace.begin(); itr != trace.end(); ++itr)
+                found += treeSet.find(*itr) != treeSet.end();
+    });
+
+    bench.Run("FlatHashSet", "lookups", lookups, [&]()
+    {
+        for (uint32 r = 0; r < rounds; ++r)
+            for (std::vector<uint64>::const_iterator itr = trace.begin(); itr != trace.end(); ++itr)
+                found += player->m_clientGUIDs.find(*itr) != player->m_clientGUIDs.end();
+    });
+
+    bench.Run("std::unordered_map", "lookups", lookups, [&]()
+    {
+        for (uint32 r = 0; r < rounds; ++r)
+            for (std::vector<uint64>::const_iterator itr = trace.begin(); itr != trace.end(); ++itr)
+                found += nodeMap.find(*itr) != nodeMap.end();
+    });
+
+    bench.Run("FlatConcurrentPtrMap", "lookups", lookups, [&]()
+    {
+        for (uint32 r = 0; r < rounds; ++r)
+            for (std::vector<uint64>::const_iterator itr = trace.begin(); itr != trace.end(); ++itr)
+                found += flatMap.Find(*itr) != NULL;
+    });
+
+    PSendSysMessage("%u guids in trace, %u hits", uint32(trace.size()), found);
+    return true;
+}
+
+// timer like event (spell cast, aura tick, AI pulse), reschedules itself with next delay of the trace
+class EventBenchEvent : public BasicEvent
+{
+    public:
+        EventBenchEvent(EventProcessor& events, std::vector<uint32> const& delays, uint32& next)
+            : m_events(events), m_delays(delays), m_next(next) {}
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
+        {
+            m_events.AddEvent(this, m_delays[m_next++ % m_delays.size()]);
+            return false;
+        }
+
+    private:
+        EventProcessor& m_events;
+        std::vector<uint32> const& m_delays;
+        uint32& m_next;
+};
+
+bool ChatHandler::HandleDebugEventBenchCommand(const char* args)
+{
+    DebugBench bench(*this, args);
+    uint32 events = bench.Arg(0, 2000, 1000000);
+    uint32 seconds = bench.Arg(1, 600, 86400);
+    if (!bench.IsValid())
+        return false;
+
+    // half short timers, half long ones, replayed by 50 ms updates
+    const uint32 diff = 50;
+    std::vector<uint32> delays(65536);
+    for (uint32 i = 0; i < delays.size(); ++i)
+        delays[i] = (i & 1) ? urand(1, 2000) : urand(2000, 60000);
+
+    uint32 updates = seconds * 1000 / diff;
+    uint32 next = 0;
+    uint32 executed = 0;
+
+    EventProcessor processor;
+    for (uint32 i = 0; i < events; ++i)
+        processor.AddEvent(new EventBenchEvent(processor, delays, next), delays[next++ % delays.size()]);
+
+    bench.Run("EventProcessor", "updates", updates, [&]()
+    {
+        for (uint32 u = 0; u < updates; ++u)
+            executed += processor.Update(diff);
+    });
+
+    PSendSysMessage("%u events, %u s of %u ms updates, %u events executed", events, seconds, diff, executed);
+    return true;
+}
+
+typedef ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> RecvLockedQueue;
+typedef ACE_Based::MPSCQueue<WorldPacket*> RecvRingQueue;
+
+static bool RecvQueueBenchAdd(RecvLockedQueue& queue, WorldPacket* packet)
+{
+    queue.add(packet);
+    return true;
+}
+
+static bool RecvQueueBenchAdd(RecvRingQueue& queue, WorldPacket* packet)
+{
+    return queue.add(packet);
+}
+
+// socket thread stand in, packets are fake pointers and never dereferenced
+template<class Queue>
+class RecvQueueBenchProducer : public ACE_Method_Request
+{
+    public:
+        RecvQueueBenchProducer(Queue& queue, uint32 packets) : m_queue(queue), m_packets(packets) {}
+
+        virtual int call(void)
+        {
+            for (uint32 i = 1; i <= m_packets; ++i)
+                while (!RecvQueueBenchAdd(m_queue, reinterpret_cast<WorldPacket*>(size_t(i))))
+                    ACE_Thread::yield();
+            return 0;
+        }
+
+    private:
+        Queue& m_queue;
+        uint32 m_packets;
+};
+
+// producers add packets while calling thread drains them like a session update
+template<class Queue>
+static void RunRecvQueueBench(Queue& queue, uint32 producers, uint32 packets)
+{
+    DelayExecutor executor;
+    executor.activate(producers);
+
+    for (uint32 i = 0; i < producers; ++i)
+        executor.execute(new RecvQueueBenchProducer<Queue>(queue, packets));
+
+    uint32 total = producers * packets;
+    uint32 received = 0;
+    WorldPacket* packet;
+    while (received < total)
+    {
+        if (queue.next(packet))
+            ++received;
+        else
+            ACE_Thread::yield();
+    }
+
+    executor.deactivate();
+}
+
+bool ChatHandler::HandleDebugRecvQueueBenchCommand(const char* args)
+{
+    DebugBench bench(*this, args);
+    uint32 producers = bench.Arg(0, 4, 64);
+    uint32 packets = bench.Arg(1, 100000, 1000000);
+    if (!bench.IsValid())
+        return false;
+
+    RecvLockedQueue lockedQueue;
+    bench.Run("LockedQueue", "packets", producers * packets, [&]() { RunRecvQueueBench(lockedQueue, producers, packets); });
+
+    RecvRingQueue ringQueue(SESSION_RECV_RING_SIZE, sWorld.getConfig(CONFIG_SESSION_RECV_QUEUE_SIZE));
+    bench.Run("MPSCQueue", "packets", producers * packets, [&]() { RunRecvQueueBench(ringQueue, producers, packets); });
+
+    PSendSysMessage("%u producers, %u packets each, %u ring slots, %u packets max", producers, packets, uint32(ringQueue.capacity()), uint32(ringQueue.limit()));
+    return true;
+}
+
+struct AuctionBenchQuery
+{
+    uint32 itemClass;                                       // 0xffffffff - any
+    uint32 itemSubClass;                                    // 0xffffffff - any
+    std::wstring name;                                      // lower case, empty - any
+    uint32 listfrom;
+};
+
+static bool AuctionBenchMatches(AuctionEntry const* auction, AuctionBenchQuery const& query)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (query.itemClass != 0xffffffff && proto->Class != query.itemClass)
+        return false;
+
+    if (query.itemSubClass != 0xffffffff && proto->SubClass != query.itemSubClass)
+        return false;
+
+    return query.name.empty() || auction->itemName.find(query.name) != std::wstring::npos;
+}
+
+// old search: whole house sorted, then scanned for matches, returns their count
+static uint32 AuctionBenchFullScan(AuctionHouseObject const& house, AuctionSorter const& sorter, AuctionBenchQuery const& query)
+{
+    std::vector<AuctionEntry*> auctions;
+    auctions.reserve(house.GetAuctions().size());
+    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = house.GetAuctions().begin(); itr != house.GetAuctions().end(); ++itr)
+        auctions.push_back(itr->second);
+
+    std::sort(auctions.begin(), auctions.end(), sorter);
+
+    uint32 matched = 0;
+    for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
+        matched += AuctionBenchMatches(*itr, query);
+
+    return matched;
+}
+
+// as HandleAuctionListItems: candidates from name or class index, sorted only up to requested page
+static uint32 AuctionBenchIndexed(AuctionHouseObject const& house, AuctionSorter const& sorter, AuctionBenchQuery const& query)
+{
+    std::vector<AuctionEntry*> auctions;
+    if (!house.GetAuctionsByName(query.name, auctions))
+        house.GetAuctionsByClass(query.itemClass, query.itemSubClass, auctions);
+
+    std::vector<AuctionEntry*>::iterator last = auctions.begin();
+    for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
+        if (AuctionBenchMatches(*itr, query))
+            *last++ = *itr;
+
+    auctions.erase(last, auctions.end());
+
+    uint32 listEnd = std::min<uint32>(query.listfrom + 50, auctions.size());
+    if (query.listfrom < listEnd)
+        std::partial_sort(auctions.begin(), auctions.begin() + listEnd, auctions.end(), sorter);
+
+    return auctions.size();
+}
+
+bool ChatHandler::HandleDebugAuctionBenchCommand(const char* args)
+{
+    DebugBench bench(*this, args);
+    uint32 count = bench.Arg(0, 50000, 1000000);
+    uint32 queries = bench.Arg(1, 100, 100000);
+    if (!bench.IsValid())
+        return false;
+
+    std::vector<uint32> templates;
+    for (uint32 id = 0; id < sItemStorage.MaxEntry; ++id)
+        if (sItemStorage.LookupEntry<ItemPrototype>(id))
+            templates.push_back(id);
+
+    if (templates.empty())
+    {
+        PSendSysMessage("No item templates loaded.");
+        return true;
+    }
+
+    // synthetic house of random item templates, auctions have no items and never reach the database
+    std::vector<AuctionEntry*> entries(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        AuctionEntry* auction = new AuctionEntry;
+        auction->Id = i + 1;
+        auction->itemGuidLow = 0;
+        auction->itemTemplate = templates[urand(0, templates.size() - 1)];
+        auction->itemCount = 1;
+        auction->itemRandomPropertyId = 0;
+        auction->owner = 0;
+        auction->startbid = urand(1, 100000);
+        auction->bid = 0;
+        auction->buyout = auction->startbid * 2;
+        auction->expireTime = time(NULL) + urand(HOUR, 2 * DAY);
+        auction->bidder = 0;
+        auction->deposit = 0;
+        auction->auctionHouseEntry = NULL;
+        entries[i] = auction;
+    }
+
+    AuctionHouseObject house;
+    bench.Run("AddAuction", "auctions", count, [&]()
+    {
+        for (uint32 i = 0; i < count; ++i)
+            house.AddAuction(entries[i]);
+    });
+
+    // class browse, name search (3 to 8 chars of a listed name) and browse of a random page
+    std::vector<AuctionBenchQuery> classQueries(queries), nameQueries(queries), pageQueries(queries);
+    for (uint32 i = 0; i < queries; ++i)
+    {
+        AuctionEntry const* auction = entries[urand(0, count - 1)];
+        ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+
+        classQueries[i].itemClass = proto->Class;
+        classQueries[i].itemSubClass = proto->SubClass;
+        classQueries[i].listfrom = 0;
+
+        nameQueries[i].itemClass = 0xffffffff;
+        nameQueries[i].itemSubClass = 0xffffffff;
+        nameQueries[i].listfrom = 0;
+        if (auction->itemName.size() >= 3)
+        {
+            size_t length = urand(3, std::min<size_t>(8, auction->itemName.size()));
+            nameQueries[i].name = auction->itemName.substr(urand(0, auction->itemName.size() - length), length);
+        }
+
+        pageQueries[i].itemClass = 0xffffffff;
+        pageQueries[i].itemSubClass = 0xffffffff;
+        pageQueries[i].listfrom = urand(0, count / 50) * 50;
+    }
+
+    uint8 sort[MAX_AUCTION_SORT];
+    memset(sort, MAX_AUCTION_SORT, MAX_AUCTION_SORT);
+    sort[0] = 1 | AUCTION_SORT_REVERSED;                    // quality, best first
+    sort[1] = 0;                                            // level
+    sort[2] = 2;                                            // buyout
+    AuctionSorter sorter(sort, m_session->GetPlayer());
+
+    char const* names[3] = { "class", "name", "page" };
+    std::vector<AuctionBenchQuery> const* sets[3] = { &classQueries, &nameQueries, &pageQueries };
+    bool same = true;
+    for (uint32 s = 0; s < 3; ++s)
+    {
+        std::vector<AuctionBenchQuery> const& set = *sets[s];
+        std::vector<uint32> indexed(queries), scanned(queries);
+
+        std::string name = std::string("Indexed ") + names[s];
+        bench.Run(name.c_str(), "queries", queries, [&]()
+        {
+            for (uint32 i = 0; i < queries; ++i)
+                indexed[i] = AuctionBenchIndexed(house, sorter, set[i]);
+        });
+
+        name = std::string("Full scan ") + names[s];
+        bench.Run(name.c_str(), "queries", queries, [&]()
+        {
+            for (uint32 i = 0; i < queries; ++i)
+                scanned[i] = AuctionBenchFullScan(house, sorter, set[i]);
+        });
+
+        same = same && indexed == scanned;
+    }
+
+    bench.Run("RemoveAuction", "auctions", count, [&]()
+    {
+        for (uint32 i = 0; i < count; ++i)
+            house.RemoveAuction(entries[i]->Id);
+    });
+
+    for (uint32 i = 0; i < count; ++i)
+        delete entries[i];
+
+    PSendSysMessage("%u auctions of %u templates, %u queries of each kind, results %s", count, uint32(templates.size()), queries, same ? "match" : "differ");
+    return true;
+}
+
+bool ChatHandler::HandleDebugUpdateBenchCommand(const char* args)
+{
+    DebugBench bench(*this, args);
+    uint32 viewers = bench.Arg(0, 40, 10000);
+    uint32 blocks = bench.Arg(1, 50, 10000);
+    uint32 rounds = bench.Arg(2, 100, 100000);
+    if (!bench.IsValid())
+        return false;
+
+    Player* player = m_session->GetPlayer();
+
+    // every viewer gets create blocks of random units player sees, like players entering a crowded area
+    std::vector<Unit*> units(1, player);
+    for (Player::ClientGUIDs::const_iterator itr = player->m_clientGUIDs.begin(); itr != player->m_clientGUIDs.end(); ++itr)
+    {
+        if (Unit* unit = player->GetMap()->GetUnit(*itr))
+            units.push_back(unit);
+    }
+
+    std::vector<UpdateData> updates(viewers);
+    std::vector<UpdateData*> updatePtrs(viewers);
+    for (uint32 i = 0; i < viewers; ++i)
+    {
+        for (uint32 j = 0; j < blocks; ++j)
+            units[urand(0, units.size() - 1)]->BuildCreateUpdateBlockForPlayer(&updates[i], player);
+
+        updatePtrs[i] = &updates[i];
+    }
+
+    // time spent by map thread in SendObjectUpdates before sending
+    std::vector<WorldPacket> packets;
+    bench.Run("Map thread only", "packets", viewers * rounds, [&]()
+    {
+        for (uint32 r = 0; r < rounds; ++r)
+            Map::BuildUpdatePackets(updatePtrs, packets, 0);
+    });
+
+    uint32 bytes = 0;
+    for (std::vector<WorldPacket>::const_iterator itr = packets.begin(); itr != packets.end(); ++itr)
+        bytes += itr->size();
+
+    if (sMapMgr.GetMapUpdater()->packet_activated())
+    {
+        uint32 helpers = 0;
+        bench.Run("With packet threads", "packets", viewers * rounds, [&]()
+        {
+            for (uint32 r = 0; r < rounds; ++r)
+                helpers = Map::BuildUpdatePackets(updatePtrs, packets, sWorld.getConfig(CONFIG_MAPUPDATE_PACKET_THREADS));
+        });
+
+        PSendSysMessage("%u packet threads helped", helpers);
+    }
+    else
+        SendSysMessage("MapUpdate.PacketThreads is 0, only map thread is measured");
+
+    PSendSysMessage("%u viewers with %u create blocks of %u units, %u compressed bytes per round", viewers, blocks, uint32(units.size()), bytes);
+    return true;
+}
@@ -128,4 +128,23 @@ struct Cell
         void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map &, const CellPair& , const CellPair&) const;
 };
 
+#define AREA_BATCH_SIZE 16
+
+// 2d positions of a run of objects from one grid list, area searches
+// test the whole run against the search circle before any per object check
+struct AreaBatch
+{
+    float x[AREA_BATCH_SIZE];
+    float y[AREA_BATCH_SIZE];
+    float reach[AREA_BATCH_SIZE];                           // added to radius for this object
+    uint32 count;
+
+    // bit i is set when object i lies within radius + reach[i] of cx, cy
+    uint32 SelectInRadius(float cx, float cy, float radius) const;
+
+    // calls visitor.VisitObject only for objects inside the circle, with object size added to radius if sizeAware
+    template<class T, class VISITOR>
+    static void Visit(GridRefManager<T> &m, float cx, float cy, float radius, bool sizeAware, VISITOR &visitor);
+};
+
 #endif
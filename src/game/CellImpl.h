@@ -26,6 +26,11 @@
 #include <cmath>
 #include "Object.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CELL_SSE2
+#endif
+
 inline Cell::Cell(CellPair const& p)
 {
     data.Part.grid_x = p.x_coord / MAX_NUMBER_OF_CELLS;
@@ -252,4 +257,65 @@ inline void Cell::VisitAllObjects(float x, float y, Map *map, T &visitor, float
     cell.Visit(p, wnotifier, *map, x, y, radius);
 }
 
+inline uint32 AreaBatch::SelectInRadius(float cx, float cy, float radius) const
+{
+    uint32 mask = 0;
+    uint32 i = 0;
+
+#ifdef CELL_SSE2
+    __m128 centerX = _mm_set1_ps(cx);
+    __m128 centerY = _mm_set1_ps(cy);
+    __m128 dist = _mm_set1_ps(radius);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), centerY);
+        __m128 maxDist = _mm_add_ps(_mm_loadu_ps(reach + i), dist);
+        __m128 inside = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(maxDist, maxDist));
+        mask |= uint32(_mm_movemask_ps(inside)) << i;
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float dx = x[i] - cx;
+        float dy = y[i] - cy;
+        float maxDist = radius + reach[i];
+        if (dx*dx + dy*dy <= maxDist*maxDist)
+            mask |= 1 << i;
+    }
+
+    return mask;
+}
+
+template<class T, class VISITOR>
+inline void AreaBatch::Visit(GridRefManager<T> &m, float cx, float cy, float radius, bool sizeAware, VISITOR &visitor)
+{
+    AreaBatch batch;
+    T* objects[AREA_BATCH_SIZE];
+    batch.count = 0;
+
+    for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end();)
+    {
+        T* obj = itr->getSource();
+        ++itr;
+
+        batch.x[batch.count] = obj->GetPositionX();
+        batch.y[batch.count] = obj->GetPositionY();
+        batch.reach[batch.count] = sizeAware ? obj->GetObjectSize() : 0.0f;
+        objects[batch.count] = obj;
+
+        if (++batch.count < AREA_BATCH_SIZE && itr != m.end())
+            continue;
+
+        for (uint32 inside = batch.SelectInRadius(cx, cy, radius), i = 0; inside; inside >>= 1, ++i)
+        {
+            if (inside & 1)
+                visitor.VisitObject(objects[i]);
+        }
+
+        batch.count = 0;
+    }
+}
+
 #endif
@@ -97,6 +97,7 @@ ChatCommand * ChatHandler::getCommandTable()
 
     static ChatCommand serverSetCommandTable[] =
     {
+        { "compression",    PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerSetCompressionCommand, "", NULL },
         { "difftime",       PERM_CONSOLE,   PERM_CONSOLE, true,   &ChatHandler::HandleServerSetDiffTimeCommand,   "", NULL },
         { "motd",           PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerSetMotdCommand,       "", NULL },
         { NULL,             0,              0,            false,  NULL,                                           "", NULL }
@@ -141,20 +142,26 @@ ChatCommand * ChatHandler::getCommandTable()
 
     static ChatCommand serverCommandTable[] =
     {
+        { "compression",    PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerCompressionCommand,   "", NULL },
         { "corpses",        PERM_HIGH_GMT,  PERM_CONSOLE, true,   &ChatHandler::HandleServerCorpsesCommand,       "", NULL },
+        { "dbqueue",        PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerDBQueueCommand,       "", NULL },
         { "events",         PERM_PLAYER,    PERM_CONSOLE, true,   &ChatHandler::HandleServerEventsCommand,        "", NULL },
         { "exit",           PERM_CONSOLE,   PERM_CONSOLE, true,   &ChatHandler::HandleServerExitCommand,          "", NULL },
         { "idlerestart",    PERM_ADM,       PERM_CONSOLE, true,   NULL,                                           "", serverIdleRestartCommandTable },
         { "idleshutdown",   PERM_ADM,       PERM_CONSOLE, true,   NULL,                                           "", serverShutdownCommandTable },
         { "info",           PERM_PLAYER,    PERM_CONSOLE, true,   &ChatHandler::HandleServerInfoCommand,          "", NULL },
         { "kickall",        PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerKickallCommand,       "", NULL },
+        { "mapcosts",       PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerMapCostsCommand,      "", NULL },
         { "motd",           PERM_PLAYER,    PERM_CONSOLE, true,   &ChatHandler::HandleServerMotdCommand,          "", NULL },
         { "mute",           PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerMuteCommand,          "", NULL },
+        { "netstats",       PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerNetStatsCommand,      "", NULL },
         { "pvp",            PERM_PLAYER,    PERM_CONSOLE, false,  &ChatHandler::HandleServerPVPCommand,           "", NULL },
         { "restart",        PERM_ADM,       PERM_CONSOLE, true,   NULL,                                           "", serverRestartCommandTable },
         { "rollshutdown",   PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerRollShutDownCommand,  "", NULL},
+        { "savestats",      PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerSaveStatsCommand,     "", NULL },
         { "set",            PERM_ADM,       PERM_CONSOLE, true,   NULL,                                           "", serverSetCommandTable },
         { "shutdown",       PERM_ADM,       PERM_CONSOLE, true,   NULL,                                           "", serverShutdownCommandTable },
+        { "visstats",       PERM_ADM,       PERM_CONSOLE, true,   &ChatHandler::HandleServerVisStatsCommand,      "", NULL },
         { NULL,             0,              0,            false,  NULL,                                           "", NULL }
     };
 
@@ -344,22 +351,27 @@ ChatCommand * ChatHandler::getCommandTable()
         { "addformation",   PERM_DEVELOPER, PERM_CONSOLE, false,  &ChatHandler::HandleDebugAddFormationToFileCommand, "", NULL },
         { "anim",           PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugAnimCommand,               "", NULL },
         { "arena",          PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugArenaCommand,              "", NULL },
+        { "auctionbench",   PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugAuctionBenchCommand,       "", NULL },
         { "bg",             PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugBattleGroundCommand,       "", NULL },
         { "bossemote",      PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugBossEmoteCommand,          "", NULL },
         { "cell",           PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugCellCommand,               "", NULL },
         { "cooldowns",      PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugCooldownsCommand,          "", NULL },
+        { "eventbench",     PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugEventBenchCommand,         "", NULL },
         { "getitemstate",   PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugGetItemState,              "", NULL },
         { "getinstdata",    PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugGetInstanceDataCommand,    "", NULL },
         { "getinstdata64",  PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugGetInstanceData64Command,  "", NULL },
         { "getvalue",       PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugGetValue,                  "", NULL },
+        { "guidbench",      PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugGuidBenchCommand,          "", NULL },
         { "guildkill",      PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugGuildKill,                 "", NULL },
         { "hostilelist",    PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugHostileRefList,            "", NULL },
         { "lootrecipient",  PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugGetLootRecipient,          "", NULL },
+        { "losbench",       PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugLoSBenchCommand,           "", NULL },
         { "joinbg",         PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugJoinBG,                    "", NULL },
         { "map",            PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugMapCommand,                "", NULL },
         { "Mod32Value",     PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugMod32Value,                "", NULL },
         { "play",           PERM_DEVELOPER, PERM_CONSOLE, false,  NULL,                                               "", debugPlayCommandTable },
         { "poolstats",      PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleGetPoolObjectStatsCommand,      "", NULL },
+        { "recvqueuebench", PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugRecvQueueBenchCommand,     "", NULL },
         { "rel",            PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleRelocateCreatureCommand,        "", NULL },
         { "send",           PERM_ADM,       PERM_CONSOLE, false,  NULL,                                               "", debugSendCommandTable },
         { "setinstdata",    PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugSetInstanceDataCommand,    "", NULL },
@@ -367,9 +379,11 @@ ChatCommand * ChatHandler::getCommandTable()
         { "setitemflag",    PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugSetItemFlagCommand,        "", NULL },
         { "setvalue",       PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugSetValue,                  "", NULL },
         { "showcombatstats",PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugShowCombatStats,           "", NULL },
+        { "terrainbench",   PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugTerrainBenchCommand,       "", NULL },
         { "threatlist",     PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugThreatList,                "", NULL },
         { "printstate",     PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugUnitState,                 "", NULL },
         { "update",         PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugUpdate,                    "", NULL },
+        { "updatebench",    PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugUpdateBenchCommand,        "", NULL },
         { "uws",            PERM_ADM,       PERM_CONSOLE, false,  &ChatHandler::HandleDebugUpdateWorldStateCommand,   "", NULL },
         { "vmap",           PERM_GMT_DEV,   PERM_CONSOLE, false,  &ChatHandler::HandleDebugVmapsCommand,              "", NULL },
         { NULL,             0,              0,            false,  NULL,                                               "", NULL }
@@ -205,6 +205,13 @@ class ChatHandler
         bool HandleDebugUpdate(const char* args);
         bool HandleDebugUpdateWorldStateCommand(const char* args);
         bool HandleDebugVmapsCommand(const char* args);
+        bool HandleDebugLoSBenchCommand(const char* args);
+        bool HandleDebugTerrainBenchCommand(const char* args);
+        bool HandleDebugGuidBenchCommand(const char* args);
+        bool HandleDebugRecvQueueBenchCommand(const char* args);
+        bool HandleDebugEventBenchCommand(const char* args);
+        bool HandleDebugAuctionBenchCommand(const char* args);
+        bool HandleDebugUpdateBenchCommand(const char* args);
         bool HandleDebugWPCommand(const char* args);
 
         bool HandleDebugSendBattlegroundOpcodes(const char* args);
@@ -488,20 +495,27 @@ class ChatHandler
         bool HandleSendMessageCommand(const char * args);
         bool HandleSendMoneyCommand(const char* args);
 
+        bool HandleServerCompressionCommand(const char* args);
         bool HandleServerCorpsesCommand(const char* args);
+        bool HandleServerDBQueueCommand(const char* args);
         bool HandleServerEventsCommand(const char* args);
         bool HandleServerExitCommand(const char* args);
         bool HandleServerIdleRestartCommand(const char* args);
         bool HandleServerIdleShutDownCommand(const char* args);
         bool HandleServerInfoCommand(const char* args);
         bool HandleServerKickallCommand(const char* args);
+        bool HandleServerMapCostsCommand(const char* args);
         bool HandleServerMotdCommand(const char* args);
         bool HandleServerMuteCommand(const char* args);
         bool HandleServerRestartCommand(const char* args);
         bool HandleServerSetMotdCommand(const char* args);
+        bool HandleServerSetCompressionCommand(const char* args);
         bool HandleServerSetDiffTimeCommand(const char* args);
         bool HandleServerShutDownCommand(const char* args);
         bool HandleServerRollShutDownCommand(const char* args);
+        bool HandleServerSaveStatsCommand(const char* args);
+        bool HandleServerNetStatsCommand(const char* args);
+        bool HandleServerVisStatsCommand(const char* args);
         bool HandleServerShutDownCancelCommand(const char* args);
         bool HandleServerPVPCommand(const char* args);
 
@@ -249,12 +249,13 @@ void CooldownMgr::LoadFromDB(QueryResultAutoPtr result)
 
 void CooldownMgr::SaveToDB(uint32 playerguid)
 {
-    RealmDataDatabase.PExecute("DELETE FROM character_spell_cooldown WHERE guid = '%u'", playerguid);
-
     uint32 now = WorldTimer::getMSTime();
     time_t curTime = time(NULL);
 
-    // remove outdated and save active
+    CooldownList spells;
+    CooldownList items;
+
+    // remove outdated and collect active
     for (CooldownList::iterator itr = m_SpellCooldowns.begin(); itr != m_SpellCooldowns.end();)
     {
         uint32 diff = WorldTimer::getMSTimeDiff(now, itr->second.start);
@@ -262,8 +263,7 @@ void CooldownMgr::SaveToDB(uint32 playerguid)
             m_SpellCooldowns.erase(itr++);
         else if ((itr->second.duration - diff) > 7 * IN_MILISECONDS) // skip shorter than 7sec
         {
-            RealmDataDatabase.PExecute("INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES ('%u', '%u', '%u', '" UI64FMTD "')",
-                playerguid, itr->first, 0, curTime + uint64((itr->second.duration - diff)/1000)); // store just seconds
+            spells.insert(*itr);
             ++itr;
         }
         else 
@@ -276,11 +276,39 @@ void CooldownMgr::SaveToDB(uint32 playerguid)
             m_ItemCooldowns.erase(itr++);
         else if ((itr->second.duration - diff) > 7 * IN_MILISECONDS) // skip shorter than 7sec
         {
-            RealmDataDatabase.PExecute("INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES ('%u', '%u', '%u', '" UI64FMTD "')",
-                playerguid, 0, itr->first, curTime + uint64((itr->second.duration - diff) / 1000)); // store just seconds
+            items.insert(*itr);
             ++itr;
         }
         else
             itr++;
     }
+
+    // same cooldowns mean same expire times in db, nothing to rewrite
+    if (m_savedValid && spells == m_SavedSpellCooldowns && items == m_SavedItemCooldowns)
+        return;
+
+    static SqlStatementID deleteCooldowns;
+    static SqlStatementID insertCooldown;
+
+    SqlStatement stmt = RealmDataDatabase.CreateStatement(deleteCooldowns, "DELETE FROM character_spell_cooldown WHERE guid = ?");
+    if (!m_savedValid || !m_SavedSpellCooldowns.empty() || !m_SavedItemCooldowns.empty())
+        stmt.PExecute(playerguid);
+
+    for (CooldownList::const_iterator itr = spells.begin(); itr != spells.end(); ++itr)
+    {
+        uint32 diff = WorldTimer::getMSTimeDiff(now, itr->second.start);
+        stmt = RealmDataDatabase.CreateStatement(insertCooldown, "INSERT INTO character_spell_cooldown (guid, spell, item, time) VALUES (?, ?, ?, ?)");
+        stmt.PExecute(playerguid, itr->first, uint32(0), uint64(curTime + uint64((itr->second.duration - diff) / 1000))); // store just seconds
+    }
+
+    for (CooldownList::const_iterator itr = items.begin(); itr != items.end(); ++itr)
+    {
+        uint32 diff = WorldTimer::getMSTimeDiff(now, itr->second.start);
+        stmt = RealmDataDatabase.CreateStatement(insertCooldown, "INSERT INTO character_spell_cooldown (guid, spell, item, time) VALUES (?, ?, ?, ?)");
+        stmt.PExecute(playerguid, uint32(0), itr->first, uint64(curTime + uint64((itr->second.duration - diff) / 1000)));
+    }
+
+    m_SavedSpellCooldowns.swap(spells);
+    m_SavedItemCooldowns.swap(items);
+    m_savedValid = true;
 }
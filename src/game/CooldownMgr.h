@@ -33,10 +33,11 @@ class HELLGROUND_IMPORT_EXPORT CooldownMgr
 {
     friend class Player; // for RemoveAllSpellCooldowns, RemoveArenaSpellCooldowns
 public:
-    CooldownMgr() {}
+    CooldownMgr() : m_savedValid(false) {}
     struct Cooldown
     {
         Cooldown(uint32 s = 0, uint32 d = 0) : start(s), duration(d) {};
+        bool operator==(const Cooldown& c) const { return start == c.start && duration == c.duration; }
         uint32 start;
         uint32 duration;
     };
@@ -58,10 +59,17 @@ public:
     void WriteCooldowns(ByteBuffer& bb);
     void LoadFromDB(QueryResultAutoPtr result);
     void SaveToDB(uint32 playerguid);
+    // last saved rows are unknown, next SaveToDB rewrites all of them
+    void InvalidateSaved() { m_savedValid = false; }
 private:
     CooldownList m_SpellCooldowns;
     CooldownList m_ItemCooldowns;
     CooldownList m_GlobalCooldowns;
+
+    // rows written by last SaveToDB
+    CooldownList m_SavedSpellCooldowns;
+    CooldownList m_SavedItemCooldowns;
+    bool m_savedValid;
 };
 
 #endif
\ No newline at end of file
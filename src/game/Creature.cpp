@@ -1773,15 +1773,15 @@ float Creature::GetAttackDistance(Unit const* pl) const
     int32 CreatureMod = 0;
     int32 PlayerMod = 0;
     //get detect range aura modifiers on creatures
-    AuraList const& mTotalAuraList = GetAurasByType(SPELL_AURA_MOD_DETECT_RANGE);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(SPELL_AURA_MOD_DETECT_RANGE);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         if(creaturelevel <= (*i)->GetSpellProto()->MaxTargetLevel)
             CreatureMod += (*i)->GetModifierValue();
     }
     //get detect range aura modifiers on players
-    AuraList const& mTotalPlayerAuraList = pl->GetAurasByType(SPELL_AURA_MOD_DETECT_RANGE);
-    for (AuraList::const_iterator i = mTotalPlayerAuraList.begin();i != mTotalPlayerAuraList.end(); ++i)
+    AuraTypeList const& mTotalPlayerAuraList = pl->GetAurasByType(SPELL_AURA_MOD_DETECT_RANGE);
+    for (AuraTypeList::const_iterator i = mTotalPlayerAuraList.begin();i != mTotalPlayerAuraList.end(); ++i)
     {
         if(playerlevel <= (*i)->GetSpellProto()->MaxTargetLevel)
             PlayerMod += (*i)->GetModifierValue();
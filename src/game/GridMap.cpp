@@ -27,12 +27,20 @@
 #include "DBCStores.h"
 #include "GridMap.h"
 #include "VMapFactory.h"
+#include "vmap/MapTree.h"
 #include "movemap/MoveMap.h"
 #include "World.h"
 #include "Database/DatabaseEnv.h"
 
 #include "Util.h"
 
+#include <ace/OS_NS_unistd.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GRIDMAP_SSE2
+#endif
+
 char const* MAP_MAGIC         = "MAPS";
 char const* MAP_VERSION_MAGIC = "v1.2";
 char const* MAP_AREA_MAGIC    = "AREA";
@@ -63,6 +71,8 @@ GridMap::GridMap()
     m_liquid_type = NULL;
     m_liquid_map  = NULL;
 
+    m_mapping = NULL;
+
     lastTimeUsed = 0;
 }
 
@@ -72,6 +82,14 @@ GridMap::~GridMap()
 }
 
 bool GridMap::loadData(char *filename)
+{
+    if (sWorld.getConfig(CONFIG_GRIDMAP_MMAP))
+        return loadFromMapping(filename);
+
+    return loadFromFile(filename);
+}
+
+bool GridMap::loadFromFile(char *filename)
 {
     // Unload old data if exist
     unloadData();
@@ -120,8 +138,204 @@ bool GridMap::loadData(char *filename)
     return false;
 }
 
+bool GridMap::loadFromMapping(char *filename)
+{
+    // Unload old data if exist
+    unloadData();
+
+    // pages are read on first access and shared through page cache
+    ACE_Mem_Map *mapping = new ACE_Mem_Map();
+    if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1)
+    {
+        // missing file is not an error, anything else gets the regular loader
+        delete mapping;
+        return loadFromFile(filename);
+    }
+
+    // mapping stays valid without the file, do not keep one descriptor per loaded grid
+    mapping->close_handle();
+    m_mapping = mapping;
+
+    GridMapFileHeader header;
+    if (mapHeader(0, header) &&
+        header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+        header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)) &&
+        IsAcceptableClientBuild(header.buildMagic))
+    {
+        if (header.areaMapOffset && !mapAreaData(header.areaMapOffset))
+        {
+            sLog.outLog(LOG_DEFAULT, "ERROR: Error mapping map area data\n");
+            unloadData();
+            return false;
+        }
+
+        if (header.heightMapOffset && !mapHeightData(header.heightMapOffset))
+        {
+            sLog.outLog(LOG_DEFAULT, "ERROR: Error mapping map height data\n");
+            unloadData();
+            return false;
+        }
+
+        if (header.liquidMapOffset && !mapLiquidData(header.liquidMapOffset))
+        {
+            sLog.outLog(LOG_DEFAULT, "ERROR: Error mapping map liquids data\n");
+            unloadData();
+            return false;
+        }
+
+        return true;
+    }
+
+    sLog.outLog(LOG_DEFAULT, "ERROR: Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
+    unloadData();
+    return false;
+}
+
+template<class T>
+bool GridMap::mapHeader(uint32 offset, T &header)
+{
+    if (size_t(offset) + sizeof(T) > m_mapping->size())
+        return false;
+
+    memcpy(&header, (char const*)m_mapping->addr() + offset, sizeof(T));
+    return true;
+}
+
+template<class T>
+T* GridMap::mapArray(uint32 &offset, uint32 count)
+{
+    size_t bytes = size_t(count) * sizeof(T);
+    if (size_t(offset) + bytes > m_mapping->size())
+        return NULL;
+
+    char *data = (char*)m_mapping->addr() + offset;
+    offset += bytes;
+
+    // sections following uint8 arrays may break float alignment
+    if (size_t(data) % sizeof(T))
+    {
+        char *copy = new char[bytes];
+        memcpy(copy, data, bytes);
+        m_mappingCopies.push_back(copy);
+        return (T*)copy;
+    }
+
+    return (T*)data;
+}
+
+bool GridMap::mapAreaData(uint32 offset)
+{
+    GridMapAreaHeader header;
+    if (!mapHeader(offset, header) || header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+        return false;
+
+    offset += sizeof(header);
+
+    m_gridArea = header.gridArea;
+    if (!(header.flags & MAP_AREA_NO_AREA))
+    {
+        m_area_map = mapArray<uint16>(offset, 16*16);
+        if (!m_area_map)
+            return false;
+    }
+
+    return true;
+}
+
+bool GridMap::mapHeightData(uint32 offset)
+{
+    GridMapHeightHeader header;
+    if (!mapHeader(offset, header) || header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+        return false;
+
+    offset += sizeof(header);
+
+    m_gridHeight = header.gridHeight;
+    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    {
+        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        {
+            m_uint16_V9 = mapArray<uint16>(offset, 129*129);
+            m_uint16_V8 = mapArray<uint16>(offset, 128*128);
+            m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            m_gridGetHeight = &GridMap::getHeightFromUint16;
+        }
+        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        {
+            m_uint8_V9 = mapArray<uint8>(offset, 129*129);
+            m_uint8_V8 = mapArray<uint8>(offset, 128*128);
+            m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            m_gridGetHeight = &GridMap::getHeightFromUint8;
+        }
+        else
+        {
+            m_V9 = mapArray<float>(offset, 129*129);
+            m_V8 = mapArray<float>(offset, 128*128);
+            m_gridGetHeight = &GridMap::getHeightFromFloat;
+        }
+
+        if (!m_V9 || !m_V8)
+            return false;
+    }
+    else
+        m_gridGetHeight = &GridMap::getHeightFromFlat;
+
+    return true;
+}
+
+bool GridMap::mapLiquidData(uint32 offset)
+{
+    GridMapLiquidHeader header;
+    if (!mapHeader(offset, header) || header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+        return false;
+
+    offset += sizeof(header);
+
+    m_liquidType    = header.liquidType;
+    m_liquid_offX   = header.offsetX;
+    m_liquid_offY   = header.offsetY;
+    m_liquid_width  = header.width;
+    m_liquid_height = header.height;
+    m_liquidLevel   = header.liquidLevel;
+
+    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    {
+        m_liquid_type = mapArray<uint8>(offset, 16*16);
+        if (!m_liquid_type)
+            return false;
+    }
+
+    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+    {
+        m_liquid_map = mapArray<float>(offset, m_liquid_width*m_liquid_height);
+        if (!m_liquid_map)
+            return false;
+    }
+
+    return true;
+}
+
 void GridMap::unloadData()
 {
+    if (m_mapping)
+    {
+        // arrays belong to the mapping or to the copies
+        for (std::vector<char*>::iterator itr = m_mappingCopies.begin(); itr != m_mappingCopies.end(); ++itr)
+            delete [] *itr;
+
+        m_mappingCopies.clear();
+
+        m_mapping->close();
+        delete m_mapping;
+        m_mapping = NULL;
+
+        m_area_map = NULL;
+        m_V9 = NULL;
+        m_V8 = NULL;
+        m_liquid_type = NULL;
+        m_liquid_map  = NULL;
+    }
+
     if (m_area_map)
         delete[] m_area_map;
 
@@ -336,6 +550,110 @@ float GridMap::getHeightFromFloat(float x, float y) const
     return a * x + b * y + c;
 }
 
+void GridMap::getHeights(TerrainPoint* points, uint32 count) const
+{
+    if (m_gridGetHeight == &GridMap::getHeightFromFloat && m_V8 && m_V9)
+        getHeightsFrom(m_V9, m_V8, 1.0f, 0.0f, points, count);
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint16 && m_uint16_V8 && m_uint16_V9)
+        getHeightsFrom(m_uint16_V9, m_uint16_V8, m_gridIntHeightMultiplier, m_gridHeight, points, count);
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint8 && m_uint8_V8 && m_uint8_V9)
+        getHeightsFrom(m_uint8_V9, m_uint8_V8, m_gridIntHeightMultiplier, m_gridHeight, points, count);
+    else
+    {
+        for (uint32 i = 0; i < count; ++i)
+            points[i].height = m_gridHeight;
+    }
+}
+
+// Same triangle interpolation as getHeightFrom*, integer formats are exact in float
+// so all three share one path. Every lane computes the coefficients of all four
+// triangles and keeps the one its x, y fall into, results match the scalar code.
+template<class T>
+void GridMap::getHeightsFrom(T const* V9, T const* V8, float multiplier, float base, TerrainPoint* points, uint32 count) const
+{
+    uint32 i = 0;
+
+#ifdef GRIDMAP_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 center = _mm_set1_ps(32.0f);
+    const __m128 gridSize = _mm_set1_ps(SIZE_OF_GRIDS);
+    const __m128 resolution = _mm_set1_ps(float(MAP_RESOLUTION));
+    const __m128i cellMask = _mm_set1_epi32(MAP_RESOLUTION - 1);
+    const __m128 mult = _mm_set1_ps(multiplier);
+    const __m128 add = _mm_set1_ps(base);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        TerrainPoint* p = points + i;
+
+        __m128 x = _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x);
+        __m128 y = _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y);
+        x = _mm_mul_ps(resolution, _mm_sub_ps(center, _mm_div_ps(x, gridSize)));
+        y = _mm_mul_ps(resolution, _mm_sub_ps(center, _mm_div_ps(y, gridSize)));
+
+        __m128i x_int = _mm_cvttps_epi32(x);
+        __m128i y_int = _mm_cvttps_epi32(y);
+        x = _mm_sub_ps(x, _mm_cvtepi32_ps(x_int));
+        y = _mm_sub_ps(y, _mm_cvtepi32_ps(y_int));
+        x_int = _mm_and_si128(x_int, cellMask);
+        y_int = _mm_and_si128(y_int, cellMask);
+
+        int32 xi[4], yi[4];
+        _mm_storeu_si128((__m128i*)xi, x_int);
+        _mm_storeu_si128((__m128i*)yi, y_int);
+
+        // no gather in SSE2, corners are loaded per lane
+        float c1[4], c2[4], c3[4], c4[4], c5[4];
+        for (uint32 l = 0; l < 4; ++l)
+        {
+            T const* V9_h1_ptr = &V9[xi[l]*128 + xi[l] + yi[l]];
+            c1[l] = float(V9_h1_ptr[  0]);
+            c2[l] = float(V9_h1_ptr[129]);
+            c3[l] = float(V9_h1_ptr[  1]);
+            c4[l] = float(V9_h1_ptr[130]);
+            c5[l] = float(2 * V8[xi[l]*128 + yi[l]]);
+        }
+
+        __m128 h1 = _mm_loadu_ps(c1);
+        __m128 h2 = _mm_loadu_ps(c2);
+        __m128 h3 = _mm_loadu_ps(c3);
+        __m128 h4 = _mm_loadu_ps(c4);
+        __m128 h5 = _mm_loadu_ps(c5);
+
+        __m128 upper = _mm_cmplt_ps(_mm_add_ps(x, y), one); // triangles 1, 2
+        __m128 right = _mm_cmpgt_ps(x, y);                   // triangles 1, 3
+
+        // 1 (h1, h2, h5), 2 (h1, h3, h5), 3 (h2, h4, h5), 4 (h3, h4, h5)
+        __m128 a1 = _mm_sub_ps(h2, h1);
+        __m128 b1 = _mm_sub_ps(_mm_sub_ps(h5, h1), h2);
+        __m128 a2 = _mm_sub_ps(_mm_sub_ps(h5, h1), h3);
+        __m128 b2 = _mm_sub_ps(h3, h1);
+        __m128 a3 = _mm_sub_ps(_mm_add_ps(h2, h4), h5);
+        __m128 b3 = _mm_sub_ps(h4, h2);
+        __m128 a4 = _mm_sub_ps(h4, h3);
+        __m128 b4 = _mm_sub_ps(_mm_add_ps(h3, h4), h5);
+        __m128 c34 = _mm_sub_ps(h5, h4);
+
+        #define GRIDMAP_SELECT(m, t, f) _mm_or_ps(_mm_and_ps(m, t), _mm_andnot_ps(m, f))
+        __m128 a = GRIDMAP_SELECT(upper, GRIDMAP_SELECT(right, a1, a2), GRIDMAP_SELECT(right, a3, a4));
+        __m128 b = GRIDMAP_SELECT(upper, GRIDMAP_SELECT(right, b1, b2), GRIDMAP_SELECT(right, b3, b4));
+        __m128 c = GRIDMAP_SELECT(upper, h1, c34);
+        #undef GRIDMAP_SELECT
+
+        __m128 h = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), c);
+        h = _mm_add_ps(_mm_mul_ps(h, mult), add);
+
+        float heights[4];
+        _mm_storeu_ps(heights, h);
+        for (uint32 l = 0; l < 4; ++l)
+            p[l].height = heights[l];
+    }
+#endif
+
+    for (; i < count; ++i)
+        points[i].height = (this->*m_gridGetHeight)(points[i].x, points[i].y);
+}
+
 float GridMap::getHeightFromUint8(float x, float y) const
 {
     if (!m_uint8_V8 || !m_uint8_V9)
@@ -630,6 +948,7 @@ TerrainInfo::TerrainInfo(uint32 mapid, TerrainSpecifics terrainspecifics) : m_ma
 
     i_timer.SetInterval(GRID_CLEANUP_INTERVAL);
     i_timer.SetCurrent(urand(10000,50000));
+    i_preloadTimer.SetInterval(GRID_CLEANUP_INTERVAL);
 
     m_specifics = new MapTemplate(terrainspecifics);
 }
@@ -640,6 +959,9 @@ TerrainInfo::~TerrainInfo()
          for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
              delete m_GridMaps[i][k];
 
+     for (PreloadedGridMaps::iterator itr = m_preloadedMaps.begin(); itr != m_preloadedMaps.end(); ++itr)
+         delete itr->second;
+
      VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
      MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
 
@@ -663,9 +985,130 @@ GridMap * TerrainInfo::Load(const uint32 x, const uint32 y)
      return pMap;
 }
 
+void TerrainInfo::Prefetch(const uint32 x, const uint32 y)
+{
+     ASSERT(x < MAX_NUMBER_OF_GRIDS);
+     ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+     if (m_GridMaps[x][y] || !IsPathFindingEnabled())
+         return;
+
+     MMAP::MMapFactory::createOrGetMMapManager()->prefetchTile(m_mapId, x, y);
+}
+
+bool TerrainInfo::Preload(const uint32 x, const uint32 y)
+{
+     ASSERT(x < MAX_NUMBER_OF_GRIDS);
+     ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+     if (m_GridMaps[x][y])
+         return true;
+
+     uint32 gridId = x * MAX_NUMBER_OF_GRIDS + y;
+     {
+         LOCK_GUARD lock(m_mutex);
+
+         if (m_preloadedMaps.find(gridId) != m_preloadedMaps.end())
+             return true;
+
+         // queued or failed to read, failures are reported by regular load
+         if (!m_preloadQueued.insert(gridId).second)
+             return false;
+     }
+
+     if (!sTerrainMgr.QueuePreload(this, x, y))
+     {
+         LOCK_GUARD lock(m_mutex);
+         m_preloadQueued.erase(gridId);
+     }
+
+     return false;
+}
+
+// touches every page of file, following read finds it in page cache
+static void ReadAhead(std::string const& fileName)
+{
+    ACE_Mem_Map mapping;
+    if (mapping.map(fileName.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1)
+        return;
+
+    size_t page = ACE_OS::getpagesize();
+    char const* data = (char const*)mapping.addr();
+    volatile char sum = 0;
+    for (size_t i = 0; i < mapping.size(); i += page)
+        sum += data[i];
+}
+
+void TerrainInfo::PreloadGrid(const uint32 x, const uint32 y)
+{
+    if (m_GridMaps[x][y])
+        return;
+
+    GridMap * map = new GridMap();
+
+    char *tmp=NULL;
+    int len = sWorld.GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
+    tmp = new char[len];
+    snprintf(tmp, len, (char *)(sWorld.GetDataPath()+"maps/%03u%02u%02u.map").c_str(),m_mapId, x, y);
+
+    bool loaded = map->loadData(tmp);
+    delete [] tmp;
+
+    if (!loaded)
+    {
+        delete map;
+        return;
+    }
+
+    // vmap and mmap tiles are attached by map thread, only their files are read ahead
+    ReadAhead(sWorld.GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(m_mapId, x, y));
+
+    len = sWorld.GetDataPath().length()+strlen("mmaps/%03u%02u%02u.mmtile")+1;
+    tmp = new char[len];
+    snprintf(tmp, len, (char *)(sWorld.GetDataPath()+"mmaps/%03u%02u%02u.mmtile").c_str(),m_mapId, x, y);
+    ReadAhead(tmp);
+    delete [] tmp;
+
+    map->lastTimeUsed = WorldTimer::getMSTime();
+
+    {
+        LOCK_GUARD lock(m_mutex);
+
+        uint32 gridId = x * MAX_NUMBER_OF_GRIDS + y;
+        if (!m_GridMaps[x][y] && m_preloadedMaps.find(gridId) == m_preloadedMaps.end())
+        {
+            m_preloadedMaps[gridId] = map;
+            map = NULL;
+        }
+    }
+
+    delete map;
+}
+
 //call this method only
 void TerrainInfo::CleanUpGrids(const uint32 diff)
 {
+     // grids preloaded for players that turned away, never entered so continents too
+     if (i_preloadTimer.Expired(diff))
+     {
+         uint32 timeNow = WorldTimer::getMSTime();
+         LOCK_GUARD lock(m_mutex);
+
+         for (PreloadedGridMaps::iterator itr = m_preloadedMaps.begin(); itr != m_preloadedMaps.end();)
+         {
+             if ((itr->second->lastTimeUsed + GRID_CLEANUP_INTERVAL * 5) < timeNow)
+             {
+                 m_preloadQueued.erase(itr->first);
+                 delete itr->second;
+                 m_preloadedMaps.erase(itr++);
+             }
+             else
+                 ++itr;
+         }
+
+         i_preloadTimer.SetCurrent(0);
+     }
+
      // do not unload continent maps ever, its just pointless
      if (GetMapId() == 0 || GetMapId() == 1 || GetMapId() == 530 || !i_timer.Expired(diff)) 
          return;
@@ -698,14 +1141,68 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
 float TerrainInfo::GetHeight(float x, float y, float z, bool pUseVmaps, float maxSearchDist) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
-
-    float z2 = z + 2.f;
 
     // find raw .map surface under Z coordinates (or well-defined above)
     if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x, y))
         mapHeight = gmap->getHeight(x, y);
 
+    return SelectHeight(x, y, z, mapHeight, pUseVmaps, maxSearchDist);
+}
+
+void TerrainInfo::GetHeights(TerrainPoint* points, uint32 count, uint32 query, bool pUseVmaps, float maxSearchDist) const
+{
+    if (query & (TERRAIN_QUERY_HEIGHT | TERRAIN_QUERY_WATER))
+    {
+        for (uint32 i = 0; i < count;)
+        {
+            // callers pass nearby points, most batches are a single run
+            uint32 gx = uint32(32 - points[i].x / SIZE_OF_GRIDS);
+            uint32 gy = uint32(32 - points[i].y / SIZE_OF_GRIDS);
+
+            uint32 end = i + 1;
+            while (end < count && uint32(32 - points[end].x / SIZE_OF_GRIDS) == gx && uint32(32 - points[end].y / SIZE_OF_GRIDS) == gy)
+                ++end;
+
+            if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(points[i].x, points[i].y))
+                gmap->getHeights(points + i, end - i);
+            else
+            {
+                for (uint32 j = i; j < end; ++j)
+                    points[j].height = VMAP_INVALID_HEIGHT_VALUE;
+            }
+
+            i = end;
+        }
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        TerrainPoint& point = points[i];
+
+        if (query & (TERRAIN_QUERY_HEIGHT | TERRAIN_QUERY_WATER))
+            point.height = SelectHeight(point.x, point.y, point.z, point.height, pUseVmaps, maxSearchDist);
+
+        if (query & TERRAIN_QUERY_WATER)
+        {
+            GridMapLiquidData liquid_status;
+            if (getLiquidStatus(point.x, point.y, point.height, MAP_ALL_LIQUIDS, &liquid_status))
+                point.waterLevel = liquid_status.level;
+            else
+                point.waterLevel = VMAP_INVALID_HEIGHT_VALUE;
+        }
+
+        if (query & TERRAIN_QUERY_AREA)
+            point.areaFlag = GetAreaFlag(point.x, point.y, point.z);
+    }
+}
+
+// picks between .map height and vmap floor near z
+float TerrainInfo::SelectHeight(float x, float y, float z, float mapHeight, bool pUseVmaps, float maxSearchDist) const
+{
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
+
+    float z2 = z + 2.f;
+
     if (pUseVmaps)
     {
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
@@ -991,22 +1488,37 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
 
         if(!m_GridMaps[x][y])
         {
-            GridMap * map = new GridMap();
+            GridMap * map = NULL;
 
-            // map file name
-            char *tmp=NULL;
-            int len = sWorld.GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
-            tmp = new char[len];
-            snprintf(tmp, len, (char *)(sWorld.GetDataPath()+"maps/%03u%02u%02u.map").c_str(),m_mapId, x, y);
-            sLog.outDetail("Loading map %s",tmp);
+            uint32 gridId = x * MAX_NUMBER_OF_GRIDS + y;
+            m_preloadQueued.erase(gridId);
 
-            if(!map->loadData(tmp))
+            // terrain already read by preload thread
+            PreloadedGridMaps::iterator preloaded = m_preloadedMaps.find(gridId);
+            if (preloaded != m_preloadedMaps.end())
             {
-                sLog.outLog(LOG_DEFAULT, "ERROR: Error load map file: \n %s\n", tmp);
-                //ASSERT(false);
+                map = preloaded->second;
+                m_preloadedMaps.erase(preloaded);
+            }
+            else
+            {
+                map = new GridMap();
+
+                // map file name
+                char *tmp=NULL;
+                int len = sWorld.GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
+                tmp = new char[len];
+                snprintf(tmp, len, (char *)(sWorld.GetDataPath()+"maps/%03u%02u%02u.map").c_str(),m_mapId, x, y);
+                sLog.outDetail("Loading map %s",tmp);
+
+                if(!map->loadData(tmp))
+                {
+                    sLog.outLog(LOG_DEFAULT, "ERROR: Error load map file: \n %s\n", tmp);
+                    //ASSERT(false);
+                }
+
+                delete [] tmp;
             }
-
-            delete [] tmp;
 
             //load VMAPs for current map/grid...
             const MapEntry * i_mapEntry = sMapStore.LookupEntry(m_mapId);
@@ -1112,12 +1624,40 @@ float TerrainInfo::GetVisibilityDistance()
 
 //////////////////////////////////////////////////////////////////////////
 
+class GridPreloadRequest : public ACE_Method_Request
+{
+    public:
+        GridPreloadRequest(TerrainInfo* terrain, uint32 x, uint32 y) : m_terrain(terrain), m_x(x), m_y(y)
+        {
+            m_terrain->AddRef();
+        }
+
+        ~GridPreloadRequest()
+        {
+            if (m_terrain->Release())
+                sTerrainMgr.UnloadTerrain(m_terrain->GetMapId());
+        }
+
+        virtual int call()
+        {
+            m_terrain->PreloadGrid(m_x, m_y);
+            return 0;
+        }
+
+    private:
+        TerrainInfo* m_terrain;
+        uint32 m_x;
+        uint32 m_y;
+};
+
 TerrainManager::TerrainManager()
 {
 }
 
 TerrainManager::~TerrainManager()
 {
+    StopPreload();
+
     for (TerrainDataMap::iterator it = i_TerrainMap.begin(); it != i_TerrainMap.end(); ++it)
         delete it->second;
 }
@@ -1208,6 +1748,30 @@ void TerrainManager::Update(const uint32 diff)
         iter->second->CleanUpGrids(diff);
 }
 
+bool TerrainManager::QueuePreload(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, Lock, false);
+
+        if (!m_preloader.activated() && m_preloader.activate(1) == -1)
+            return false;
+    }
+
+    GridPreloadRequest* request = new GridPreloadRequest(terrain, x, y);
+    if (m_preloader.execute(request) == -1)
+    {
+        delete request;
+        return false;
+    }
+
+    return true;
+}
+
+void TerrainManager::StopPreload()
+{
+    m_preloader.deactivate();
+}
+
 void TerrainManager::UnloadAll()
 {
     for (TerrainDataMap::iterator it = i_TerrainMap.begin(); it != i_TerrainMap.end(); ++it)
@@ -28,8 +28,14 @@
 #include "Object.h"
 #include "SharedDefines.h"
 
+#include <ace/Mem_Map.h>
+
 #include <bitset>
 #include <list>
+#include <map>
+#include <set>
+
+#include "DelayExecutor.h"
 
 class Creature;
 class Unit;
@@ -125,6 +131,23 @@ struct GridMapLiquidHeader
 #define MAP_LIQUID_TYPE_WMO_WATER   0x20
 
 /*struct GridMapLiquidData Moved to GridDefines.h */
+
+enum TerrainQuery
+{
+    TERRAIN_QUERY_HEIGHT    = 0x01,                         // height as TerrainInfo::GetHeight
+    TERRAIN_QUERY_WATER     = 0x02,                         // liquid level at found height, VMAP_INVALID_HEIGHT_VALUE if none
+    TERRAIN_QUERY_AREA      = 0x04                          // area flag as TerrainInfo::GetAreaFlag
+};
+
+// one point of TerrainInfo::GetHeights
+struct TerrainPoint
+{
+    float x, y, z;
+    float height;
+    float waterLevel;
+    uint16 areaFlag;
+};
+
 class GridMap
 {
     private:
@@ -164,6 +187,16 @@ class GridMap
         bool loadHeightData(FILE *in, uint32 offset, uint32 size);
         bool loadGridMapLiquidData(FILE *in, uint32 offset, uint32 size);
 
+        // Memory mapped file, data pointers point straight into it
+        ACE_Mem_Map *m_mapping;
+        std::vector<char*> m_mappingCopies;                 // misaligned arrays copied out of the mapping
+
+        template<class T> T* mapArray(uint32 &offset, uint32 count);
+        template<class T> bool mapHeader(uint32 offset, T &header);
+        bool mapAreaData(uint32 offset);
+        bool mapHeightData(uint32 offset);
+        bool mapLiquidData(uint32 offset);
+
         // Get height functions and pointers
         typedef float (GridMap::*pGetHeightPtr) (float x, float y) const;
         pGetHeightPtr m_gridGetHeight;
@@ -172,18 +205,28 @@ class GridMap
         float getHeightFromUint8(float x, float y) const;
         float getHeightFromFlat(float x, float y) const;
 
+        template<class T>
+        void getHeightsFrom(T const* V9, T const* V8, float multiplier, float base, TerrainPoint* points, uint32 count) const;
+
     public:
         GridMap();
         ~GridMap();
 
+        // reads or maps the file depending on GridMap.MemoryMapped
         bool loadData(char *filaname);
+        bool loadFromFile(char *filename);
+        bool loadFromMapping(char *filename);
         void unloadData();
 
+        bool IsMapped() const { return m_mapping != NULL; }
+
         static bool ExistMap(uint32 mapid, int gx, int gy);
         static bool ExistVMap(uint32 mapid, int gx, int gy);
 
         uint16 getArea(float x, float y);
         float getHeight(float x, float y) { return (this->*m_gridGetHeight)(x, y); }
+        // fills height of points inside this grid, four at once where SSE2 is available
+        void getHeights(TerrainPoint* points, uint32 count) const;
         float getLiquidLevel(float x, float y);
         uint8 getTerrainType(float x, float y);
         uint32 lastTimeUsed;
@@ -241,6 +284,8 @@ class HELLGROUND_IMPORT_EXPORT TerrainInfo : public Referencable<AtomicLong>
         //TODO: move all terrain/vmaps data info query functions
         //from 'Map' class into this class
         float GetHeight(float x, float y, float z, bool pCheckVMap=true, float maxSearchDist=DEFAULT_HEIGHT_SEARCH) const;
+        // batch version of GetHeight/GetAreaFlag, query is TerrainQuery mask, runs of points in one grid share the lookup
+        void GetHeights(TerrainPoint* points, uint32 count, uint32 query = TERRAIN_QUERY_HEIGHT, bool pCheckVMap=true, float maxSearchDist=DEFAULT_HEIGHT_SEARCH) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = NULL) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float* pGround = NULL, bool swim = false) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData *data = 0) const;
@@ -275,13 +320,22 @@ class HELLGROUND_IMPORT_EXPORT TerrainInfo : public Referencable<AtomicLong>
         friend class Map;
         //load/unload terrain data
         GridMap * Load(const uint32 x, const uint32 y);
+        // grid is about to be loaded, read its data ahead in background
+        void Prefetch(const uint32 x, const uint32 y);
+        // queues terrain read of grid for preload thread, true when terrain is ready to be loaded without disk access
+        bool Preload(const uint32 x, const uint32 y);
 
     private:
+        friend class GridPreloadRequest;
+
         TerrainInfo(const TerrainInfo&);
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap * GetGrid( const float x, const float y );
+        float SelectHeight(float x, float y, float z, float mapHeight, bool pUseVmaps, float maxSearchDist) const;
         GridMap * LoadMapAndVMap(const uint32 x, const uint32 y );
+        // preload thread only
+        void PreloadGrid(const uint32 x, const uint32 y);
 
         const uint32 m_mapId;
 
@@ -290,8 +344,15 @@ class HELLGROUND_IMPORT_EXPORT TerrainInfo : public Referencable<AtomicLong>
         GridMap *m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
+        // read by preload thread, taken over by LoadMapAndVMap; grid id is x * MAX_NUMBER_OF_GRIDS + y
+        typedef std::map<uint32, GridMap*> PreloadedGridMaps;
+        PreloadedGridMaps m_preloadedMaps;
+        std::set<uint32> m_preloadQueued;
+
         //global garbage collection timer
         Timer i_timer;
+        // preloaded grids are dropped on all maps, continents included
+        Timer i_preloadTimer;
 
         typedef ACE_Thread_Mutex LOCK_TYPE;
         typedef ACE_Guard<LOCK_TYPE> LOCK_GUARD;
@@ -316,6 +377,9 @@ class TerrainManager
         void Update(const uint32 diff);
         void UnloadAll();
 
+        bool QueuePreload(TerrainInfo* terrain, uint32 x, uint32 y);
+        void StopPreload();
+
         uint16 GetAreaFlag(uint32 mapid, float x, float y, float z) const
         {
             TerrainInfo *pData = const_cast<TerrainManager*>(this)->LoadTerrain(mapid);
@@ -347,6 +411,9 @@ class TerrainManager
         ACE_Thread_Mutex Lock;
         TerrainDataMap i_TerrainMap;
         TerrainsSpecificsMap i_TerrainSpecifics;
+
+        // single thread reading terrain files of grids players are heading to
+        DelayExecutor m_preloader;
 };
 
 #define sTerrainMgr (*ACE_Singleton<TerrainManager, ACE_Thread_Mutex>::instance())
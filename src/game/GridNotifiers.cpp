@@ -30,11 +30,50 @@
 #include "ObjectAccessor.h"
 #include "CellImpl.h"
 #include "SpellAuras.h"
+#include "World.h"
+
+#include <atomic>
 
 using namespace Hellground;
 
+static std::atomic<uint64> s_visibilityScans(0);
+static std::atomic<uint64> s_visibilityChecked(0);
+static std::atomic<uint64> s_visibilitySkipped(0);
+
+static void AddVisibilityUpdateStats(uint32 checked, uint32 skipped)
+{
+    s_visibilityScans.fetch_add(1, std::memory_order_relaxed);
+    if (checked)
+        s_visibilityChecked.fetch_add(checked, std::memory_order_relaxed);
+    if (skipped)
+        s_visibilitySkipped.fetch_add(skipped, std::memory_order_relaxed);
+}
+
+VisibilityUpdateStats Hellground::GetVisibilityUpdateStats()
+{
+    VisibilityUpdateStats stats;
+    stats.scans = s_visibilityScans.load(std::memory_order_relaxed);
+    stats.checked = s_visibilityChecked.load(std::memory_order_relaxed);
+    stats.skipped = s_visibilitySkipped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Hellground::ResetVisibilityUpdateStats()
+{
+    s_visibilityScans = 0;
+    s_visibilityChecked = 0;
+    s_visibilitySkipped = 0;
+}
+
+VisibleNotifier::VisibleNotifier(Camera &c) : _camera(c), vis_guids(c.GetOwner()->m_clientGUIDs),
+    i_incremental(sWorld.getConfig(CONFIG_VISIBILITY_INCREMENTAL)), i_checked(0), i_skipped(0)
+{
+}
+
 void VisibleNotifier::SendToSelf()
 {
+    AddVisibilityUpdateStats(i_checked, i_skipped);
+
     Player& player = *_camera.GetOwner();
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
@@ -78,10 +117,30 @@ void VisibleNotifier::SendToSelf()
     }
 }
 
+VisibleChangesNotifier::VisibleChangesNotifier(WorldObject &object) : _object(object),
+    i_incremental(sWorld.getConfig(CONFIG_VISIBILITY_INCREMENTAL)), i_checked(0), i_skipped(0)
+{
+}
+
+VisibleChangesNotifier::~VisibleChangesNotifier()
+{
+    AddVisibilityUpdateStats(i_checked, i_skipped);
+}
+
 void VisibleChangesNotifier::Visit(CameraMapType& m)
 {
     for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        iter->getSource()->UpdateVisibilityOf(&_object);
+    {
+        Camera* camera = iter->getSource();
+        if (i_incremental && camera->GetOwner()->IsVisibilityUnchanged(camera->GetBody(), &_object))
+        {
+            ++i_skipped;
+            continue;
+        }
+
+        ++i_checked;
+        camera->UpdateVisibilityOf(&_object);
+    }
 }
 
 void DynamicObjectUpdater::VisitHelper(Unit* target)
@@ -24,6 +24,7 @@
 #include "ObjectGridLoader.h"
 #include "ByteBuffer.h"
 #include "UpdateData.h"
+#include "SharedPacket.h"
 #include <iostream>
 
 #include "Corpse.h"
@@ -38,8 +39,20 @@
 class Player;
 //class Map;
 
+struct VisibilityUpdateStats
+{
+    VisibilityUpdateStats() : scans(0), checked(0), skipped(0) {}
+
+    uint64 scans;                                           // visibility updates of camera or moved object
+    uint64 checked;                                         // object pairs checked with full visibility check
+    uint64 skipped;                                         // object pairs kept because visibility state did not change
+};
+
 namespace Hellground
 {
+    VisibilityUpdateStats GetVisibilityUpdateStats();
+    void ResetVisibilityUpdateStats();
+
     struct VisibleNotifier
     {
         Camera& _camera;
@@ -48,7 +61,11 @@ namespace Hellground
         std::set<WorldObject*> i_visibleNow;
         Player::ClientGUIDs vis_guids;
 
-        VisibleNotifier(Camera &c) : _camera(c), vis_guids(c.GetOwner()->m_clientGUIDs) {}
+        bool i_incremental;
+        uint32 i_checked;
+        uint32 i_skipped;
+
+        explicit VisibleNotifier(Camera &c);
 
         void Visit(CameraMapType &m) {}
 
@@ -62,7 +79,12 @@ namespace Hellground
     {
         WorldObject &_object;
 
-        explicit VisibleChangesNotifier(WorldObject &object) : _object(object) {}
+        bool i_incremental;
+        uint32 i_checked;
+        uint32 i_skipped;
+
+        explicit VisibleChangesNotifier(WorldObject &object);
+        ~VisibleChangesNotifier();
 
         void Visit(CameraMapType &);
 
@@ -97,7 +119,7 @@ namespace Hellground
     struct HELLGROUND_EXPORT PacketBroadcaster
     {
         WorldObject &_source;
-        WorldPacket *_message;
+        SharedPacket _message;
 
         typedef std::set<uint64> GUIDSet;
         GUIDSet playerGUIDS;
@@ -35,9 +35,18 @@ namespace Hellground
 template<class T>
 inline void VisibleNotifier::Visit(GridRefManager<T> &m)
 {
+    Player const* owner = _camera.GetOwner();
     for(typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         vis_guids.erase(iter->getSource()->GetGUID());
+
+        if (i_incremental && owner->IsVisibilityUnchanged(_camera.GetBody(), iter->getSource()))
+        {
+            ++i_skipped;
+            continue;
+        }
+
+        ++i_checked;
         _camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
     }
 }
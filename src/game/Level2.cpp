@@ -5274,7 +5274,8 @@ bool ChatHandler::HandleMmapLocCommand(const char* /*args*/)
 
     // calculate navmesh tile location
     const dtNavMesh* navmesh = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMesh(player->GetMapId());
-    const dtNavMeshQuery* navmeshquery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(player->GetMapId(), player->GetInstanceId());
+    MMAP::NavMeshQueryHolder query(player->GetMapId());
+    const dtNavMeshQuery* navmeshquery = query.GetQuery();
     if (!navmesh || !navmeshquery)
     {
         PSendSysMessage("NavMesh not loaded for current map.");
@@ -5319,8 +5320,7 @@ bool ChatHandler::HandleMmapLoadedTilesCommand(const char* /*args*/)
     uint32 mapid = m_session->GetPlayer()->GetMapId();
 
     const dtNavMesh* navmesh = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMesh(mapid);
-    const dtNavMeshQuery* navmeshquery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(mapid, m_session->GetPlayer()->GetInstanceId());
-    if (!navmesh || !navmeshquery)
+    if (!navmesh)
     {
         PSendSysMessage("NavMesh not loaded for current map.");
         return true;
@@ -5347,6 +5347,26 @@ bool ChatHandler::HandleMmapStatsCommand(const char* /*args*/)
 
     MMAP::MMapManager *manager = MMAP::MMapFactory::createOrGetMMapManager();
     PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
+    if (sWorld.getConfig(CONFIG_MMAP_PATH_THREADS))
+        PSendSysMessage(" %u path searches done by path threads", manager->getPathSearchCount());
+    else
+        PSendSysMessage(" " UI64FMTD " path searches deferred to next map update", Map::GetDeferredRepathCount());
+    if (sWorld.getConfig(CONFIG_MMAP_MEMORY_MAPPED))
+        PSendSysMessage(" %u tiles prefetched", manager->getPrefetchCount());
+
+    if (MMAP::PolyPathCache* cache = manager->GetPolyPathCache(m_session->GetPlayer()->GetMapId()))
+    {
+        uint32 size;
+        uint64 hits, misses;
+        cache->GetStats(size, hits, misses);
+        PSendSysMessage(" path cache on current map: %u paths, " UI64FMTD " hits, " UI64FMTD " misses", size, hits, misses);
+    }
+
+    std::vector<MMAP::MMapMemoryStats> memStats;
+    manager->GetMemoryStats(memStats);
+    for (std::vector<MMAP::MMapMemoryStats>::const_iterator itr = memStats.begin(); itr != memStats.end(); ++itr)
+        PSendSysMessage(" map %03u: %u tiles (%u mapped%s) %.2f MB, %u queries (%u in use) %.2f MB", itr->mapId, itr->tiles,
+            itr->mappedTiles, itr->archive ? " from archive" : "", itr->tileBytes / 1048576.0f, itr->queries, itr->queriesInUse, itr->queryBytes / 1048576.0f);
 
     const dtNavMesh* navmesh = manager->GetNavMesh(m_session->GetPlayer()->GetMapId());
     if (!navmesh)
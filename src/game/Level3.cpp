@@ -55,6 +55,7 @@
 #include "CreatureEventAIMgr.h"
 #include "ChannelMgr.h"
 #include "GuildMgr.h"
+#include "WorldSocket.h"
 
 bool ChatHandler::HandleReloadAutobroadcastCommand(const char*)
 {
@@ -4340,11 +4341,11 @@ bool ChatHandler::HandleListAurasCommand (const char* args)
 
     for (; i < TOTAL_AURAS; i++)
     {
-        Unit::AuraList const& uAuraList = unit->GetAurasByType(AuraType(i));
+        Unit::AuraTypeList const& uAuraList = unit->GetAurasByType(AuraType(i));
         if (uAuraList.empty()) continue;
         PSendSysMessage(LANG_COMMAND_TARGET_LISTAURATYPE, uAuraList.size(), i);
         if (!id && uAuras.size() > 10) continue; // dont show full list if too many auras, just numbers
-        for (Unit::AuraList::const_iterator itr = uAuraList.begin(); itr != uAuraList.end(); ++itr)
+        for (Unit::AuraTypeList::const_iterator itr = uAuraList.begin(); itr != uAuraList.end(); ++itr)
         {
             bool talent = GetTalentSpellCost((*itr)->GetId()) > 0;
 
@@ -7439,6 +7440,186 @@ bool ChatHandler::HandleServerKickallCommand(const char* args)
     return true;
 }
 
+static bool MapCostGreater(MapCostMap::value_type const* a, MapCostMap::value_type const* b)
+{
+    return a->second.avgTime > b->second.avgTime;
+}
+
+bool ChatHandler::HandleServerCompressionCommand(const char* args)
+{
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+
+        UpdateData::ResetCompressionStats();
+        PSendSysMessage("Update packet compression stats reset.");
+        return true;
+    }
+
+    UpdateCompressionStats stats = UpdateData::GetCompressionStats();
+
+    PSendSysMessage("Update packet compression level %u:", sWorld.getConfig(CONFIG_COMPRESSION));
+    if (!stats.packets)
+    {
+        PSendSysMessage(" no packets compressed yet");
+        return true;
+    }
+
+    PSendSysMessage(" " UI64FMTD " packets, " UI64FMTD " bytes in, " UI64FMTD " bytes out (%.1f%%)",
+        stats.packets, stats.bytesIn, stats.bytesOut, stats.bytesIn ? 100.0f * stats.bytesOut / stats.bytesIn : 0.0f);
+    PSendSysMessage(" " UI64FMTD " ns per packet, %.1f MB/s", stats.timeNs / stats.packets,
+        stats.timeNs ? (stats.bytesIn * 1000.0f / stats.timeNs) : 0.0f);
+    return true;
+}
+
+bool ChatHandler::HandleServerSetCompressionCommand(const char* args)
+{
+    if (!*args)
+        return false;
+
+    int32 level = atoi(args);
+    if (level < 1 || level > 9)
+    {
+        PSendSysMessage("Compression level must be in range 1..9.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    // compressors pick the new level up at their next packet
+    sWorld.setConfig(CONFIG_COMPRESSION, level);
+    UpdateData::ResetCompressionStats();
+
+    PSendSysMessage("Update packet compression level set to %i, stats reset.", level);
+    return true;
+}
+
+bool ChatHandler::HandleServerMapCostsCommand(const char* args)
+{
+    uint32 count = *args ? atoi(args) : 10;
+    if (!count)
+        return false;
+
+    MapCostMap costs = sMapMgr.GetMapUpdater()->GetMapCosts();
+    if (costs.empty())
+    {
+        PSendSysMessage("No map update cost history (MapUpdate.CostSamples = %u).", sWorld.getConfig(CONFIG_MAPUPDATE_COST_SAMPLES));
+        return true;
+    }
+
+    std::vector<MapCostMap::value_type const*> sorted;
+    sorted.reserve(costs.size());
+    for (MapCostMap::const_iterator itr = costs.begin(); itr != costs.end(); ++itr)
+        sorted.push_back(&*itr);
+
+    std::sort(sorted.begin(), sorted.end(), MapCostGreater);
+
+    uint64 total = 0;
+    for (uint32 i = 0; i < sorted.size(); ++i)
+        total += sorted[i]->second.avgTime;
+
+    PSendSysMessage("Map update costs (%u maps, sum of averages %u us, %u threads):", uint32(costs.size()), uint32(total), sWorld.getConfig(CONFIG_NUMTHREADS));
+    for (uint32 i = 0; i < sorted.size() && i < count; ++i)
+    {
+        MapUpdateCost const& cost = sorted[i]->second;
+        PSendSysMessage("Map %u instance %u: avg %u us, last %u us, max %u us, %u updates",
+            sorted[i]->first.first, sorted[i]->first.second, cost.avgTime, cost.lastTime, cost.maxTime, cost.updates);
+    }
+
+    return true;
+}
+
+static void SendDBQueueStats(ChatHandler* handler, const char* name, Database& db)
+{
+    std::vector<SqlDelayStats> stats;
+    db.GetAsyncStats(stats);
+
+    handler->PSendSysMessage("%s database, %u async connections:", name, uint32(stats.size()));
+    for (uint32 i = 0; i < stats.size(); ++i)
+    {
+        handler->PSendSysMessage(" #%u: depth " UI64FMTD ", executed " UI64FMTD ", coalesced " UI64FMTD ", latency avg %u ms max %u ms",
+            i, stats[i].queued - stats[i].executed, stats[i].executed, stats[i].coalesced, stats[i].avgLatency, stats[i].maxLatency);
+    }
+}
+
+bool ChatHandler::HandleServerDBQueueCommand(const char* /*args*/)
+{
+    // latency values cover time since previous call
+    SendDBQueueStats(this, "Character", RealmDataDatabase);
+    SendDBQueueStats(this, "World", GameDataDatabase);
+    SendDBQueueStats(this, "Login", AccountsDatabase);
+    return true;
+}
+
+bool ChatHandler::HandleServerSaveStatsCommand(const char* args)
+{
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+
+        Player::ResetSaveStats();
+        PSendSysMessage("Player save stats reset.");
+        return true;
+    }
+
+    PlayerSaveStats stats = Player::GetSaveStats();
+    if (!stats.saves)
+    {
+        PSendSysMessage("No player saves yet.");
+        return true;
+    }
+
+    PSendSysMessage("Player saves: " UI64FMTD ", statements " UI64FMTD " (avg " UI64FMTD ", max %u per save)",
+        stats.saves, stats.statements, stats.statements / stats.saves, stats.maxStatements);
+    return true;
+}
+
+bool ChatHandler::HandleServerNetStatsCommand(const char* args)
+{
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+
+        WorldSocket::ResetSendStats();
+        PSendSysMessage("Socket send stats reset.");
+        return true;
+    }
+
+    NetSendStats stats = WorldSocket::GetSendStats();
+
+    PSendSysMessage("Packets copied to output buffer: " UI64FMTD, stats.buffered);
+    PSendSysMessage("Small packets appended to queued blocks: " UI64FMTD, stats.coalesced);
+    PSendSysMessage("Packets copied to send queue: " UI64FMTD, stats.queued);
+    PSendSysMessage("Packets queued with shared payload: " UI64FMTD " (" UI64FMTD " bytes not copied)", stats.shared, stats.sharedBytes);
+    return true;
+}
+
+bool ChatHandler::HandleServerVisStatsCommand(const char* args)
+{
+    if (*args)
+    {
+        if (strncmp(args, "reset", strlen(args)) != 0)
+            return false;
+
+        Hellground::ResetVisibilityUpdateStats();
+        PSendSysMessage("Visibility update stats reset.");
+        return true;
+    }
+
+    VisibilityUpdateStats stats = Hellground::GetVisibilityUpdateStats();
+    uint64 pairs = stats.checked + stats.skipped;
+
+    PSendSysMessage("Incremental visibility: %s", sWorld.getConfig(CONFIG_VISIBILITY_INCREMENTAL) ? "on" : "off");
+    PSendSysMessage("Visibility updates: " UI64FMTD, stats.scans);
+    PSendSysMessage("Pairs checked: " UI64FMTD ", skipped: " UI64FMTD " (%.1f%%)", stats.checked, stats.skipped,
+        pairs ? stats.skipped * 100.0f / pairs : 0.0f);
+    if (stats.scans)
+        PSendSysMessage("Per update: %.1f checked, %.1f skipped", float(stats.checked) / stats.scans, float(stats.skipped) / stats.scans);
+    return true;
+}
+
 bool ChatHandler::HandleModifyAddTitleCommand(const char* args)
 {
     if (!*args)
@@ -44,6 +44,10 @@
 #include "VMapFactory.h"
 #include "MoveMap.h"
 
+#include <ace/TSS_T.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Method_Request.h>
+
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
 #define MAX_CREATURE_ATTACK_RADIUS  (45.0f * sWorld.getConfig(RATE_CREATURE_AGGRO))
@@ -65,8 +69,6 @@ Map::~Map()
     if (!m_scriptSchedule.empty())
         sWorld.DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
-     MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(m_TerrainData->GetMapId(), GetInstanceId());
-
     //release reference count
     if (m_TerrainData->Release())
         sTerrainMgr.UnloadTerrain(m_TerrainData->GetMapId());
@@ -91,7 +93,7 @@ void Map::DeleteStateMachine()
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
    : i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
      i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-     m_activeNonPlayersIter(m_activeNonPlayers.end()), i_scriptLock(true)
+     m_activeNonPlayersIter(m_activeNonPlayers.end()), i_scriptLock(true), m_regionUpdate(false), m_repathCount(0)
 {
     for (unsigned int j=0; j < MAX_NUMBER_OF_GRIDS; ++j)
     {
@@ -309,7 +311,16 @@ void Map::EnsureGridLoaded(const Cell &cell)
         sLog.outDebug("Loading grid[%u,%u] for map %u instance %u", cell.GridX(), cell.GridY(), GetId(), i_InstanceId);
 
         ObjectGridLoader loader(*grid, this, cell);
-        loader.LoadN();
+
+        // preloaded grid has part of its cells loaded already
+        PendingGridLoads::iterator pending = m_pendingGridLoads.find(grid->GetGridId());
+        if (pending != m_pendingGridLoads.end())
+        {
+            loader.LoadCells(pending->second, MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS);
+            m_pendingGridLoads.erase(pending);
+        }
+        else
+            loader.LoadN();
 
         // Add resurrectable corpses to world object list in grid
         sObjectAccessor.AddCorpsesToGrid(GridPair(cell.GridX(), cell.GridY()), (*grid)(cell.CellX(), cell.CellY()), this);
@@ -325,6 +336,78 @@ void Map::EnsureGridLoaded(const Cell &cell)
     }
 }
 
+void Map::PrefetchGrids(CellArea const& area)
+{
+    // grids reaching into visibility range but not created yet are the ones players walk into next
+    for (uint32 x = area.low_bound.x_coord / MAX_NUMBER_OF_CELLS; x <= area.high_bound.x_coord / MAX_NUMBER_OF_CELLS; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord / MAX_NUMBER_OF_CELLS; y <= area.high_bound.y_coord / MAX_NUMBER_OF_CELLS; ++y)
+        {
+            if (!getNGrid(x, y))
+                m_TerrainData->Prefetch((MAX_NUMBER_OF_GRIDS - 1) - x, (MAX_NUMBER_OF_GRIDS - 1) - y);
+        }
+    }
+}
+
+void Map::PreloadGridAhead(Player* player, uint32 lookAhead)
+{
+    if (!player->isMoving() && !player->IsTaxiFlying())
+        return;
+
+    float speed = player->GetSpeed(player->IsFlying() || player->IsTaxiFlying() ? MOVE_FLIGHT : MOVE_RUN);
+    float x = player->GetPositionX() + speed * lookAhead * cos(player->GetOrientation());
+    float y = player->GetPositionY() + speed * lookAhead * sin(player->GetOrientation());
+    Hellground::NormalizeMapCoord(x);
+    Hellground::NormalizeMapCoord(y);
+
+    GridPair p = Hellground::ComputeGridPair(x, y);
+    NGridType* grid = getNGrid(p.x_coord, p.y_coord);
+    if (!grid)
+    {
+        // grid is created only after its terrain was read in background, map update must not wait for disk
+        if (!m_TerrainData->Preload((MAX_NUMBER_OF_GRIDS - 1) - p.x_coord, (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord))
+            return;
+
+        EnsureGridCreated(p);
+        grid = getNGrid(p.x_coord, p.y_coord);
+    }
+
+    // objects are loaded by LoadPreloadedGrids, few cells every update
+    if (!grid->isGridObjectDataLoaded())
+        m_pendingGridLoads.insert(PendingGridLoads::value_type(grid->GetGridId(), 0));
+}
+
+void Map::LoadPreloadedGrids(uint32 cellBudget)
+{
+    for (PendingGridLoads::iterator itr = m_pendingGridLoads.begin(); itr != m_pendingGridLoads.end() && cellBudget;)
+    {
+        uint32 x = itr->first / MAX_NUMBER_OF_GRIDS;
+        uint32 y = itr->first % MAX_NUMBER_OF_GRIDS;
+
+        NGridType* grid = getNGrid(x, y);
+        if (!grid || grid->isGridObjectDataLoaded())
+        {
+            m_pendingGridLoads.erase(itr++);
+            continue;
+        }
+
+        // all cells loaded, grid is marked loaded by EnsureGridLoaded when someone enters it
+        if (itr->second >= MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS)
+        {
+            ++itr;
+            continue;
+        }
+
+        Cell cell(CellPair(x * MAX_NUMBER_OF_CELLS, y * MAX_NUMBER_OF_CELLS));
+        ObjectGridLoader loader(*grid, this, cell);
+
+        uint32 next = loader.LoadCells(itr->second, cellBudget);
+        cellBudget -= next - itr->second;
+        itr->second = next;
+        ++itr;
+    }
+}
+
 bool Map::Add(Player *player)
 {
     player->SetInstanceId(GetInstanceId());
@@ -430,6 +513,8 @@ void Map::Update(const uint32 &t_diff)
     volatile uint32 debug_map_id = GetId();
     uint32 startTime = WorldTimer::getMSTime();
 
+    m_repathCount.store(0, std::memory_order_relaxed);
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -470,6 +555,13 @@ void Map::Update(const uint32 &t_diff)
     TypeContainerVisitor<Hellground::ObjectUpdater, WorldTypeMapContainer> world_object_update(updater);
 
 
+    // continents can update cells around players concurrently, cells are only collected here
+    bool regionUpdate = !Instanceable() && sMapMgr.GetMapUpdater()->region_activated();
+    std::vector<CellPair> regionCells;
+
+    bool prefetchGrids = sWorld.getConfig(CONFIG_MMAP_MEMORY_MAPPED);
+    uint32 preloadTime = sWorld.getConfig(CONFIG_GRID_PRELOAD_TIME);
+
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -483,6 +575,12 @@ void Map::Update(const uint32 &t_diff)
 
         CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance() + World::GetVisibleObjectGreyDistance());
 
+        if (prefetchGrids)
+            PrefetchGrids(area);
+
+        if (preloadTime)
+            PreloadGridAhead(plr, preloadTime);
+
         for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
         {
             for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
@@ -497,6 +595,18 @@ void Map::Update(const uint32 &t_diff)
                     CellPair pair(x,y);
                     Cell cell(pair);
                     cell.SetNoCreate();
+
+                    if (regionUpdate)
+                    {
+                        // grid loading must not happen in region threads
+                        if (loaded(GridPair(cell.GridX(), cell.GridY())))
+                        {
+                            EnsureGridLoaded(cell);
+                            regionCells.push_back(pair);
+                        }
+                        continue;
+                    }
+
                     Visit(cell, grid_object_update);
                     Visit(cell, world_object_update);
                     if (WorldTimer::getMSTimeDiffToNow(startTime) > alloweddiff)
@@ -506,6 +616,12 @@ void Map::Update(const uint32 &t_diff)
         }
     }
 
+    if (!m_pendingGridLoads.empty())
+        LoadPreloadedGrids(sWorld.getConfig(CONFIG_GRID_PRELOAD_CELLS));
+
+    if (regionUpdate)
+        UpdateCellRegions(t_diff, regionCells);
+
     float updatedistance = GetActiveObjectUpdateDistance();
     alloweddiff = sWorld.getConfig(CONFIG_MIN_LOG_ACTIVE_CELL);
     // non-player active objects
@@ -583,6 +699,8 @@ void Map::CheckHostileRefFor(Player* plr)
 
 }
 
+static void SendObjectUpdatesConcurrently(uint32 mapId, UpdateDataMapType& update_players);
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
@@ -594,6 +712,12 @@ void Map::SendObjectUpdates()
 
     i_objectsToClientUpdate.clear();
 
+    if (update_players.size() >= sWorld.getConfig(CONFIG_MAPUPDATE_PACKET_MIN_PLAYERS) && sMapMgr.GetMapUpdater()->packet_activated())
+    {
+        SendObjectUpdatesConcurrently(GetId(), update_players);
+        return;
+    }
+
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
@@ -754,6 +878,16 @@ void Map::AddCreatureToMoveList(Creature *c, float x, float y, float z, float an
     if (!c)
         return;
 
+    if (m_regionUpdate)
+    {
+        if (MapCellRegion* region = GetCurrentCellRegion())
+        {
+            region->creaturesToMove[c] = CreatureMover(x,y,z,ang);
+            return;
+        }
+    }
+
+    RegionGuard guard(this);
     i_creaturesToMove[c] = CreatureMover(x,y,z,ang);
 }
 
@@ -872,6 +1006,8 @@ bool Map::UnloadGrid(const uint32 &x, const uint32 &y, bool unloadAll)
             MoveAllCreaturesInMoveList();
         }
 
+        m_pendingGridLoads.erase(grid->GetGridId());
+
         ObjectGridCleaner cleaner(*grid);
         cleaner.CleanN();
 
@@ -1050,6 +1186,16 @@ void Map::AddObjectToRemoveList(WorldObject *obj)
 
     obj->CleanupsBeforeDelete();                    // remove or simplify at least cross referenced links
 
+    if (m_regionUpdate)
+    {
+        if (MapCellRegion* region = GetCurrentCellRegion())
+        {
+            region->objectsToRemove.insert(obj);
+            return;
+        }
+    }
+
+    RegionGuard guard(this);
     i_objectsToRemove.insert(obj);
     //sLog.outDebug("Object (GUID: %u TypeId: %u) added to removing list.",obj->GetGUIDLow(),obj->GetTypeId());
 }
@@ -1058,6 +1204,16 @@ void Map::AddObjectToSwitchList(WorldObject *obj, bool on)
 {
     ASSERT(obj->GetMapId()==GetId() && obj->GetInstanceId()==GetInstanceId());
 
+    if (m_regionUpdate)
+    {
+        if (MapCellRegion* region = GetCurrentCellRegion())
+        {
+            region->objectsToSwitch.push_back(std::make_pair(obj, on));
+            return;
+        }
+    }
+
+    RegionGuard guard(this);
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -1184,6 +1340,7 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    RegionGuard guard(this);
     m_activeNonPlayers.insert(obj);
 
     // also not allow unloading spawn grid to prevent creating creature clone at load
@@ -1208,6 +1365,8 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    RegionGuard guard(this);
+
     // Map::Update for active object in proccess
     if (m_activeNonPlayersIter != m_activeNonPlayers.end())
     {
@@ -1253,6 +1412,8 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
     uint64 targetGUID = target ? target->GetGUID() : (uint64)0;
     uint64 ownerGUID  = (source->GetTypeId()==TYPEID_ITEM) ? ((Item*)source)->GetOwnerGUID() : (uint64)0;
 
+    RegionGuard guard(this);
+
     ///- Schedule script execution for all scripts in the script map
     ScriptMap const *s2 = &(s->second);
     bool immedScript = false;
@@ -1271,7 +1432,8 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
         sWorld.IncreaseScheduledScriptsCount();
     }
     ///- If one of the effects should be immediate, launch the script execution
-    if (/*start &&*/ immedScript && !i_scriptLock)
+    // (cell regions updated concurrently leave it for the ScriptsProcess call in Map::Update)
+    if (/*start &&*/ immedScript && !i_scriptLock && !m_regionUpdate)
     {
         i_scriptLock = true;
         ScriptsProcess();
@@ -1294,12 +1456,14 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGUID  = ownerGUID;
 
     sa.script = &script;
+
+    RegionGuard guard(this);
     m_scriptSchedule.insert(std::pair<time_t, ScriptAction>(time_t(sWorld.GetGameTime() + delay), sa));
 
     sWorld.IncreaseScheduledScriptsCount();
 
     ///- If effects should be immediate, launch the script execution
-    if (delay == 0 && !i_scriptLock)
+    if (delay == 0 && !i_scriptLock && !m_regionUpdate)
     {
         i_scriptLock = true;
         ScriptsProcess();
@@ -2602,6 +2766,8 @@ void BattleGroundMap::UnloadAll()
 
 Creature * Map::GetCreature(uint64 guid)
 {
+    RegionGuard guard(this);
+
     CreaturesMapType::const_iterator a = creaturesMap.find(guid);
 
     if (a != creaturesMap.cend())
@@ -2617,6 +2783,8 @@ Creature * Map::GetCreature(uint64 guid)
 
 Creature * Map::GetCreature(uint64 guid, float x, float y)
 {
+    RegionGuard guard(this);
+
     CreaturesMapType::const_iterator a = creaturesMap.find(guid);
 
     if (a != creaturesMap.cend())
@@ -2666,6 +2834,8 @@ Creature * Map::GetCreatureOrPet(uint64 guid)
 
 GameObject * Map::GetGameObject(uint64 guid)
 {
+    RegionGuard guard(this);
+
     GObjectMapType::const_iterator a = gameObjectsMap.find(guid);
 
     if (a != gameObjectsMap.cend())
@@ -2681,6 +2851,8 @@ GameObject * Map::GetGameObject(uint64 guid)
 
 DynamicObject * Map::GetDynamicObject(uint64 guid)
 {
+    RegionGuard guard(this);
+
     DObjectMapType::const_iterator a = dynamicObjectsMap.find(guid);
 
     if (a != dynamicObjectsMap.cend())
@@ -2777,6 +2949,8 @@ void Map::VisibilityOfCreatureEntry(uint32 entry, bool hide)
 
 std::list<uint64> Map::GetCreaturesGUIDList(uint32 id, GetCreatureGuidType type , uint32 max)
 {
+    RegionGuard guard(this);
+
     std::list<uint64> returnList;
     CreatureIdToGuidListMapType::const_iterator a = creatureIdToGuidMap.find(id);
     if (a != creatureIdToGuidMap.cend())
@@ -2835,6 +3009,8 @@ std::list<uint64> Map::GetCreaturesGUIDList(uint32 id, GetCreatureGuidType type
 
 uint64 Map::GetCreatureGUID(uint32 id, GetCreatureGuidType type)
 {
+    RegionGuard guard(this);
+
     uint64 returnGUID = 0;
 
     CreatureIdToGuidListMapType::const_iterator a = creatureIdToGuidMap.find(id);
@@ -2903,6 +3079,8 @@ void Map::RemoveFromCreatureGUIDList(Creature * obj)
 
 void Map::InsertIntoObjMap(Object * obj)
 {
+    RegionGuard guard(this);
+
     ObjectGuid guid(obj->GetGUID());
 
     switch (guid.GetHigh())
@@ -2956,6 +3134,8 @@ void Map::InsertIntoObjMap(Object * obj)
 
 void Map::RemoveFromObjMap(uint64 guid)
 {
+    RegionGuard guard(this);
+
     ObjectGuid objGuid(guid);
 
     switch (objGuid.GetHigh())
@@ -2989,6 +3169,8 @@ void Map::RemoveFromObjMap(uint64 guid)
 
 void Map::RemoveFromObjMap(Object * obj)
 {
+    RegionGuard guard(this);
+
     ObjectGuid objGuid(obj->GetGUID());
 
     switch (objGuid.GetHigh())
@@ -3126,6 +3308,27 @@ float Map::GetVisibilityDistance(WorldObject* obj, Player* invoker) const
     return dist;
 }
 
+static std::atomic<uint64> s_deferredRepaths(0);
+
+bool Map::TakeRepathBudget()
+{
+    uint32 budget = sWorld.getConfig(CONFIG_MMAP_REPATH_PER_UPDATE);
+    if (!budget)
+        return true;
+
+    // counted from region threads as well
+    if (m_repathCount.fetch_add(1, std::memory_order_relaxed) < budget)
+        return true;
+
+    s_deferredRepaths.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+uint64 Map::GetDeferredRepathCount()
+{
+    return s_deferredRepaths.load(std::memory_order_relaxed);
+}
+
 bool Map::WaypointMovementAutoActive() const
 {
     if(Instanceable())
@@ -3462,3 +3665,339 @@ bool Map::GetReachableRandomPosition(Unit* unit, float& x, float& y, float& z, f
 
     return false;
 }
+
+typedef ACE_TSS<ACE_TSS_Type_Adapter<MapCellRegion*> > MapCellRegionTSS;
+static MapCellRegionTSS currentCellRegion;
+
+MapCellRegion* Map::GetCurrentCellRegion()
+{
+    return *currentCellRegion;
+}
+
+// counts down helper jobs started by the map thread during its update
+struct MapUpdateBarrier
+{
+    explicit MapUpdateBarrier(uint32 count) : m_condition(m_mutex), m_pending(count) {}
+
+    void Done()
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+        --m_pending;
+        m_condition.signal();
+    }
+
+    void Wait()
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+        while (m_pending)
+            m_condition.wait();
+    }
+
+    ACE_Thread_Mutex m_mutex;
+    ACE_Condition_Thread_Mutex m_condition;
+    uint32 m_pending;
+};
+
+class MapCellRegionRequest : public ACE_Method_Request
+{
+    public:
+        MapCellRegionRequest(Map& map, MapCellRegion& region, uint32 diff, MapUpdateBarrier& barrier)
+            : m_map(map), m_region(region), m_diff(diff), m_barrier(barrier) {}
+
+        virtual int call(void)
+        {
+            m_map.UpdateCellRegion(m_region, m_diff);
+            m_barrier.Done();
+            return 0;
+        }
+
+    private:
+        Map& m_map;
+        MapCellRegion& m_region;
+        uint32 m_diff;
+        MapUpdateBarrier& m_barrier;
+};
+
+static bool CellRegionGreater(MapCellRegion const& a, MapCellRegion const& b)
+{
+    return a.cells.size() > b.cells.size();
+}
+
+void Map::UpdateCellRegions(const uint32 diff, std::vector<CellPair> const& cells)
+{
+    // cells of one grid always go to the same region, grids touching each other (also diagonally)
+    // as well, so two regions are separated by at least one whole grid which is not updated this tick.
+    // visibility and most of the interaction ranges are way shorter than grid size.
+    // movement generators of all regions search paths at once, each search borrows its own
+    // dtNavMeshQuery (MMAP::NavMeshQueryHolder), queries must never be shared between regions
+    typedef std::map<uint32, std::vector<CellPair> > GridCellsMap;
+    GridCellsMap gridCells;
+    for (std::vector<CellPair>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+    {
+        Cell cell(*itr);
+        gridCells[cell.GridX() * MAX_NUMBER_OF_GRIDS + cell.GridY()].push_back(*itr);
+    }
+
+    std::vector<MapCellRegion> regions;
+    std::set<uint32> assigned;
+    for (GridCellsMap::const_iterator itr = gridCells.begin(); itr != gridCells.end(); ++itr)
+    {
+        if (assigned.find(itr->first) != assigned.end())
+            continue;
+
+        regions.push_back(MapCellRegion());
+        MapCellRegion& region = regions.back();
+
+        std::vector<uint32> open;
+        open.push_back(itr->first);
+        assigned.insert(itr->first);
+        while (!open.empty())
+        {
+            uint32 gridId = open.back();
+            open.pop_back();
+
+            std::vector<CellPair> const& gridList = gridCells[gridId];
+            region.cells.insert(region.cells.end(), gridList.begin(), gridList.end());
+
+            int32 gx = gridId / MAX_NUMBER_OF_GRIDS;
+            int32 gy = gridId % MAX_NUMBER_OF_GRIDS;
+            for (int32 x = gx - 1; x <= gx + 1; ++x)
+            {
+                for (int32 y = gy - 1; y <= gy + 1; ++y)
+                {
+                    if (x < 0 || y < 0 || x >= MAX_NUMBER_OF_GRIDS || y >= MAX_NUMBER_OF_GRIDS)
+                        continue;
+
+                    uint32 neighbour = x * MAX_NUMBER_OF_GRIDS + y;
+                    if (gridCells.find(neighbour) == gridCells.end() || assigned.find(neighbour) != assigned.end())
+                        continue;
+
+                    assigned.insert(neighbour);
+                    open.push_back(neighbour);
+                }
+            }
+        }
+    }
+
+    if (regions.empty())
+        return;
+
+    if (regions.size() == 1)
+    {
+        UpdateCellRegion(regions.front(), diff);
+        return;
+    }
+
+    // biggest region stays on map thread, rest goes to region threads
+    std::sort(regions.begin(), regions.end(), CellRegionGreater);
+
+    MapUpdateBarrier barrier(regions.size() - 1);
+
+    m_regionUpdate = true;
+    for (uint32 i = 1; i < regions.size(); ++i)
+    {
+        if (sMapMgr.GetMapUpdater()->schedule_region_update(new MapCellRegionRequest(*this, regions[i], diff, barrier)) == -1)
+        {
+            UpdateCellRegion(regions[i], diff);
+            barrier.Done();
+        }
+    }
+
+    UpdateCellRegion(regions.front(), diff);
+    barrier.Wait();
+    m_regionUpdate = false;
+
+    for (std::vector<MapCellRegion>::iterator itr = regions.begin(); itr != regions.end(); ++itr)
+        MergeCellRegion(*itr);
+}
+
+void Map::UpdateCellRegion(MapCellRegion& region, const uint32 diff)
+{
+    uint32 alloweddiff = sWorld.getConfig(CONFIG_MIN_LOG_CELL);
+
+    Hellground::ObjectUpdater updater(diff);
+    TypeContainerVisitor<Hellground::ObjectUpdater, GridTypeMapContainer> grid_object_update(updater);
+    TypeContainerVisitor<Hellground::ObjectUpdater, WorldTypeMapContainer> world_object_update(updater);
+
+    *currentCellRegion = &region;
+
+    for (std::vector<CellPair>::const_iterator itr = region.cells.begin(); itr != region.cells.end(); ++itr)
+    {
+        uint32 startTime = WorldTimer::getMSTime();
+
+        Cell cell(*itr);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+
+        if (WorldTimer::getMSTimeDiffToNow(startTime) > alloweddiff)
+            sLog.outLog(LOG_DIFF, "Map::Update cell %u %u (%u ms) map %u", itr->x_coord, itr->y_coord, WorldTimer::getMSTimeDiffToNow(startTime), GetId());
+    }
+
+    *currentCellRegion = NULL;
+}
+
+void Map::MergeCellRegion(MapCellRegion& region)
+{
+    for (std::set<Object*>::const_iterator itr = region.removedUpdateObjects.begin(); itr != region.removedUpdateObjects.end(); ++itr)
+        i_objectsToClientUpdate.erase(*itr);
+
+    i_objectsToClientUpdate.insert(region.updateObjects.begin(), region.updateObjects.end());
+
+    for (CreatureMoveList::const_iterator itr = region.creaturesToMove.begin(); itr != region.creaturesToMove.end(); ++itr)
+        i_creaturesToMove[itr->first] = itr->second;
+
+    i_objectsToRemove.insert(region.objectsToRemove.begin(), region.objectsToRemove.end());
+
+    for (std::list<std::pair<WorldObject*, bool> >::const_iterator itr = region.objectsToSwitch.begin(); itr != region.objectsToSwitch.end(); ++itr)
+        AddObjectToSwitchList(itr->first, itr->second);
+}
+
+void Map::AddRegionUpdateObject(Object *obj)
+{
+    if (MapCellRegion* region = GetCurrentCellRegion())
+    {
+        region->removedUpdateObjects.erase(obj);
+        region->updateObjects.insert(obj);
+        return;
+    }
+
+    RegionGuard guard(this);
+    i_objectsToClientUpdate.insert(obj);
+}
+
+void Map::RemoveRegionUpdateObject(Object *obj)
+{
+    if (MapCellRegion* region = GetCurrentCellRegion())
+    {
+        region->updateObjects.erase(obj);
+        region->removedUpdateObjects.insert(obj);
+        return;
+    }
+
+    RegionGuard guard(this);
+    i_objectsToClientUpdate.erase(obj);
+}
+
+#define UPDATE_PACKET_CHUNK 4
+
+// packets of one BuildUpdatePackets, shared by calling thread and packet threads. Every thread claims
+// chunks until none is left, so calling thread waits only for chunks other threads are building right now.
+// Freed by the last thread releasing it, packet thread starting late finds nothing to do and does not hold calling thread
+struct UpdatePacketBuildState
+{
+    UpdatePacketBuildState(std::vector<UpdateData*> const& updates, std::vector<WorldPacket>& packets, uint32 references)
+        : m_updates(updates), m_packets(packets), m_count(updates.size()), m_nextJob(0), m_builtJobs(0), m_condition(m_mutex), m_references(references) {}
+
+    void Build()
+    {
+        for (;;)
+        {
+            uint32 begin = m_nextJob.fetch_add(UPDATE_PACKET_CHUNK);
+            if (begin >= m_count)
+                return;
+
+            uint32 end = std::min(begin + UPDATE_PACKET_CHUNK, m_count);
+            for (uint32 i = begin; i < end; ++i)
+            {
+                if (!m_updates[i]->BuildPacket(&m_packets[i]))
+                    m_packets[i].clear();
+            }
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+            m_builtJobs += end - begin;
+            if (m_builtJobs == m_count)
+                m_condition.signal();
+        }
+    }
+
+    void Wait()
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+        while (m_builtJobs < m_count)
+            m_condition.wait();
+    }
+
+    void Release()
+    {
+        if (m_references.fetch_sub(1) == 1)
+            delete this;
+    }
+
+    private:
+        // owned by calling thread, not touched once all jobs are claimed
+        std::vector<UpdateData*> const& m_updates;
+        std::vector<WorldPacket>& m_packets;
+
+        uint32 m_count;
+        std::atomic<uint32> m_nextJob;
+        uint32 m_builtJobs;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        std::atomic<uint32> m_references;
+};
+
+class UpdatePacketBuildRequest : public ACE_Method_Request
+{
+    public:
+        explicit UpdatePacketBuildRequest(UpdatePacketBuildState* state) : m_state(state) {}
+
+        virtual int call(void)
+        {
+            m_state->Build();
+            m_state->Release();
+            return 0;
+        }
+
+    private:
+        UpdatePacketBuildState* m_state;
+};
+
+uint32 Map::BuildUpdatePackets(std::vector<UpdateData*> const& updates, std::vector<WorldPacket>& packets, uint32 helpers)
+{
+    // packet building and zlib compression only touch given UpdateData and its packet
+    packets.resize(updates.size());
+    uint32 count = updates.size();
+    helpers = count > UPDATE_PACKET_CHUNK ? std::min(helpers, (count - 1) / UPDATE_PACKET_CHUNK) : 0;
+
+    UpdatePacketBuildState* state = new UpdatePacketBuildState(updates, packets, helpers + 1);
+    for (uint32 i = 0; i < helpers; ++i)
+    {
+        if (sMapMgr.GetMapUpdater()->schedule_packet_build(new UpdatePacketBuildRequest(state)) == -1)
+            state->Release();
+    }
+
+    state->Build();
+    state->Wait();
+    state->Release();
+    return helpers;
+}
+
+static void SendObjectUpdatesConcurrently(uint32 mapId, UpdateDataMapType& update_players)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    // packets are built on packet threads and this one, sending stays on map thread
+    uint32 count = update_players.size();
+    std::vector<Player*> players;
+    std::vector<UpdateData*> updates;
+    players.reserve(count);
+    updates.reserve(count);
+    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    {
+        players.push_back(iter->first);
+        updates.push_back(&iter->second);
+    }
+
+    std::vector<WorldPacket> packets;
+    uint32 helpers = Map::BuildUpdatePackets(updates, packets, sWorld.getConfig(CONFIG_MAPUPDATE_PACKET_THREADS));
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (!packets[i].empty())
+            players[i]->SendPacketToSelf(&packets[i]);
+    }
+
+    if (WorldTimer::getMSTimeDiffToNow(startTime) > sWorld.getConfig(CONFIG_MIN_LOG_UPDATE))
+        sLog.outLog(LOG_DIFF, "Map::SendObjectUpdates %u players with %u packet threads (%u ms) map %u", count, helpers, WorldTimer::getMSTimeDiffToNow(startTime), mapId);
+}
@@ -24,6 +24,7 @@
 #include "Platform/Define.h"
 #include "ace/RW_Thread_Mutex.h"
 #include "ace/Thread_Mutex.h"
+#include "ace/Recursive_Thread_Mutex.h"
 
 #include "DBCStructure.h"
 #include "GridDefines.h"
@@ -35,12 +36,15 @@
 #include "MapRefManager.h"
 #include "mersennetwister/MersenneTwister.h"
 
+#include <atomic>
 #include <bitset>
 #include <list>
+#include <map>
 
 class Unit;
 class Creature;
 class WorldPacket;
+class UpdateData;
 class InstanceData;
 class Group;
 class InstanceSave;
@@ -117,6 +121,19 @@ enum GetCreatureGuidType
 
 typedef std::list<std::pair<Map*, uint32> > DelayedMapList;
 
+// group of grids updated by one thread when continent cells are updated concurrently,
+// map state touched by object updates is buffered here and merged back on the map thread
+struct MapCellRegion
+{
+    std::vector<CellPair> cells;
+
+    std::set<Object*> updateObjects;
+    std::set<Object*> removedUpdateObjects;
+    CreatureMoveList creaturesToMove;
+    std::set<WorldObject*> objectsToRemove;
+    std::list<std::pair<WorldObject*, bool> > objectsToSwitch;
+};
+
 class HELLGROUND_IMPORT_EXPORT Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
@@ -220,6 +237,9 @@ class HELLGROUND_IMPORT_EXPORT Map : public GridRefManager<NGridType>
         void AddObjectToRemoveList(WorldObject *obj);
         void AddObjectToSwitchList(WorldObject *obj, bool on);
 
+        // runs on region update thread, see Map::UpdateCellRegions
+        void UpdateCellRegion(MapCellRegion& region, const uint32 diff);
+
         void resetMarkedCells() { marked_cells.reset(); }
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
@@ -259,12 +279,18 @@ class HELLGROUND_IMPORT_EXPORT Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object *obj)
         {
-            i_objectsToClientUpdate.insert(obj);
+            if (m_regionUpdate)
+                AddRegionUpdateObject(obj);
+            else
+                i_objectsToClientUpdate.insert(obj);
         }
 
         void RemoveUpdateObject(Object *obj)
         {
-            i_objectsToClientUpdate.erase(obj);
+            if (m_regionUpdate)
+                RemoveRegionUpdateObject(obj);
+            else
+                i_objectsToClientUpdate.erase(obj);
         }
 
         // map restarting system
@@ -288,6 +314,14 @@ class HELLGROUND_IMPORT_EXPORT Map : public GridRefManager<NGridType>
         bool WaypointMovementAutoActive() const;
         bool WaypointMovementPathfinding() const;
 
+        // path searches left for this update, units already moving on a path wait for next one
+        bool TakeRepathBudget();
+        static uint64 GetDeferredRepathCount();
+
+        // builds packet of every update on this thread and up to helpers packet threads,
+        // packet is left empty when there is nothing to send. Returns number of packet threads asked to help
+        static uint32 BuildUpdatePackets(std::vector<UpdateData*> const& updates, std::vector<WorldPacket>& packets, uint32 helpers);
+
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         NGridType* getNGrid(uint32 x, uint32 y) const
         {
@@ -317,6 +351,9 @@ class HELLGROUND_IMPORT_EXPORT Map : public GridRefManager<NGridType>
         bool loaded(const GridPair &) const;
         void EnsureGridCreated(const GridPair &);
         void EnsureGridLoaded(Cell const&);
+        void PrefetchGrids(CellArea const& area);
+        void PreloadGridAhead(Player* player, uint32 lookAhead);
+        void LoadPreloadedGrids(uint32 cellBudget);
 
         void buildNGridLinkage(NGridType* pNGridType) { pNGridType->link(this); }
 
@@ -328,6 +365,42 @@ class HELLGROUND_IMPORT_EXPORT Map : public GridRefManager<NGridType>
         void CheckHostileRefFor(Player*);
         void SendObjectUpdates();
 
+        void UpdateCellRegions(const uint32 diff, std::vector<CellPair> const& cells);
+        void MergeCellRegion(MapCellRegion& region);
+        static MapCellRegion* GetCurrentCellRegion();
+
+        void AddRegionUpdateObject(Object *obj);
+        void RemoveRegionUpdateObject(Object *obj);
+
+        // locks containers shared by all cells only while cell regions are updated concurrently
+        class RegionGuard
+        {
+            public:
+                explicit RegionGuard(Map const* map) : m_lock(map->m_regionUpdate ? &map->m_regionLock : NULL)
+                {
+                    if (m_lock)
+                        m_lock->acquire();
+                }
+
+                ~RegionGuard()
+                {
+                    if (m_lock)
+                        m_lock->release();
+                }
+
+            private:
+                ACE_Recursive_Thread_Mutex* m_lock;
+        };
+
+        bool m_regionUpdate;
+        mutable ACE_Recursive_Thread_Mutex m_regionLock;
+
+        std::atomic<uint32> m_repathCount;
+
+        // grids created ahead of players, maps grid id to index of first cell with objects not loaded yet
+        typedef std::map<uint32, uint32> PendingGridLoads;
+        PendingGridLoads m_pendingGridLoads;
+
         typedef std::set<Object*> ObjectSet;
         ObjectSet i_objectsToClientUpdate;
 
@@ -62,6 +62,18 @@ void MapManager::Initialize()
         sLog.outLog(LOG_DEFAULT, "ERROR: MapUpdater cannot be activated !!!!!");
         abort();
     }
+
+    if (uint32 region_threads = sWorld.getConfig(CONFIG_MAPUPDATE_REGION_THREADS))
+    {
+        if (m_updater.activate_regions(region_threads) == -1)
+            sLog.outLog(LOG_DEFAULT, "ERROR: MapUpdater region threads cannot be activated, continents will be updated by single thread");
+    }
+
+    if (uint32 packet_threads = sWorld.getConfig(CONFIG_MAPUPDATE_PACKET_THREADS))
+    {
+        if (m_updater.activate_packets(packet_threads) == -1)
+            sLog.outLog(LOG_DEFAULT, "ERROR: MapUpdater packet threads cannot be activated, update packets will be built by map threads");
+    }
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -218,6 +230,7 @@ void MapManager::DeleteInstance(uint32 mapid, uint32 instanceId)
         if (pMap->Instanceable())
         {
             i_maps.erase(iter);
+            m_updater.forget_cost(mapid, instanceId);
 
             pMap->UnloadAll();
             delete pMap;
@@ -234,6 +247,7 @@ void MapManager::Update(uint32 diff)
     {
         if (iter->second->CanUnload(diff))
         {
+            m_updater.forget_cost(iter->first.nMapId, iter->first.nInstanceId);
             iter->second->UnloadAll();
             delete iter->second;
 
@@ -64,18 +64,23 @@ class MapUpdateRequest : public ACE_Method_Request
         MapUpdater& m_updater;
         ACE_UINT32 m_diff;
 
-        MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d) : m_map(m), m_updater(u), m_diff(d) {}
+        MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d, unsigned long cost) : ACE_Method_Request(cost), m_map(m), m_updater(u), m_diff(d) {}
 
         virtual int call(void)
         {
             m_updater.register_thread(ACE_OS::thr_self(), m_map.GetId(), m_map.GetInstanceId());
 
+            ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
             if (!m_map.IsBroken())
                 m_map.Update(m_diff);
             else
                 m_map.ForcedUnload();
 
+            ACE_Time_Value updateTime = ACE_OS::gettimeofday() - startTime;
+
             m_updater.unregister_thread(ACE_OS::thr_self());
+            m_updater.update_cost(m_map.GetId(), m_map.GetInstanceId(), uint32(updateTime.sec() * 1000000 + updateTime.usec()));
             m_updater.update_finished(m_map.GetId());
             return 0;
         }
@@ -100,13 +105,63 @@ int MapUpdater::deactivate(void)
 {
     this->wait();
 
+    if (this->m_regionExecutor.activated())
+        this->m_regionExecutor.deactivate();
+
+    if (this->m_packetExecutor.activated())
+        this->m_packetExecutor.deactivate();
+
     return this->m_executor.deactivate();
 }
 
+int MapUpdater::activate_regions(size_t num_threads)
+{
+    return this->m_regionExecutor.activate(static_cast<int>(num_threads), new WDBThreadStartReq1, new WDBThreadEndReq1);
+}
+
+int MapUpdater::schedule_region_update(ACE_Method_Request* request)
+{
+    if (!this->m_regionExecutor.activated())
+    {
+        delete request;
+        return -1;
+    }
+
+    return this->m_regionExecutor.execute(request);
+}
+
+bool MapUpdater::region_activated()
+{
+    return m_regionExecutor.activated();
+}
+
+int MapUpdater::activate_packets(size_t num_threads)
+{
+    return this->m_packetExecutor.activate(static_cast<int>(num_threads));
+}
+
+int MapUpdater::schedule_packet_build(ACE_Method_Request* request)
+{
+    if (!this->m_packetExecutor.activated())
+    {
+        delete request;
+        return -1;
+    }
+
+    return this->m_packetExecutor.execute(request);
+}
+
+bool MapUpdater::packet_activated()
+{
+    return m_packetExecutor.activated();
+}
+
 int MapUpdater::wait()
 {
     ACE_GUARD_RETURN(ACE_Thread_Mutex,guard,this->m_mutex,-1);
 
+    dispatch_scheduled();
+
     while (this->pending_requests > 0)
         this->m_condition.wait();
 
@@ -119,17 +174,101 @@ int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
 
     ++this->pending_requests;
 
-    if (this->m_executor.execute(new MapUpdateRequest(map,*this,diff)) == -1)
+    // without cost history dispatch immediately, in schedule order
+    if (!sWorld.getConfig(CONFIG_MAPUPDATE_COST_SAMPLES))
     {
-        ACE_DEBUG((LM_ERROR, ACE_TEXT ("(%t) \n"), ACE_TEXT ("Failed to schedule Map Update")));
+        if (this->m_executor.execute(new MapUpdateRequest(map,*this,diff,0)) == -1)
+        {
+            ACE_DEBUG((LM_ERROR, ACE_TEXT ("(%t) \n"), ACE_TEXT ("Failed to schedule Map Update")));
 
-        --this->pending_requests;
-        return -1;
+            --this->pending_requests;
+            return -1;
+        }
+
+        return 0;
     }
 
+    m_scheduled.push_back(new MapUpdateRequest(map, *this, diff, predicted_cost(map.GetId(), map.GetInstanceId())));
     return 0;
 }
 
+struct MapUpdateRequestCostOrder
+{
+    bool operator()(MapUpdateRequest const* a, MapUpdateRequest const* b) const
+    {
+        return a->priority() > b->priority();
+    }
+};
+
+// must be called with m_mutex held
+int MapUpdater::dispatch_scheduled()
+{
+    if (m_scheduled.empty())
+        return 0;
+
+    // most expensive maps go first, cheap ones fill the gaps on whichever worker gets idle first.
+    // activation queue is priority ordered as well, so requests enqueued while workers are
+    // already busy keep the same order
+    std::stable_sort(m_scheduled.begin(), m_scheduled.end(), MapUpdateRequestCostOrder());
+
+    int result = 0;
+    for (MapUpdateRequestList::iterator itr = m_scheduled.begin(); itr != m_scheduled.end(); ++itr)
+    {
+        if (this->m_executor.execute(*itr) == -1)
+        {
+            ACE_DEBUG((LM_ERROR, ACE_TEXT ("(%t) \n"), ACE_TEXT ("Failed to schedule Map Update")));
+
+            --this->pending_requests;
+            result = -1;
+        }
+    }
+
+    m_scheduled.clear();
+    return result;
+}
+
+uint32 MapUpdater::predicted_cost(uint32 mapId, uint32 instanceId) const
+{
+    MapCostMap::const_iterator itr = m_costs.find(MapCostKey(mapId, instanceId));
+    if (itr == m_costs.end())
+        return 0;
+
+    return itr->second.avgTime;
+}
+
+void MapUpdater::update_cost(uint32 mapId, uint32 instanceId, uint32 costUs)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    uint32 samples = sWorld.getConfig(CONFIG_MAPUPDATE_COST_SAMPLES);
+    if (!samples)
+        samples = 1;
+
+    MapUpdateCost& cost = m_costs[MapCostKey(mapId, instanceId)];
+
+    // exponential moving average over ~samples updates, first sample seeds it
+    if (!cost.updates)
+        cost.avgTime = costUs;
+    else
+        cost.avgTime = uint32((uint64(cost.avgTime) * (samples - 1) + costUs) / samples);
+
+    cost.lastTime = costUs;
+    cost.maxTime = std::max(cost.maxTime, costUs);
+    ++cost.updates;
+}
+
+void MapUpdater::forget_cost(uint32 mapId, uint32 instanceId)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+    m_costs.erase(MapCostKey(mapId, instanceId));
+}
+
+MapCostMap MapUpdater::GetMapCosts()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, MapCostMap());
+    return m_costs;
+}
+
 bool MapUpdater::activated()
 {
     return m_executor.activated();
@@ -45,6 +45,22 @@ struct MapUpdateInfo
 
 typedef std::map<ACE_thread_t const, MapUpdateInfo> ThreadMapMap;
 
+struct MapUpdateCost
+{
+    MapUpdateCost() : avgTime(0), lastTime(0), maxTime(0), updates(0) {}
+
+    uint32 avgTime;                                         // moving average of Map::Update duration in microseconds
+    uint32 lastTime;
+    uint32 maxTime;
+    uint32 updates;
+};
+
+typedef std::pair<uint32, uint32> MapCostKey;               // map id, instance id
+typedef std::map<MapCostKey, MapUpdateCost> MapCostMap;
+
+class MapUpdateRequest;
+typedef std::vector<MapUpdateRequest*> MapUpdateRequestList;
+
 class MapUpdater
 {
     public:
@@ -53,12 +69,12 @@ class MapUpdater
 
         friend class MapUpdateRequest;
 
-        /// schedule update on a map, the update will start
-        /// as soon as possible,
-        /// it may even start before the call returns
+        /// schedule update on a map, the update is queued
+        /// and dispatched on the next wait() call,
+        /// most expensive maps (by predicted cost) first
         int schedule_update(Map& map, ACE_UINT32 diff);
 
-        /// Wait until all pending updates finish
+        /// Dispatch scheduled updates and wait until all pending updates finish
         int wait();
 
         /// Start the worker threads
@@ -68,7 +84,26 @@ class MapUpdater
         int deactivate(void);
 
         bool activated();
+
+        /// Start the threads updating continent cell regions, see Map::UpdateCellRegions
+        int activate_regions(size_t num_threads);
+
+        /// Queue region update, returns -1 when region threads are not running
+        int schedule_region_update(ACE_Method_Request* request);
+
+        bool region_activated();
+
+        /// Start the threads building and compressing SMSG_UPDATE_OBJECT packets, see Map::SendObjectUpdates
+        int activate_packets(size_t num_threads);
+
+        /// Queue packet build, returns -1 when packet threads are not running
+        int schedule_packet_build(ACE_Method_Request* request);
+
+        bool packet_activated();
+
         void update_finished(uint32 map);
+        void update_cost(uint32 mapId, uint32 instanceId, uint32 costUs);
+        void forget_cost(uint32 mapId, uint32 instanceId);
 
         void register_thread(ACE_thread_t const threadId, uint32 mapId, uint32 instanceId);
         void unregister_thread(ACE_thread_t const threadId);
@@ -78,12 +113,23 @@ class MapUpdater
         MapUpdateInfo const* GetMapUpdateInfo(ACE_thread_t const threadId);
 
         uint32 GetLastMapId() { return lastMapId; };
+
+        // copy of the cost history, safe to use outside of the updater lock
+        MapCostMap GetMapCosts();
+
     private:
+        int dispatch_scheduled();
+        uint32 predicted_cost(uint32 mapId, uint32 instanceId) const;
+
         ThreadMapMap m_threads;
+        MapCostMap m_costs;
+        MapUpdateRequestList m_scheduled;
 
         uint32 freezeDetectTime;
         uint32 lastMapId;
         DelayExecutor m_executor;
+        DelayExecutor m_regionExecutor;
+        DelayExecutor m_packetExecutor;
         ACE_Condition_Thread_Mutex m_condition;
         ACE_Thread_Mutex m_mutex;
         size_t pending_requests;
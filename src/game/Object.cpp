@@ -51,6 +51,11 @@
 
 #include "movement/packet_builder.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OBJECT_SSE2
+#endif
+
 uint32 GuidHigh2TypeId(uint32 guid_hi)
 {
     switch (guid_hi)
@@ -203,22 +208,109 @@ void Object::SendCreateUpdateToPlayer(Player* player)
     player->SendPacketToSelf(&packet);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) const
+void Object::_BuildValuesUpdateBlock(ByteBuffer &buf, UpdateMask *updateMask, Player *target) const
 {
-    ByteBuffer buf(500);
-
     buf << uint8(UPDATETYPE_VALUES);
     //buf.append(GetPackGUID());    //client crashes when using this. but not have crash in debug mode
     buf << uint8(0xFF);
     buf << GetGUID();
 
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, updateMask, target);
+}
+
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) const
+{
+    ByteBuffer buf(500);
+
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
 
     _SetUpdateBits(&updateMask, target);
-    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    _BuildValuesUpdateBlock(buf, &updateMask, target);
+
+    data->AddUpdateBlock(buf);
+}
+
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target, UpdateValuesCache &cache) const
+{
+    if (!cache.changed.GetCount())
+    {
+        cache.changed.SetCount(m_valuesCount);
+        _SetChangedBits(&cache.changed);
+    }
+
+    uint32 viewer = GetUpdateViewerClass(cache.changed, target);
+    if (viewer != UPDATE_VIEWER_UNIQUE)
+    {
+        for (std::vector<std::pair<uint32, ByteBuffer> >::const_iterator itr = cache.blocks.begin(); itr != cache.blocks.end(); ++itr)
+        {
+            if (itr->first == viewer)
+            {
+                data->AddUpdateBlock(itr->second);
+                return;
+            }
+        }
+    }
+
+    ByteBuffer buf(500);
+
+    UpdateMask updateMask(cache.changed);
+    _FilterUpdateBits(&updateMask, target);
+    _BuildValuesUpdateBlock(buf, &updateMask, target);
 
     data->AddUpdateBlock(buf);
+
+    if (viewer != UPDATE_VIEWER_UNIQUE)
+        cache.blocks.push_back(std::make_pair(viewer, buf));
+}
+
+// every target dependent branch of BuildValuesUpdate must be covered here,
+// otherwise viewers would get blocks built for someone else
+uint32 Object::GetUpdateViewerClass(UpdateMask &changed, Player *target) const
+{
+    uint32 viewer = UPDATE_VIEWER_OTHER;
+    if (target == this)
+        viewer |= UPDATE_VIEWER_SELF;
+
+    if (isType(TYPEMASK_UNIT))
+    {
+        Unit const* unit = (Unit const*)this;
+
+        if (changed.GetBit(UNIT_FIELD_FLAGS) && target->IsGameMaster())
+            viewer |= UPDATE_VIEWER_GM;
+
+        if ((changed.GetBit(UNIT_FIELD_HEALTH) || changed.GetBit(UNIT_FIELD_MAXHEALTH)) &&
+            (target->IsInRaidWith(unit) || target->IsInPartyWith(unit)))
+            viewer |= UPDATE_VIEWER_GROUP;
+
+        if (GetTypeId() == TYPEID_UNIT)
+        {
+            if (changed.GetBit(UNIT_FIELD_DISPLAYID) && target->isGMTriggersVisible())
+                viewer |= UPDATE_VIEWER_GM_TRIGGERS;
+
+            if (changed.GetBit(UNIT_DYNAMIC_FLAGS) && target->isAllowedToLoot((Creature*)this))
+                viewer |= UPDATE_VIEWER_LOOTER;
+        }
+        else if (GetTypeId() == TYPEID_PLAYER && target != this)
+        {
+            Player const* player = (Player const*)this;
+            if (target->IsInSameGroupWith(player) || target->IsInSameRaidWith(player))
+            {
+                // hostile group members get their own faction sent
+                if (changed.GetBit(UNIT_FIELD_FACTIONTEMPLATE))
+                    return UPDATE_VIEWER_UNIQUE;
+
+                viewer |= UPDATE_VIEWER_GROUP_FIX;
+            }
+        }
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
+    {
+        if (((GameObject*)this)->ActivateToQuest(target) || target->IsGameMaster())
+            viewer |= UPDATE_VIEWER_QUEST;
+    }
+
+    return viewer;
 }
 
 void Object::BuildFieldsUpdate(Player *pl, UpdateDataMapType &data_map) const
@@ -233,6 +325,18 @@ void Object::BuildFieldsUpdate(Player *pl, UpdateDataMapType &data_map) const
     BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
+void Object::BuildFieldsUpdate(Player *pl, UpdateDataMapType &data_map, UpdateValuesCache &cache) const
+{
+    UpdateDataMapType::iterator iter = data_map.find(pl);
+    if (iter == data_map.end())
+    {
+        std::pair<UpdateDataMapType::iterator, bool> p = data_map.insert(UpdateDataMapType::value_type(pl, UpdateData()));
+        ASSERT(p.second);
+        iter = p.first;
+    }
+    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, cache);
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData * data) const
 {
     data->AddOutOfRangeGUID(GetGUID());
@@ -575,11 +679,7 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer * data, UpdateMask *
 
 void Object::ClearUpdateMask(bool remove)
 {
-    for (uint16 index = 0; index < m_valuesCount; index ++)
-    {
-        if (m_uint32Values_mirror[index]!= m_uint32Values[index])
-            m_uint32Values_mirror[index] = m_uint32Values[index];
-    }
+    memcpy(m_uint32Values_mirror, m_uint32Values, m_valuesCount*sizeof(uint32));
     if (m_objectUpdated)
     {
         if (remove)
@@ -607,9 +707,30 @@ bool Object::LoadValues(const char* data)
     return true;
 }
 
-void Object::_SetUpdateBits(UpdateMask *updateMask, Player* /*target*/) const
+void Object::_SetUpdateBits(UpdateMask *updateMask, Player *target) const
+{
+    _SetChangedBits(updateMask);
+    _FilterUpdateBits(updateMask, target);
+}
+
+void Object::_SetChangedBits(UpdateMask *updateMask) const
 {
-    for (uint16 index = 0; index < m_valuesCount; index ++)
+    uint16 index = 0;
+
+#ifdef OBJECT_SSE2
+    // 4 fields per compare, index stays a multiple of 4 so the result is one nibble of the mask
+    uint8* mask = updateMask->GetMask();
+    for (; index + 4 <= m_valuesCount; index += 4)
+    {
+        __m128i values = _mm_loadu_si128((__m128i const*)(m_uint32Values + index));
+        __m128i mirror = _mm_loadu_si128((__m128i const*)(m_uint32Values_mirror + index));
+        int same = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, mirror)));
+        if (same != 0xF)
+            mask[index >> 3] |= uint8((~same & 0xF) << (index & 0x4));
+    }
+#endif
+
+    for (; index < m_valuesCount; index ++)
     {
         if (m_uint32Values_mirror[index]!= m_uint32Values[index])
             updateMask->SetBit(index);
@@ -1202,29 +1323,99 @@ bool WorldObject::IsWithinLOS(const float ox, const float oy, const float oz) co
     VMAP::IVMapManager *vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
     bool result = vMapManager->isInLineOfSight(GetMapId(), x, y, z +2.0f, ox, oy, oz +2.0f);
     
+    if (result) // if not result then no reason to check
+        return IsWithinGroundLOS(ox, oy, oz);
+
+    return result;
+}
 
+bool WorldObject::IsWithinGroundLOS(const float ox, const float oy, const float oz) const
+{
     uint8 prec = sWorld.getConfig(CONFIG_VMAP_GROUND);
-    if (prec && result) // if not result then no reason to check
-    {
-        const TerrainInfo* ti = GetTerrain();
-        if (!ti)
-            return true;
-        float beginh = ti->GetHeight(x, y, z, false);
-        if (beginh == VMAP_INVALID_HEIGHT_VALUE)
-            return true;
-        float endh = ti->GetHeight(ox, oy, oz, false);
-        if (endh == VMAP_INVALID_HEIGHT_VALUE)
-            return true;
-
-        float tolerance = sWorld.getConfig(CONFIG_VMAP_GROUND_TOLERANCE);
-        for (uint8 i = 1; i < prec; i++)
-        {
-            float height = ti->GetHeight(x + (i*(ox - x)) / prec, y + (i*(ox - y)) / prec, std::max(z, oz), false);
-            if (height == VMAP_INVALID_HEIGHT_VALUE || height > tolerance + z + (i*(oz - z)) / prec)
-                return false;
-        }
+    if (!prec)
+        return true;
+
+    float x,y,z;
+    GetPosition(x,y,z);
+
+    const TerrainInfo* ti = GetTerrain();
+    if (!ti)
+        return true;
+
+    // begin, end and prec - 1 samples between them in one terrain batch
+    TerrainPoint points[256];
+    points[0].x = x;
+    points[0].y = y;
+    points[0].z = z;
+    points[1].x = ox;
+    points[1].y = oy;
+    points[1].z = oz;
+    for (uint8 i = 1; i < prec; i++)
+    {
+        points[i + 1].x = x + (i*(ox - x)) / prec;
+        points[i + 1].y = y + (i*(ox - y)) / prec;
+        points[i + 1].z = std::max(z, oz);
+    }
+
+    ti->GetHeights(points, prec + 1, TERRAIN_QUERY_HEIGHT, false);
+
+    if (points[0].height == VMAP_INVALID_HEIGHT_VALUE)
+        return true;
+    if (points[1].height == VMAP_INVALID_HEIGHT_VALUE)
+        return true;
+
+    float tolerance = sWorld.getConfig(CONFIG_VMAP_GROUND_TOLERANCE);
+    for (uint8 i = 1; i < prec; i++)
+    {
+        float height = points[i + 1].height;
+        if (height == VMAP_INVALID_HEIGHT_VALUE || height > tolerance + z + (i*(oz - z)) / prec)
+            return false;
+    }
+    return true;
+}
+
+void WorldObject::FilterWithinLOSInMap(std::list<Unit*>& targets) const
+{
+    for (std::list<Unit*>::iterator itr = targets.begin(); itr != targets.end();)
+    {
+        if (!IsInMap(*itr))
+            itr = targets.erase(itr);
+        else
+            ++itr;
+    }
+
+    if (targets.empty() || !GetTerrain()->IsLineOfSightEnabled())
+        return;
+
+    float x,y,z;
+    GetPosition(x,y,z);
+
+    std::vector<VMAP::LoSRequest> requests(targets.size());
+    uint32 i = 0;
+    for (std::list<Unit*>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr, ++i)
+    {
+        VMAP::LoSRequest& req = requests[i];
+        req.mapId = GetMapId();
+        req.x1 = x;
+        req.y1 = y;
+        req.z1 = z + 2.0f;
+        req.x2 = (*itr)->GetPositionX();
+        req.y2 = (*itr)->GetPositionY();
+        req.z2 = (*itr)->GetPositionZ() + 2.0f;
+        req.alsom2 = false;
+        req.result = true;
+    }
+
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSightBatch(&requests[0], uint32(requests.size()));
+
+    i = 0;
+    for (std::list<Unit*>::iterator itr = targets.begin(); itr != targets.end(); ++i)
+    {
+        if (!requests[i].result || !IsWithinGroundLOS(requests[i].x2, requests[i].y2, requests[i].z2 - 2.0f))
+            itr = targets.erase(itr);
+        else
+            ++itr;
     }
-    return result;
 }
 
 bool WorldObject::IsInRange(WorldObject const* obj, float minRange, float maxRange, bool is3D /* = true */) const
@@ -1600,8 +1791,8 @@ Pet* Player::SummonPet(uint32 entry, float x, float y, float z, float ang, PetTy
     if (petType == SUMMON_PET && pet->LoadPetFromDB(this, entry, 0, false, x, y, z, ang))
     {
         // Remove Demonic Sacrifice auras (known pet)
-        Unit::AuraList const& auraClassScripts = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-        for (Unit::AuraList::const_iterator itr = auraClassScripts.begin();itr!=auraClassScripts.end();)
+        Unit::AuraTypeList const& auraClassScripts = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+        for (Unit::AuraTypeList::const_iterator itr = auraClassScripts.begin();itr!=auraClassScripts.end();)
         {
             if ((*itr)->GetModifier()->m_miscvalue==2228)
             {
@@ -1699,8 +1890,8 @@ Pet* Player::SummonPet(uint32 entry, float x, float y, float z, float ang, PetTy
     if (petType == SUMMON_PET)
     {
         // Remove Demonic Sacrifice auras (known pet)
-        Unit::AuraList const& auraClassScripts = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-        for (Unit::AuraList::const_iterator itr = auraClassScripts.begin();itr!=auraClassScripts.end();)
+        Unit::AuraTypeList const& auraClassScripts = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+        for (Unit::AuraTypeList::const_iterator itr = auraClassScripts.begin();itr!=auraClassScripts.end();)
         {
             if ((*itr)->GetModifier()->m_miscvalue==2228)
             {
@@ -1827,12 +2018,12 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType &i_updateDatas;
     WorldObject &i_object;
-    std::set<uint64> plr_list;
+    UpdateValuesCache i_cache;
 
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj)
     {
         if (i_object.isType(TYPEMASK_PLAYER))
-            i_object.BuildFieldsUpdate(i_object.ToPlayer(), i_updateDatas);
+            i_object.BuildFieldsUpdate(i_object.ToPlayer(), i_updateDatas, i_cache);
     }
 
     void Visit(CameraMapType &m)
@@ -1841,7 +2032,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
-                i_object.BuildFieldsUpdate(owner, i_updateDatas);
+                i_object.BuildFieldsUpdate(owner, i_updateDatas, i_cache);
         }
     }
 
@@ -25,6 +25,7 @@
 #include "ByteBuffer.h"
 #include "UpdateFields.h"
 #include "UpdateData.h"
+#include "UpdateMask.h"
 #include "Camera.h"
 #include "ObjectGuid.h"
 #include "GridDefines.h"
@@ -83,6 +84,29 @@ class TerrainInfo;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
+// what makes values update of one object differ between viewers,
+// only set for fields that actually changed
+enum UpdateViewerClass
+{
+    UPDATE_VIEWER_OTHER         = 0x00,
+    UPDATE_VIEWER_SELF          = 0x01,                     // player receiving own fields
+    UPDATE_VIEWER_GROUP         = 0x02,                     // party or raid member, real health values
+    UPDATE_VIEWER_GROUP_FIX     = 0x04,                     // same group player, blue group flag fix
+    UPDATE_VIEWER_GM            = 0x08,
+    UPDATE_VIEWER_GM_TRIGGERS   = 0x10,
+    UPDATE_VIEWER_LOOTER        = 0x20,
+    UPDATE_VIEWER_QUEST         = 0x40,                     // gameobject activated for viewer quests
+    UPDATE_VIEWER_UNIQUE        = 0xFFFFFFFF                // block contains viewer own data, never shared
+};
+
+// Values update blocks of one object built during one BuildUpdate call.
+// Changed fields are found once, viewers of the same class get the same bytes.
+struct UpdateValuesCache
+{
+    UpdateMask changed;
+    std::vector<std::pair<uint32, ByteBuffer> > blocks;
+};
+
 struct Position
 {
     Position() : x(0.0f), y(0.0f), z(0.0f), o(0.0f) {}
@@ -166,6 +190,7 @@ class HELLGROUND_IMPORT_EXPORT Object
         void SendCreateUpdateToPlayer(Player* player);
 
         void BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData *data, Player *target, UpdateValuesCache &cache) const;
         void BuildOutOfRangeUpdateBlock(UpdateData *data) const;
 
         virtual void DestroyForPlayer(Player *target) const;
@@ -316,6 +341,7 @@ class HELLGROUND_IMPORT_EXPORT Object
 
         virtual void BuildUpdate(UpdateDataMapType&) {}
         void BuildFieldsUpdate(Player *, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player *, UpdateDataMapType &, UpdateValuesCache &) const;
 
         virtual void AddToClientUpdateList() =0;
         virtual void RemoveFromClientUpdateList() =0;
@@ -330,7 +356,12 @@ class HELLGROUND_IMPORT_EXPORT Object
         void _InitValues();
         void _Create (uint32 guidlow, uint32 entry, HighGuid guidhigh);
 
-        virtual void _SetUpdateBits(UpdateMask *updateMask, Player *target) const;
+        void _SetUpdateBits(UpdateMask *updateMask, Player *target) const;
+        void _SetChangedBits(UpdateMask *updateMask) const;
+        // drops fields target is not allowed to see
+        virtual void _FilterUpdateBits(UpdateMask * /*updateMask*/, Player * /*target*/) const {}
+        uint32 GetUpdateViewerClass(UpdateMask &changed, Player *target) const;
+        void _BuildValuesUpdateBlock(ByteBuffer &buf, UpdateMask *updateMask, Player *target) const;
 
         virtual void _SetCreateBits(UpdateMask *updateMask, Player *target) const;
 
@@ -520,6 +551,9 @@ class HELLGROUND_IMPORT_EXPORT WorldObject : public Object//, public WorldLocati
         }
         bool IsWithinLOS(const float x, const float y, const float z) const;
         bool IsWithinLOSInMap(WorldObject const* obj) const;
+        // drops units out of line of sight, rays are traced as one batch
+        void FilterWithinLOSInMap(std::list<Unit*>& targets) const;
+        bool IsWithinGroundLOS(const float x, const float y, const float z) const;
 
         bool IsInRange(WorldObject const* obj, float minRange, float maxRange, bool is3D = true) const;
         bool IsInRange2d(float x, float y, float minRange, float maxRange) const;
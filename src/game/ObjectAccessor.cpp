@@ -327,6 +327,13 @@ void ObjectAccessor::RemoveOldCorpses()
     }
 }
 
+void ObjectAccessor::ReclaimRegistries()
+{
+    HashMapHolder<Player>::ReclaimRetired();
+    HashMapHolder<Pet>::ReclaimRetired();
+    HashMapHolder<Corpse>::ReclaimRetired();
+}
+
 /// Define the static member of HashMapHolder
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
@@ -30,6 +30,7 @@
 #include "UpdateData.h"
 
 #include "GridDefines.h"
+#include "Utilities/FlatHashMap.h"
 #include "Object.h"
 #include "Player.h"
 
@@ -43,57 +44,44 @@ class DynamicObject;
 class WorldObject;
 class Map;
 
+/// Global guid -> object registry. Find is safe from any thread without
+/// locking, Insert and Remove take i_lock, which also has to be held while
+/// iterating GetContainer().
 template <class T>
 class HashMapHolder
 {
     public:
 
-        typedef std::unordered_map<uint64, T*>  MapType;
+        typedef FlatConcurrentPtrMap<uint64, T> MapType;
         typedef ACE_Thread_Mutex LockType;
 
         static bool Insert(T* o)
         {
-            auto a = m_objectMap.insert(std::make_pair(o->GetGUID(), o));
-            if (a.second)
-                return true;
-
-            return false;
+            ACE_GUARD_RETURN(LockType, guard, i_lock, false);
+            return m_objectMap.Insert(o->GetGUID(), o);
         }
 
         static bool Remove(T* o)
         {
-            typename MapType::iterator a = m_objectMap.find(o->GetGUID());
-
-            if (a != m_objectMap.end())
-            {
-                m_objectMap.erase(a);
-                return true;
-            }
-
-            return false;
+            return Remove(o->GetGUID());
         }
 
         static bool Remove(uint64 guid)
         {
-            typename MapType::iterator a = m_objectMap.find(guid);
-
-            if (a != m_objectMap.end())
-            {
-                m_objectMap.erase(a);
-                return true;
-            }
-
-            return false;
+            ACE_GUARD_RETURN(LockType, guard, i_lock, false);
+            return m_objectMap.Erase(guid);
         }
 
         static T* Find(uint64 guid)
         {
-            typename MapType::const_iterator a = m_objectMap.find(guid);
+            return m_objectMap.Find(guid);
+        }
 
-            if (a != m_objectMap.cend())
-                return a->second;
-            else
-                return NULL;
+        /// frees tables dropped by growing, call only while map threads are idle
+        static void ReclaimRetired()
+        {
+            ACE_GUARD(LockType, guard, i_lock);
+            m_objectMap.ReclaimRetired();
         }
 
         static MapType& GetContainer() { return m_objectMap; }
@@ -155,6 +143,9 @@ class ObjectAccessor
 
         void RemoveOldCorpses();
 
+        // map threads must be idle, see HashMapHolder::ReclaimRetired
+        void ReclaimRegistries();
+
         typedef ACE_Thread_Mutex LockType;
         std::list<Player*> playersToDelete;
 
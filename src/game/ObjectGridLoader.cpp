@@ -222,18 +222,25 @@ void ObjectGridLoader::Load(GridType &grid)
 void ObjectGridLoader::LoadN(void)
 {
     i_gameObjects = 0; i_creatures = 0; i_corpses = 0;
-    i_cell.data.Part.cell_y = 0;
-    for (unsigned int x=0; x < MAX_NUMBER_OF_CELLS; ++x)
+    LoadCells(0, MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS);
+    sLog.outDebug("%u GameObjects, %u Creatures, and %u Corpses/Bones loaded for grid %u on map %u", i_gameObjects, i_creatures, i_corpses,i_grid.GetGridId(), i_map->GetId());
+}
+
+uint32 ObjectGridLoader::LoadCells(uint32 first, uint32 count)
+{
+    uint32 last = std::min<uint32>(first + count, MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS);
+    for (uint32 i = first; i < last; ++i)
     {
+        unsigned int x = i / MAX_NUMBER_OF_CELLS;
+        unsigned int y = i % MAX_NUMBER_OF_CELLS;
+
         i_cell.data.Part.cell_x = x;
-        for (unsigned int y=0; y < MAX_NUMBER_OF_CELLS; ++y)
-        {
-            i_cell.data.Part.cell_y = y;
-            GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
-            loader.Load(i_grid(x, y), *this);
-        }
+        i_cell.data.Part.cell_y = y;
+        GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
+        loader.Load(i_grid(x, y), *this);
     }
-    sLog.outDebug("%u GameObjects, %u Creatures, and %u Corpses/Bones loaded for grid %u on map %u", i_gameObjects, i_creatures, i_corpses,i_grid.GetGridId(), i_map->GetId());
+
+    return last;
 }
 
 void ObjectGridUnloader::MoveToRespawnN()
@@ -46,6 +46,8 @@ class ObjectGridLoader
         void Visit(DynamicObjectMapType&) { }
 
         void LoadN(void);
+        // loads count cells starting at cell index first (x * MAX_NUMBER_OF_CELLS + y), returns index of next cell
+        uint32 LoadCells(uint32 first, uint32 count);
 
     private:
         Cell i_cell;
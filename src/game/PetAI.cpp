@@ -403,10 +403,10 @@ Unit* PetAI::FindValidTarget()
     Hellground::UnitListSearcher<Hellground::AnyUnfriendlyUnitInPetAttackRangeCheck> searcher(targets, u_check);
     Cell::VisitAllObjects(me, searcher, 30);
 
-    // remove not LoS targets and interruptable
+    // remove not selectable and interruptable
     for (std::list<Unit *>::iterator tIter = targets.begin(); tIter != targets.end();)
     {
-        if (!m_creature->IsWithinLOSInMap(*tIter) || (*tIter)->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NOT_SELECTABLE) ||
+        if ((*tIter)->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NOT_SELECTABLE) ||
             targetHasInterruptableAura(*tIter) ||
             (*tIter)->GetTypeId() == TYPEID_UNIT && ((Creature*)(*tIter))->isTrigger() )
         {
@@ -418,6 +418,9 @@ Unit* PetAI::FindValidTarget()
             ++tIter;
     }
 
+    // remove not LoS targets
+    m_creature->FilterWithinLOSInMap(targets);
+
     if (targets.empty())
         return NULL;
 
@@ -468,6 +468,13 @@ Player::Player (WorldSession *session): Unit(), m_reputationMgr(this), m_camera(
     _preventSave = false;
     _preventUpdate = false;
 
+    m_characterRowSaved = false;
+    memset(m_savedStatsRo, 0, sizeof(m_savedStatsRo));
+    m_savedStatsRoValid = false;
+    m_savedBGCoordId = 0xFFFFFFFF;                          // unknown, row may be left from previous session
+    m_savedAuraRows = 0xFFFFFFFF;
+    m_saveFailedTransactions = RealmDataDatabase.GetFailedTransactions();
+
     positionStatus.Reset(0);
 
     m_GrantableLevelsCount = 0;
@@ -1037,8 +1044,8 @@ int32 Player::getMaxTimer(MirrorTimerType timer)
                 return DISABLED_MIRROR_TIMER;
 
             int32 UnderWaterTime = MINUTE*IN_MILISECONDS;
-            AuraList const& mModWaterBreathing = GetAurasByType(SPELL_AURA_MOD_WATER_BREATHING);
-            for (AuraList::const_iterator i = mModWaterBreathing.begin(); i != mModWaterBreathing.end(); ++i)
+            AuraTypeList const& mModWaterBreathing = GetAurasByType(SPELL_AURA_MOD_WATER_BREATHING);
+            for (AuraTypeList::const_iterator i = mModWaterBreathing.begin(); i != mModWaterBreathing.end(); ++i)
                 UnderWaterTime = uint32(UnderWaterTime * (100.0f + (*i)->GetModifierValue()) / 100.0f);
 
             return UnderWaterTime;
@@ -2236,8 +2243,8 @@ void Player::Regenerate(Powers power)
             float RageDecreaseRate = sWorld.getConfig(RATE_POWER_RAGE_LOSS);
 
             int mult = 30;
-            const AuraList &auras = GetAurasByType(SPELL_AURA_MOD_POWER_REGEN);
-            for (AuraList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+            const AuraTypeList &auras = GetAurasByType(SPELL_AURA_MOD_POWER_REGEN);
+            for (AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
             {
                 if ((*itr)->GetSpellProto()->Id == 12296)
                 {
@@ -2259,8 +2266,8 @@ void Player::Regenerate(Powers power)
     // Exist only for POWER_MANA, POWER_ENERGY, POWER_FOCUS auras
     if (power != POWER_MANA)
     {
-        AuraList const& ModPowerRegenPCTAuras = GetAurasByType(SPELL_AURA_MOD_POWER_REGEN_PERCENT);
-        for (AuraList::const_iterator i = ModPowerRegenPCTAuras.begin(); i != ModPowerRegenPCTAuras.end(); ++i)
+        AuraTypeList const& ModPowerRegenPCTAuras = GetAurasByType(SPELL_AURA_MOD_POWER_REGEN_PERCENT);
+        for (AuraTypeList::const_iterator i = ModPowerRegenPCTAuras.begin(); i != ModPowerRegenPCTAuras.end(); ++i)
             if ((*i)->GetModifier()->m_miscvalue == power)
                 addvalue *= ((*i)->GetModifierValue() + 100) / 100.0f;
     }
@@ -2301,8 +2308,8 @@ void Player::RegenerateHealth()
         addvalue = OCTRegenHPPerSpirit()* HealthIncreaseRate;
         if (!IsInCombat())
         {
-            AuraList const& mModHealthRegenPct = GetAurasByType(SPELL_AURA_MOD_HEALTH_REGEN_PERCENT);
-            for (AuraList::const_iterator i = mModHealthRegenPct.begin(); i != mModHealthRegenPct.end(); ++i)
+            AuraTypeList const& mModHealthRegenPct = GetAurasByType(SPELL_AURA_MOD_HEALTH_REGEN_PERCENT);
+            for (AuraTypeList::const_iterator i = mModHealthRegenPct.begin(); i != mModHealthRegenPct.end(); ++i)
                 addvalue *= (100.0f + (*i)->GetModifierValue()) / 100.0f;
         }
         else if (HasAuraType(SPELL_AURA_MOD_REGEN_DURING_COMBAT))
@@ -2582,8 +2589,8 @@ void Player::GiveXP(uint32 xp, Unit* victim)
         return;
 
     // handle SPELL_AURA_MOD_XP_PCT auras
-    Unit::AuraList const& ModXPPctAuras = GetAurasByType(SPELL_AURA_MOD_XP_PCT);
-    for (Unit::AuraList::const_iterator i = ModXPPctAuras.begin();i != ModXPPctAuras.end(); ++i)
+    Unit::AuraTypeList const& ModXPPctAuras = GetAurasByType(SPELL_AURA_MOD_XP_PCT);
+    for (Unit::AuraTypeList::const_iterator i = ModXPPctAuras.begin();i != ModXPPctAuras.end(); ++i)
         xp = uint32(xp*(1.0f + (*i)->GetModifierValue() / 100.0f));
 
 
@@ -3160,7 +3167,8 @@ bool Player::addSpell(uint32 spell_id, bool active, bool learning, bool loading,
 
                             // mark old spell as disable (SMSG_SUPERCEDED_SPELL replace it in client by new)
                             itr2->second.active = false;
-                            itr2->second.state = PLAYERSPELL_CHANGED;
+                            if (itr2->second.state != PLAYERSPELL_NEW)
+                                itr2->second.state = PLAYERSPELL_CHANGED;
                             superceded_old = true;          // new spell replace old in action bars and spell book.
                         }
                         else if (sSpellMgr.IsHighRankOfSpell(itr2->first, spell_id))
@@ -3827,17 +3835,10 @@ void Player::_SetCreateBits(UpdateMask *updateMask, Player *target) const
     }
 }
 
-void Player::_SetUpdateBits(UpdateMask *updateMask, Player *target) const
+void Player::_FilterUpdateBits(UpdateMask *updateMask, Player *target) const
 {
-    if (target == this)
-    {
-        Object::_SetUpdateBits(updateMask, target);
-    }
-    else
-    {
-        Object::_SetUpdateBits(updateMask, target);
+    if (target != this)
         *updateMask &= updateVisualBits;
-    }
 }
 
 void Player::InitVisibleBits()
@@ -5681,14 +5682,14 @@ void Player::SetSkill(uint32 id, uint16 currVal, uint16 maxVal)
             SetUInt32Value(PLAYER_SKILL_BONUS_INDEX(i),0);
 
             // temporary bonuses
-            AuraList const& mModSkill = GetAurasByType(SPELL_AURA_MOD_SKILL);
-            for (AuraList::const_iterator j = mModSkill.begin(); j != mModSkill.end(); ++j)
+            AuraTypeList const& mModSkill = GetAurasByType(SPELL_AURA_MOD_SKILL);
+            for (AuraTypeList::const_iterator j = mModSkill.begin(); j != mModSkill.end(); ++j)
                 if ((*j)->GetModifier()->m_miscvalue == int32(id))
                     (*j)->ApplyModifier(true);
 
             // permanent bonuses
-            AuraList const& mModSkillTalent = GetAurasByType(SPELL_AURA_MOD_SKILL_TALENT);
-            for (AuraList::const_iterator j = mModSkillTalent.begin(); j != mModSkillTalent.end(); ++j)
+            AuraTypeList const& mModSkillTalent = GetAurasByType(SPELL_AURA_MOD_SKILL_TALENT);
+            for (AuraTypeList::const_iterator j = mModSkillTalent.begin(); j != mModSkillTalent.end(); ++j)
                 if ((*j)->GetModifier()->m_miscvalue == int32(id))
                     (*j)->ApplyModifier(true);
 
@@ -7198,16 +7199,16 @@ void Player::_ApplyItemBonuses(ItemPrototype const *proto,uint8 slot,bool apply)
 
 void Player::_ApplyWeaponDependentAuraMods(Item *item,WeaponAttackType attackType,bool apply)
 {
-    AuraList const& auraCritList = GetAurasByType(SPELL_AURA_MOD_CRIT_PERCENT);
-    for (AuraList::const_iterator itr = auraCritList.begin(); itr!=auraCritList.end();++itr)
+    AuraTypeList const& auraCritList = GetAurasByType(SPELL_AURA_MOD_CRIT_PERCENT);
+    for (AuraTypeList::const_iterator itr = auraCritList.begin(); itr!=auraCritList.end();++itr)
         _ApplyWeaponDependentAuraCritMod(item,attackType,*itr,apply);
 
-    AuraList const& auraDamageFlatList = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE);
-    for (AuraList::const_iterator itr = auraDamageFlatList.begin(); itr!=auraDamageFlatList.end();++itr)
+    AuraTypeList const& auraDamageFlatList = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE);
+    for (AuraTypeList::const_iterator itr = auraDamageFlatList.begin(); itr!=auraDamageFlatList.end();++itr)
         _ApplyWeaponDependentAuraDamageMod(item,attackType,*itr,apply);
 
-    AuraList const& auraDamagePCTList = GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
-    for (AuraList::const_iterator itr = auraDamagePCTList.begin(); itr!=auraDamagePCTList.end();++itr)
+    AuraTypeList const& auraDamagePCTList = GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
+    for (AuraTypeList::const_iterator itr = auraDamagePCTList.begin(); itr!=auraDamagePCTList.end();++itr)
         _ApplyWeaponDependentAuraDamageMod(item,attackType,*itr,apply);
 }
 
@@ -14636,6 +14637,7 @@ bool Player::LoadFromDB(uint32 guid, SqlQueryHolder *holder)
     }
 
     Object::_Create(guid, 0, HIGHGUID_PLAYER);
+    m_characterRowSaved = true;
 
     m_name = fields[3].GetCppString();
 
@@ -16377,37 +16379,59 @@ void Player::SaveToDB()
 
     bool inworld = IsInWorld();
 
+    // a rolled back transaction (maybe one of our previous saves) leaves rows the snapshots don't describe
+    uint32 failedTransactions = RealmDataDatabase.GetFailedTransactions();
+    if (failedTransactions != m_saveFailedTransactions)
+    {
+        m_saveFailedTransactions = failedTransactions;
+        InvalidateSavedRows();
+    }
+
+    // saves of different characters touch disjoint rows and may spread over async connections, but items
+    // and mails change owner through trade, mail and auction house. A save writing any of them stays
+    // unkeyed, so it runs after all saves queued before it and keyed saves queued after it wait for it
+    bool ownRowsOnly = m_itemUpdateQueue.empty() && !m_mailsUpdated;
+    SqlAsyncKey saveKey(RealmDataDatabase, ownRowsOnly ? GetGUIDLow() : 0);
+
     RealmDataDatabase.BeginTransaction();
 
     //CharacterDatabase.PExecute("DELETE FROM characters WHERE guid = '%u'",GetGUIDLow());
-    static SqlStatementID deleteStats;
-    SqlStatement stmt = RealmDataDatabase.CreateStatement(deleteStats, "DELETE FROM character_stats_ro WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    static SqlStatementID updateStats;
-    stmt = RealmDataDatabase.CreateStatement(updateStats, "INSERT INTO character_stats_ro VALUES (?, ?, ?, ?)");
-    stmt.PExecute(GetGUIDLow(), GetUInt32Value(PLAYER_FIELD_HONOR_CURRENCY), GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS),m_DailyArenasWon);
+    _SaveStatsRo();
 
     static SqlStatementID deleteCharacter;
     static SqlStatementID insertCharacter;
+    static SqlStatementID updateCharacter;
+
+    SqlStatement stmt = RealmDataDatabase.CreateStatement(deleteCharacter, "DELETE FROM characters WHERE guid = ?");
+
+    // row is known to exist after load or first save, rewrite it in place instead of delete + insert
+    if (m_characterRowSaved)
+        stmt = RealmDataDatabase.CreateStatement(updateCharacter, "UPDATE characters SET account = ?, name = ?, race = ?, class = ?, gender = ?, level = ?, xp = ?, money = ?, "
+                                            "playerBytes = ?, playerBytes2 = ?, playerFlags = ?, "
+                                            "map = ?, instance_id = ?, dungeon_difficulty = ?, position_x = ?, position_y = ?, position_z = ?, orientation = ?, data = ?, "
+                                            "taximask = ?, online = ?, cinematic = ?, "
+                                            "totaltime = ?, leveltime = ?, rest_bonus = ?, logout_time = ?, is_logout_resting = ?, resettalents_cost = ?, resettalents_time = ?, "
+                                            "trans_x = ?, trans_y = ?, trans_z = ?, trans_o = ?, transguid = ?, extra_flags = ?, stable_slots = ?, at_login = ?, zone = ?, "
+                                            "death_expire_time = ?, taxi_path = ?, arena_pending_points = ?, latency = ?, title = ?, grantableLevels = ? "
+                                            "WHERE guid = ?");
+    else
+    {
+        stmt.PExecute(GetGUIDLow());
 
-    stmt = RealmDataDatabase.CreateStatement(deleteCharacter, "DELETE FROM characters WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    stmt = RealmDataDatabase.CreateStatement(insertCharacter, "INSERT INTO characters (guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags, "
+        stmt = RealmDataDatabase.CreateStatement(insertCharacter, "INSERT INTO characters (account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags, "
                                             "map, instance_id, dungeon_difficulty, position_x, position_y, position_z, orientation, data, "
                                             "taximask, online, cinematic, "
                                             "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
                                             "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
-                                            "death_expire_time, taxi_path, arena_pending_points, latency, title, grantableLevels) "
-                                            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                                            "death_expire_time, taxi_path, arena_pending_points, latency, title, grantableLevels, guid) "
+                                            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
                                                 "?, ?, ?, ?, ?, ?, ?, ?, "
                                                 "?, ?, ?, "
                                                 "?, ?, ?, ?, ?, ?, ?, "
                                                 "?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                                                "?, ?, ?, ?, ?, ?)");
+                                                "?, ?, ?, ?, ?, ?, ?)");
+    }
 
-    stmt.addUInt32(GetGUIDLow());
     stmt.addUInt32(GetSession()->GetAccountId());
     stmt.addString(m_name);
     stmt.addUInt32(uint32(GetRace()));
@@ -16485,8 +16509,11 @@ void Player::SaveToDB()
     stmt.addUInt32(GetSession()->GetLatency());
     stmt.addUInt64(GetUInt64Value(PLAYER__FIELD_KNOWN_TITLES));
     stmt.addUInt32(m_GrantableLevelsCount);
+    stmt.addUInt32(GetGUIDLow());
     stmt.Execute();
 
+    m_characterRowSaved = true;
+
     if (m_mailsUpdated)                                      //save mails only when needed
         _SaveMail();
 
@@ -16501,6 +16528,7 @@ void Player::SaveToDB()
     _SaveAuras();
     m_reputationMgr.SaveToDB(false);
 
+    AddSaveStats(RealmDataDatabase.GetTransactionSize());
     RealmDataDatabase.CommitTransaction();
 
     // restore state (before aura apply, if aura remove flag then aura must set it ack by self)
@@ -16517,6 +16545,41 @@ void Player::SaveToDB()
     _preventSave = false;
 }
 
+void Player::InvalidateSavedRows()
+{
+    // next save deletes and inserts again everything it would skip otherwise
+    m_characterRowSaved = false;
+    m_savedStatsRoValid = false;
+    m_savedBGCoordId = 0xFFFFFFFF;
+    m_savedAuraRows = 0xFFFFFFFF;
+    m_CooldownMgr.InvalidateSaved();
+}
+
+static ACE_Thread_Mutex s_saveStatsLock;
+static PlayerSaveStats s_saveStats;
+
+void Player::AddSaveStats(size_t statements)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, s_saveStatsLock);
+
+    ++s_saveStats.saves;
+    s_saveStats.statements += statements;
+    if (statements > s_saveStats.maxStatements)
+        s_saveStats.maxStatements = uint32(statements);
+}
+
+PlayerSaveStats Player::GetSaveStats()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, s_saveStatsLock, PlayerSaveStats());
+    return s_saveStats;
+}
+
+void Player::ResetSaveStats()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, s_saveStatsLock);
+    s_saveStats = PlayerSaveStats();
+}
+
 // fast save function for item/money cheating preventing - save only inventory and money state
 void Player::SaveInventoryAndGoldToDB()
 {
@@ -16598,13 +16661,39 @@ void Player::_SaveActions()
     }
 }
 
+void Player::_SaveStatsRo()
+{
+    uint32 stats[3] = { GetUInt32Value(PLAYER_FIELD_HONOR_CURRENCY), GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS), m_DailyArenasWon };
+
+    // read only copy for external tools, rewrite it only when something changed
+    if (m_savedStatsRoValid && !memcmp(stats, m_savedStatsRo, sizeof(stats)))
+        return;
+
+    static SqlStatementID deleteStats;
+    static SqlStatementID updateStats;
+
+    SqlStatement stmt = RealmDataDatabase.CreateStatement(deleteStats, "DELETE FROM character_stats_ro WHERE guid = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    stmt = RealmDataDatabase.CreateStatement(updateStats, "INSERT INTO character_stats_ro VALUES (?, ?, ?, ?)");
+    stmt.PExecute(GetGUIDLow(), stats[0], stats[1], stats[2]);
+
+    memcpy(m_savedStatsRo, stats, sizeof(stats));
+    m_savedStatsRoValid = true;
+}
+
 void Player::_SaveAuras()
 {
     static SqlStatementID deleteAuras;
     static SqlStatementID insertAura;
 
     SqlStatement stmt = RealmDataDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+
+    // nothing left from previous save, most characters carry no saveable auras
+    if (m_savedAuraRows)
+        stmt.PExecute(GetGUIDLow());
+
+    m_savedAuraRows = 0;
 
     AuraMap const& auras = GetAuras();
 
@@ -16650,6 +16739,8 @@ void Player::_SaveAuras()
                         stmt.addInt32(itr2->second->GetAuraDuration());
                         stmt.addInt32(itr2->second->m_procCharges);
                         stmt.Execute();
+
+                        ++m_savedAuraRows;
                     }
                 }
             }
@@ -16674,11 +16765,19 @@ void Player::_SaveBattleGroundCoord()
     static SqlStatementID deleteBGCoord;
     static SqlStatementID insertBGCoord;
 
+    // entry point does not change while staying in the same battleground
+    uint32 bgId = InBattleGround() ? GetBattleGroundId() : 0;
+    if (bgId == m_savedBGCoordId)
+        return;
+
     SqlStatement stmt = RealmDataDatabase.CreateStatement(deleteBGCoord, "DELETE FROM character_bgcoord WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    if (m_savedBGCoordId)
+        stmt.PExecute(GetGUIDLow());
+
+    m_savedBGCoordId = bgId;
 
     // don't save if not needed
-    if (!InBattleGround())
+    if (!bgId)
         return;
 
     stmt = RealmDataDatabase.CreateStatement(insertBGCoord, "INSERT INTO character_bgcoord (guid, bgid, bgteam, bgmap, bgx, bgy, bgz, bgo) "
@@ -17000,18 +17099,31 @@ void Player::_SaveSpells()
 {
     static SqlStatementID deleteSpell;
     static SqlStatementID insertSpell;
+    static SqlStatementID updateSpell;
 
     for (PlayerSpellMap::iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end(); itr = next)
     {
         ++next;
 
-        if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
+        if (itr->second.state == PLAYERSPELL_REMOVED)
         {
             SqlStatement stmt = RealmDataDatabase.CreateStatement(deleteSpell, "DELETE FROM character_spell WHERE guid = ? and spell = ?");
             stmt.PExecute(GetGUIDLow(), itr->first);
         }
 
-        if (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED)
+        // row loaded from db, only flags differ
+        if (itr->second.state == PLAYERSPELL_CHANGED)
+        {
+            SqlStatement stmt = RealmDataDatabase.CreateStatement(updateSpell, "UPDATE character_spell SET slot = ?, active = ?, disabled = ? WHERE guid = ? AND spell = ?");
+            stmt.addUInt32(itr->second.slotId);
+            stmt.addBool(itr->second.active);
+            stmt.addBool(itr->second.disabled);
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt32(itr->first);
+            stmt.Execute();
+        }
+
+        if (itr->second.state == PLAYERSPELL_NEW)
         {
             {
                 //in some way we have primary-key insert errors, due to what characters are not saved (!!!)
@@ -19098,28 +19210,64 @@ bool Player::IsVisibleGloballyfor (Player* u) const
     return true;
 }
 
+bool Player::IsVisibilityUnchanged(WorldObject const* viewPoint, WorldObject const* target) const
+{
+    // only units already at client, not-visible and other objects always get full check
+    if (target == this || !target->isType(TYPEMASK_UNIT) || !HaveAtClient(target))
+        return false;
+
+    Unit const* u = (Unit const*)target;
+    if (!IsInWorld() || !u->IsInWorld())
+        return false;
+
+    // corpses and ghosts depend on death timers and corpse distance
+    if (!IsAlive() || !u->IsAlive())
+        return false;
+
+    // stealth, invisibility and gm visibility need detection check
+    if (u->GetVisibility() != VISIBILITY_ON || u->m_invisibilityMask || m_invisibilityMask)
+        return false;
+
+    // arena preparation hides enemy team
+    if (GetMap()->IsBattleArena())
+        return false;
+
+    if (Creature const* c = u->ToCreature())
+    {
+        if (c->GetEntry() == VISUAL_WAYPOINT)
+            return false;
+
+        if (c->IsAIEnabled && !c->AI()->IsVisible())
+            return false;
+    }
+
+    // any unit is visible at least up to map visibility distance, position change
+    // inside it can't hide unit
+    return viewPoint->IsWithinDistInMap(u, GetMap()->GetVisibilityDistance(), false);
+}
+
 template<class T>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, T* target, std::set<WorldObject*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, T* target, std::set<WorldObject*>& v)
 {
     s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, GameObject* target, std::set<WorldObject*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, GameObject* target, std::set<WorldObject*>& v)
 {
     if(!target->IsTransport())
         s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Creature* target, std::set<WorldObject*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Creature* target, std::set<WorldObject*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Player* target, std::set<WorldObject*>& v)
+inline void UpdateVisibilityOf_helper(Player::ClientGUIDs& s64, Player* target, std::set<WorldObject*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
@@ -19402,7 +19550,7 @@ void Player::SendInitialPacketsAfterAddToMap()
 
     for (AuraType const* itr = &auratypes[0]; itr && itr[0] != SPELL_AURA_NONE; ++itr)
     {
-        Unit::AuraList const& auraList = GetAurasByType(*itr);
+        Unit::AuraTypeList const& auraList = GetAurasByType(*itr);
         if (!auraList.empty())
             auraList.front()->ApplyModifier(true,true);
     }
@@ -20082,8 +20230,8 @@ uint32 Player::GetResurrectionSpellId()
     // search priceless resurrection possibilities
     uint32 prio = 0;
     uint32 spell_id = 0;
-    AuraList const& dummyAuras = GetAurasByType(SPELL_AURA_DUMMY);
-    for (AuraList::const_iterator itr = dummyAuras.begin(); itr != dummyAuras.end(); ++itr)
+    AuraTypeList const& dummyAuras = GetAurasByType(SPELL_AURA_DUMMY);
+    for (AuraTypeList::const_iterator itr = dummyAuras.begin(); itr != dummyAuras.end(); ++itr)
     {
         // Soulstone Resurrection                           // prio: 3 (max, non death persistent)
         if (prio < 2 && (*itr)->GetSpellProto()->SpellVisual == 99 && (*itr)->GetSpellProto()->SpellIconID == 92)
@@ -21175,9 +21323,9 @@ void Player::AutoStoreLoot(uint8 bag, uint8 slot, uint32 loot_id, LootStore cons
 /*-----------------------TRINITY--------------------------*/
 bool Player::isTotalImmunity()
 {
-    AuraList const& immune = GetAurasByType(SPELL_AURA_SCHOOL_IMMUNITY);
+    AuraTypeList const& immune = GetAurasByType(SPELL_AURA_SCHOOL_IMMUNITY);
 
-    for (AuraList::const_iterator itr = immune.begin(); itr != immune.end(); ++itr)
+    for (AuraTypeList::const_iterator itr = immune.begin(); itr != immune.end(); ++itr)
     {
         if (((*itr)->GetModifier()->m_miscvalue & SPELL_SCHOOL_MASK_ALL) !=0)   // total immunity
         {
@@ -21185,7 +21333,7 @@ bool Player::isTotalImmunity()
         }
         if (((*itr)->GetModifier()->m_miscvalue & SPELL_SCHOOL_MASK_NORMAL) !=0)   // physical damage immunity
         {
-            for (AuraList::const_iterator i = immune.begin(); i != immune.end(); ++i)
+            for (AuraTypeList::const_iterator i = immune.begin(); i != immune.end(); ++i)
             {
                 if (((*i)->GetModifier()->m_miscvalue & SPELL_SCHOOL_MASK_MAGIC) !=0)   // magic immunity
                 {
@@ -36,6 +36,7 @@
 #include "Pet.h"
 #include "MapReference.h"
 #include "Util.h"                                           // for Tokens typedef
+#include "Utilities/FlatHashMap.h"
 #include "ReputationMgr.h"
 #include "World.h"
 
@@ -893,6 +894,16 @@ struct AccessRequirement
     std::string missingAuraText;
 };
 
+// save volume of Player::SaveToDB, statements are counted in the character transaction
+struct PlayerSaveStats
+{
+    PlayerSaveStats() : saves(0), statements(0), maxStatements(0) {}
+
+    uint64 saves;
+    uint64 statements;
+    uint32 maxStatements;
+};
+
 class HELLGROUND_IMPORT_EXPORT PlayerTaxi
 {
     public:
@@ -1383,6 +1394,8 @@ class HELLGROUND_EXPORT Player : public Unit
         /*********************************************************/
 
         void SaveToDB();
+        static PlayerSaveStats GetSaveStats();
+        static void ResetSaveStats();
         void SaveInventoryAndGoldToDB();                    // fast save function for item/money cheating preventing
         void SaveGoldToDB();
         void SaveDataFieldToDB();
@@ -2168,7 +2181,7 @@ class HELLGROUND_EXPORT Player : public Unit
         bool TeleportToHomebind(uint32 options = 0) { return TeleportTo(m_homebindMapId, m_homebindX, m_homebindY, m_homebindZ, GetOrientation(), options); }
 
         // currently visible objects at player client
-        typedef std::set<uint64> ClientGUIDs;
+        typedef FlatHashSet<uint64> ClientGUIDs;
         ClientGUIDs m_clientGUIDs;
 
         bool HaveAtClient(WorldObject const* u) const { return u == this || m_clientGUIDs.find(u->GetGUID()) != m_clientGUIDs.end(); }
@@ -2176,6 +2189,8 @@ class HELLGROUND_EXPORT Player : public Unit
         bool canSeeOrDetect(Unit const* u, WorldObject const*, bool detect, bool inVisibleList = false, bool is3dDistance = true) const;
         bool IsVisibleInGridForPlayer(Player const* pl) const;
         bool IsVisibleGloballyfor (Player* pl) const;
+        // target known to client that must stay visible without full canSeeOrDetect
+        bool IsVisibilityUnchanged(WorldObject const* viewPoint, WorldObject const* target) const;
 
         void SendInitialVisiblePackets(Unit* target);
 
@@ -2358,6 +2373,7 @@ class HELLGROUND_EXPORT Player : public Unit
         /*********************************************************/
 
         void _SaveActions();
+        void _SaveStatsRo();
         void _SaveAuras();
         void _SaveBattleGroundCoord();
         void _SaveInventory();
@@ -2368,7 +2384,7 @@ class HELLGROUND_EXPORT Player : public Unit
         void _SaveTutorials();
 
         void _SetCreateBits(UpdateMask *updateMask, Player *target) const;
-        void _SetUpdateBits(UpdateMask *updateMask, Player *target) const;
+        void _FilterUpdateBits(UpdateMask *updateMask, Player *target) const;
 
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
@@ -2517,9 +2533,20 @@ class HELLGROUND_EXPORT Player : public Unit
 
         bool m_farsightVision;
 
+        static void AddSaveStats(size_t statements);
+        void InvalidateSavedRows();
+
         bool _preventSave;
         bool _preventUpdate;
 
+        // what previous SaveToDB left in tables without own dirty tracking
+        bool m_characterRowSaved;                           // `characters` row exists, UPDATE it
+        uint32 m_savedStatsRo[3];
+        bool m_savedStatsRoValid;
+        uint32 m_savedBGCoordId;                            // battleground of saved `character_bgcoord` row, 0 - none
+        uint32 m_savedAuraRows;
+        uint32 m_saveFailedTransactions;                    // RealmDataDatabase failed transactions seen by last save
+
         DeclinedName *m_declinedname;
 
         ACE_Thread_Mutex updateMutex;
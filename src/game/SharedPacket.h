@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2008-2017 Hellground <http://wow-hellground.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef HELLGROUND_SHAREDPACKET_H
+#define HELLGROUND_SHAREDPACKET_H
+
+#include <atomic>
+#include <new>
+
+#include "Common.h"
+#include "WorldPacket.h"
+
+/// Immutable copy of a packet payload, allocated together with its
+/// reference count. Sockets queue references to it instead of copying bytes.
+class SharedPacketData
+{
+    public:
+        static SharedPacketData* Create(WorldPacket const& packet)
+        {
+            uint32 size = uint32(packet.size());
+            void* mem = ::operator new(sizeof(SharedPacketData) + size);
+            SharedPacketData* data = new (mem) SharedPacketData(packet.GetOpcode(), size);
+            if (size)
+                memcpy(data + 1, packet.contents(), size);
+
+            return data;
+        }
+
+        void AddRef() { m_refs.fetch_add(1, std::memory_order_relaxed); }
+
+        void Release()
+        {
+            if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                this->~SharedPacketData();
+                ::operator delete(this);
+            }
+        }
+
+        uint16 GetOpcode() const { return m_opcode; }
+        uint32 size() const { return m_size; }
+        uint8 const* contents() const { return reinterpret_cast<uint8 const*>(this + 1); }
+
+    private:
+        SharedPacketData(uint16 opcode, uint32 size) : m_size(size), m_opcode(opcode)
+        {
+            m_refs.store(1, std::memory_order_relaxed);
+        }
+
+        ~SharedPacketData() {}
+
+        SharedPacketData(SharedPacketData const&);
+        SharedPacketData& operator=(SharedPacketData const&);
+
+        std::atomic<uint32> m_refs;
+        uint32 m_size;
+        uint16 m_opcode;
+};
+
+/// One packet sent to many sessions. Payload is copied once, on the first
+/// socket that needs to keep it, every other socket only takes a reference.
+class SharedPacket
+{
+    public:
+        explicit SharedPacket(WorldPacket const* packet) : m_packet(packet), m_data(NULL) {}
+
+        ~SharedPacket()
+        {
+            if (m_data)
+                m_data->Release();
+        }
+
+        WorldPacket const* GetPacket() const { return m_packet; }
+
+        /// new reference to the shared payload, caller releases it
+        SharedPacketData* GetData() const
+        {
+            if (!m_data)
+                m_data = SharedPacketData::Create(*m_packet);
+
+            m_data->AddRef();
+            return m_data;
+        }
+
+    private:
+        SharedPacket(SharedPacket const&);
+        SharedPacket& operator=(SharedPacket const&);
+
+        WorldPacket const* m_packet;
+        mutable SharedPacketData* m_data;
+};
+
+#endif
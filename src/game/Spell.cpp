@@ -1502,10 +1502,9 @@ void Spell::SearchAreaTarget(std::list<Unit*> &TagUnitMap, float radius, const u
     {
         case SPELL_TARGET_TYPE_NONE:
         {
-            Hellground::SpellNotifierCreatureAndPlayer notifier(*this, TagUnitMap, radius, type, TargetType, entry, x, y, z);
+            bool playersOnly = (GetSpellEntry()->AttributesEx3 & SPELL_ATTR_EX3_PLAYERS_ONLY) != 0;
+            Hellground::SpellNotifierCreatureAndPlayer notifier(*this, TagUnitMap, radius, type, TargetType, entry, x, y, z, playersOnly);
             Cell::VisitAllObjects(x, y, m_caster->GetMap(), notifier, radius);
-            if ((GetSpellEntry()->AttributesEx3 & SPELL_ATTR_EX3_PLAYERS_ONLY))
-                TagUnitMap.remove_if(Hellground::ObjectTypeIdCheck(TYPEID_PLAYER, false)); // above line will select also pets and totems, remove them
             break;
         }
         case SPELL_TARGET_TYPE_CREATURE:
@@ -1530,7 +1529,7 @@ void Spell::SearchAreaTarget(std::list<Unit*> &TagUnitMap, float radius, const u
             sLog.outLog(LOG_DEFAULT, "ERROR: WTF ? Oo Wrong spell script target type for this function: %i (shouldbe %i or %i)", spellScriptTargetType, SPELL_TARGET_TYPE_CREATURE, SPELL_TARGET_TYPE_DEAD);
             break;
     }
-    TagUnitMap.remove_if(Hellground::ObjectIsTotemCheck(true)); // totems should not be affected by AoE spells (check if no exceptions?)
+    // totems are skipped by the notifiers, they should not be affected by AoE spells
 }
 
 void Spell::SearchAreaTarget(std::list<GameObject*> &goList, float radius, const uint32 type, SpellTargets TargetType, uint32 entry, SpellScriptTargetType spellScriptTargetType)
@@ -2663,8 +2662,8 @@ void Spell::cast(bool skipCheck)
 
     //handle SPELL_AURA_ADD_TARGET_TRIGGER auras
     //are there any spells need to be triggered after hit?
-    Unit::AuraList const& targetTriggers = m_caster->GetAurasByType(SPELL_AURA_ADD_TARGET_TRIGGER);
-    for (Unit::AuraList::const_iterator i = targetTriggers.begin(); i != targetTriggers.end(); ++i)
+    Unit::AuraTypeList const& targetTriggers = m_caster->GetAurasByType(SPELL_AURA_ADD_TARGET_TRIGGER);
+    for (Unit::AuraTypeList::const_iterator i = targetTriggers.begin(); i != targetTriggers.end(); ++i)
     {
         SpellEntry const *auraSpellEntry = (*i)->GetSpellProto();
         uint32 auraSpellIdx = (*i)->GetEffIndex();
@@ -5903,8 +5902,8 @@ Unit* Spell::SelectMagnetTarget() // Grounding totem | Intervene
 
         if (target->HasAuraType(SPELL_AURA_SPELL_MAGNET))
         {
-            Unit::AuraList const& magnetAuras = target->GetAurasByType(SPELL_AURA_SPELL_MAGNET);
-            for (Unit::AuraList::const_iterator itr = magnetAuras.begin(); itr != magnetAuras.end(); ++itr)
+            Unit::AuraTypeList const& magnetAuras = target->GetAurasByType(SPELL_AURA_SPELL_MAGNET);
+            for (Unit::AuraTypeList::const_iterator itr = magnetAuras.begin(); itr != magnetAuras.end(); ++itr)
             {
                 if (Unit* magnet = (*itr)->GetCaster())
                 {
@@ -5936,8 +5935,8 @@ Unit* Spell::SelectMagnetTarget() // Grounding totem | Intervene
     {
         if (target->HasAuraType(SPELL_AURA_ADD_CASTER_HIT_TRIGGER))
         {
-            Unit::AuraList const& hitTriggerAuras = target->GetAurasByType(SPELL_AURA_ADD_CASTER_HIT_TRIGGER);
-            for (Unit::AuraList::const_iterator itr = hitTriggerAuras.begin(); itr != hitTriggerAuras.end(); ++itr)
+            Unit::AuraTypeList const& hitTriggerAuras = target->GetAurasByType(SPELL_AURA_ADD_CASTER_HIT_TRIGGER);
+            for (Unit::AuraTypeList::const_iterator itr = hitTriggerAuras.begin(); itr != hitTriggerAuras.end(); ++itr)
             {
                 if (Unit* hitTarget = (*itr)->GetCaster())
                 {
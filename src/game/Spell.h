@@ -22,6 +22,7 @@
 #define HELLGROUND_SPELL_H
 
 #include "GridDefines.h"
+#include "Cell.h"
 #include "SharedDefines.h"
 #include "PathFinder.h"
 
@@ -734,6 +735,30 @@ namespace Hellground
         #endif
     };
 
+    // circle the final distance check of an area spell can pass in, objects outside of it are skipped before
+    // alive and faction checks. Checks done from caster add both object sizes to radius, the others use plain distance
+    struct SpellSearchCircle
+    {
+        SpellSearchCircle(Unit* caster, uint32 pushType, SpellTargets targetType, float searchRadius, float cx, float cy)
+            : x(cx), y(cy), radius(searchRadius), sizeAware(false)
+        {
+            bool fromCaster = pushType == PUSH_IN_FRONT || pushType == PUSH_IN_BACK || pushType == PUSH_IN_LINE ||
+                (pushType == PUSH_SRC_CENTER && targetType != SPELL_TARGETS_ENTRY);
+
+            if (fromCaster && caster)
+            {
+                x = caster->GetPositionX();
+                y = caster->GetPositionY();
+                radius += caster->GetObjectSize();
+                sizeAware = true;
+            }
+        }
+
+        float x, y;
+        float radius;
+        bool sizeAware;
+    };
+
     struct SpellNotifierCreatureAndPlayer
     {
         std::list<Unit*> *i_data;
@@ -744,11 +769,14 @@ namespace Hellground
         Unit* i_caster;
         uint32 i_entry;
         float i_x, i_y, i_z;
+        bool i_playersOnly;
+        SpellSearchCircle i_circle;
 
         SpellNotifierCreatureAndPlayer(Spell &spell, std::list<Unit*> &data, float radius, const uint32 &type,
-            SpellTargets TargetType = SPELL_TARGETS_ENEMY, uint32 entry = 0, float x = 0, float y = 0, float z = 0)
+            SpellTargets TargetType = SPELL_TARGETS_ENEMY, uint32 entry = 0, float x = 0, float y = 0, float z = 0, bool playersOnly = false)
             : i_data(&data), i_spell(spell), i_push_type(type), i_radius(radius), i_radiusSq(radius*radius)
-            , i_TargetType(TargetType), i_entry(entry), i_x(x), i_y(y), i_z(z)
+            , i_TargetType(TargetType), i_entry(entry), i_x(x), i_y(y), i_z(z), i_playersOnly(playersOnly)
+            , i_circle(spell.GetCaster(), type, TargetType, radius, x, y)
         {
             i_caster = spell.GetCaster();
         }
@@ -761,75 +789,85 @@ namespace Hellground
             if (!i_caster)
                 return;
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                if (!itr->getSource()->IsAlive() || (itr->getSource()->GetTypeId() == TYPEID_PLAYER && ((Player*)itr->getSource())->IsTaxiFlying()))
-                    continue;
+            AreaBatch::Visit(m, i_circle.x, i_circle.y, i_circle.radius, i_circle.sizeAware, *this);
+        }
 
-                if (itr->getSource()->m_invisibilityMask && itr->getSource()->m_invisibilityMask & (1 << 10) && !i_caster->canDetectInvisibilityOf(itr->getSource()))
-                    continue;
+        template<class T>
+        void VisitObject(T* target)
+        {
+            if (i_playersOnly && target->GetTypeId() != TYPEID_PLAYER)
+                return;
 
-                switch (i_TargetType)
+            // totems are never hit by area spells
+            if (target->GetTypeId() == TYPEID_UNIT && ((Creature*)target)->isTotem())
+                return;
+
+            if (!target->IsAlive() || (target->GetTypeId() == TYPEID_PLAYER && ((Player*)target)->IsTaxiFlying()))
+                return;
+
+            if (target->m_invisibilityMask && target->m_invisibilityMask & (1 << 10) && !i_caster->canDetectInvisibilityOf(target))
+                return;
+
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_ALLY:
+                    if (!target->isTargetableForAttack() || !i_caster->IsFriendlyTo(target))
+                        return;
+                    break;
+                case SPELL_TARGETS_ENEMY:
                 {
-                    case SPELL_TARGETS_ALLY:
-                        if (!itr->getSource()->isTargetableForAttack() || !i_caster->IsFriendlyTo(itr->getSource()))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_ENEMY:
-                    {
-                        if (itr->getSource()->GetTypeId()==TYPEID_UNIT && (((Creature*)itr->getSource())->isTotem() || itr->getSource()->GetCreatureType() == CREATURE_TYPE_CRITTER))
-                            continue;
-                        if (!itr->getSource()->isTargetableForAttack())
-                            continue;
+                    if (target->GetTypeId()==TYPEID_UNIT && (((Creature*)target)->isTotem() || target->GetCreatureType() == CREATURE_TYPE_CRITTER))
+                        return;
+                    if (!target->isTargetableForAttack())
+                        return;
 
-                        Unit* check = i_caster->GetCharmerOrOwnerOrSelf();
-
-                        if (check->GetTypeId()==TYPEID_PLAYER)
-                        {
-                            if (check->IsFriendlyTo(itr->getSource()))
-                                continue;
-                        }
-                        else
-                        {
-                            if (!check->IsHostileTo(itr->getSource()))
-                                continue;
-                        }
-                    }break;
-                    case SPELL_TARGETS_ENTRY:
-                    {
-                        if (itr->getSource()->GetEntry()!= i_entry)
-                            continue;
-                    }break;
-                    default: continue;
-                }
+                    Unit* check = i_caster->GetCharmerOrOwnerOrSelf();
 
-                switch (i_push_type)
+                    if (check->GetTypeId()==TYPEID_PLAYER)
+                    {
+                        if (check->IsFriendlyTo(target))
+                            return;
+                    }
+                    else
+                    {
+                        if (!check->IsHostileTo(target))
+                            return;
+                    }
+                }break;
+                case SPELL_TARGETS_ENTRY:
                 {
-                    case PUSH_IN_FRONT:
-                        if (i_caster->isInFront((Unit*)(itr->getSource()), i_radius, M_PI/3))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK:
-                        if (i_caster->isInBack((Unit*)(itr->getSource()), i_radius, M_PI/3))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_LINE:
-                        if (i_caster->isInLine((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    default:
-                        if (i_TargetType != SPELL_TARGETS_ENTRY && i_push_type == PUSH_SRC_CENTER && i_caster) // if caster then check distance from caster to target (because of model collision)
-                        {
-                            if (i_caster->IsWithinDistInMap(itr->getSource(), i_radius))
-                                i_data->push_back(itr->getSource());
-                        }
-                        else
-                        {
-                            if ((itr->getSource()->GetDistanceSq(i_x, i_y, i_z) < i_radiusSq))
-                                i_data->push_back(itr->getSource());
-                        }
-                        break;
-                }
+                    if (target->GetEntry()!= i_entry)
+                        return;
+                }break;
+                default: return;
+            }
+
+            switch (i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if (i_caster->isInFront((Unit*)(target), i_radius, M_PI/3))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_BACK:
+                    if (i_caster->isInBack((Unit*)(target), i_radius, M_PI/3))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_LINE:
+                    if (i_caster->isInLine((Unit*)(target), i_radius))
+                        i_data->push_back(target);
+                    break;
+                default:
+                    if (i_TargetType != SPELL_TARGETS_ENTRY && i_push_type == PUSH_SRC_CENTER && i_caster) // if caster then check distance from caster to target (because of model collision)
+                    {
+                        if (i_caster->IsWithinDistInMap(target, i_radius))
+                            i_data->push_back(target);
+                    }
+                    else
+                    {
+                        if ((target->GetDistanceSq(i_x, i_y, i_z) < i_radiusSq))
+                            i_data->push_back(target);
+                    }
+                    break;
             }
         }
 
@@ -852,11 +890,13 @@ namespace Hellground
         Unit* i_caster;
         uint32 i_entry;
         float i_x, i_y, i_z;
+        SpellSearchCircle i_circle;
 
         SpellNotifierDeadCreature(Spell &spell, std::list<Unit*> &data, float radius, const uint32 &type,
             SpellTargets TargetType = SPELL_TARGETS_ENEMY, uint32 entry = 0, float x = 0, float y = 0, float z = 0)
             : i_data(&data), i_spell(spell), i_push_type(type), i_radius(radius), i_radiusSq(radius*radius)
             , i_TargetType(TargetType), i_entry(entry), i_x(x), i_y(y), i_z(z)
+            , i_circle(spell.GetCaster(), type, TargetType, radius, x, y)
         {
             i_caster = spell.GetCaster();
         }
@@ -868,74 +908,81 @@ namespace Hellground
             if (!i_caster)
                 return;
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                if (itr->getSource()->GetTypeId() != TYPEID_UNIT ||
-                    (itr->getSource()->GetDeathState() != CORPSE &&
-                     itr->getSource()->GetDeathState() != JUST_DIED))
-                    continue;
+            AreaBatch::Visit(m, i_circle.x, i_circle.y, i_circle.radius, i_circle.sizeAware, *this);
+        }
 
-                switch (i_TargetType)
+        template<class T>
+        void VisitObject(T* target)
+        {
+            if (target->GetTypeId() != TYPEID_UNIT ||
+                (target->GetDeathState() != CORPSE &&
+                 target->GetDeathState() != JUST_DIED))
+                return;
+
+            // totems are never hit by area spells
+            if (((Creature*)target)->isTotem())
+                return;
+
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_ALLY:
+                    if (!target->isTargetableForAttack() || !i_caster->IsFriendlyTo(target))
+                        return;
+                    break;
+                case SPELL_TARGETS_ENEMY:
                 {
-                    case SPELL_TARGETS_ALLY:
-                        if (!itr->getSource()->isTargetableForAttack() || !i_caster->IsFriendlyTo(itr->getSource()))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_ENEMY:
-                    {
-                        if (((Creature*)itr->getSource())->isTotem())
-                            continue;
-                        if (!itr->getSource()->isTargetableForAttack())
-                            continue;
+                    if (((Creature*)target)->isTotem())
+                        return;
+                    if (!target->isTargetableForAttack())
+                        return;
 
-                        Unit* check = i_caster->GetCharmerOrOwnerOrSelf();
-
-                        if (check->GetTypeId()==TYPEID_PLAYER)
-                        {
-                            if (check->IsFriendlyTo(itr->getSource()))
-                                continue;
-                        }
-                        else
-                        {
-                            if (!check->IsHostileTo(itr->getSource()))
-                                continue;
-                        }
-                    }break;
-                    case SPELL_TARGETS_ENTRY:
-                    {
-                        if (itr->getSource()->GetEntry()!= i_entry)
-                            continue;
-                    }break;
-                    default: continue;
-                }
+                    Unit* check = i_caster->GetCharmerOrOwnerOrSelf();
 
-                switch (i_push_type)
+                    if (check->GetTypeId()==TYPEID_PLAYER)
+                    {
+                        if (check->IsFriendlyTo(target))
+                            return;
+                    }
+                    else
+                    {
+                        if (!check->IsHostileTo(target))
+                            return;
+                    }
+                }break;
+                case SPELL_TARGETS_ENTRY:
                 {
-                    case PUSH_IN_FRONT:
-                        if (i_caster->isInFront((Unit*)(itr->getSource()), i_radius, M_PI/3))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK:
-                        if (i_caster->isInBack((Unit*)(itr->getSource()), i_radius, M_PI/3))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_LINE:
-                        if (i_caster->isInLine((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    default:
-                        if (i_TargetType != SPELL_TARGETS_ENTRY && i_push_type == PUSH_SRC_CENTER && i_caster) // if caster then check distance from caster to target (because of model collision)
-                        {
-                            if (i_caster->IsWithinDistInMap(itr->getSource(), i_radius))
-                                i_data->push_back(itr->getSource());
-                        }
-                        else
-                        {
-                            if ((itr->getSource()->GetDistanceSq(i_x, i_y, i_z) < i_radiusSq))
-                                i_data->push_back(itr->getSource());
-                        }
-                        break;
-                }
+                    if (target->GetEntry()!= i_entry)
+                        return;
+                }break;
+                default: return;
+            }
+
+            switch (i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if (i_caster->isInFront((Unit*)(target), i_radius, M_PI/3))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_BACK:
+                    if (i_caster->isInBack((Unit*)(target), i_radius, M_PI/3))
+                        i_data->push_back(target);
+                    break;
+                case PUSH_IN_LINE:
+                    if (i_caster->isInLine((Unit*)(target), i_radius))
+                        i_data->push_back(target);
+                    break;
+                default:
+                    if (i_TargetType != SPELL_TARGETS_ENTRY && i_push_type == PUSH_SRC_CENTER && i_caster) // if caster then check distance from caster to target (because of model collision)
+                    {
+                        if (i_caster->IsWithinDistInMap(target, i_radius))
+                            i_data->push_back(target);
+                    }
+                    else
+                    {
+                        if ((target->GetDistanceSq(i_x, i_y, i_z) < i_radiusSq))
+                            i_data->push_back(target);
+                    }
+                    break;
             }
         }
 
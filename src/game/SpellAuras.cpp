@@ -1158,8 +1158,8 @@ void Aura::_RemoveAura()
         if (GetSpellProto()->SpellFamilyName == SPELLFAMILY_WARLOCK && (GetSpellProto()->SpellFamilyFlags & 4))
         {
             bool found = false;
-            Unit::AuraList const &mPeriodic = m_target->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-            for (Unit::AuraList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
+            Unit::AuraTypeList const &mPeriodic = m_target->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+            for (Unit::AuraTypeList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
             {
                  if ((*i)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_WARLOCK && (*i)->GetCasterGUID() != GetCasterGUID() && ((*i)->GetSpellProto()->SpellFamilyFlags & 4))
                  {
@@ -1177,8 +1177,8 @@ void Aura::_RemoveAura()
             && (GetSpellProto()->SpellFamilyFlags == 0x40 || GetSpellProto()->SpellFamilyFlags == 0x10))
         {
             bool found = false;
-            Unit::AuraList const& RejorRegr = m_target->GetAurasByType(SPELL_AURA_PERIODIC_HEAL);
-            for (Unit::AuraList::const_iterator i = RejorRegr.begin(); i != RejorRegr.end(); ++i)
+            Unit::AuraTypeList const& RejorRegr = m_target->GetAurasByType(SPELL_AURA_PERIODIC_HEAL);
+            for (Unit::AuraTypeList::const_iterator i = RejorRegr.begin(); i != RejorRegr.end(); ++i)
             {
                 if ((*i)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_DRUID
                     && ((*i)->GetSpellProto()->SpellFamilyFlags == 0x40 || (*i)->GetSpellProto()->SpellFamilyFlags == 0x10))
@@ -1757,8 +1757,8 @@ void Aura::TriggerSpell()
                     // Aura of Desire
                     case 41350:
                     {
-                        Unit::AuraList const& mMod = m_target->GetAurasByType(SPELL_AURA_MOD_INCREASE_ENERGY_PERCENT);
-                        for (Unit::AuraList::const_iterator i = mMod.begin(); i != mMod.end(); ++i)
+                        Unit::AuraTypeList const& mMod = m_target->GetAurasByType(SPELL_AURA_MOD_INCREASE_ENERGY_PERCENT);
+                        for (Unit::AuraTypeList::const_iterator i = mMod.begin(); i != mMod.end(); ++i)
                         {
                             if ((*i)->GetId() == 41350)
                             {
@@ -1858,8 +1858,8 @@ void Aura::TriggerSpell()
                         if (caster->GetTypeId() == TYPEID_PLAYER)
                         {
                             float f_chance = 0;
-                            Unit::AuraList const& auraTriggerSpell = caster->GetAurasByType(SPELL_AURA_PROC_TRIGGER_SPELL);
-                            for (Unit::AuraList::const_iterator itr = auraTriggerSpell.begin(); itr != auraTriggerSpell.end(); ++itr)
+                            Unit::AuraTypeList const& auraTriggerSpell = caster->GetAurasByType(SPELL_AURA_PROC_TRIGGER_SPELL);
+                            for (Unit::AuraTypeList::const_iterator itr = auraTriggerSpell.begin(); itr != auraTriggerSpell.end(); ++itr)
                             {
                                 switch ((*itr)->GetSpellProto()->Id)
                                 {
@@ -1961,8 +1961,8 @@ void Aura::TriggerSpell()
                 int32 intellectLoss = 0;
                 int32 spiritLoss = 0;
 
-                Unit::AuraList const& mModStat = m_target->GetAurasByType(SPELL_AURA_MOD_STAT);
-                for (Unit::AuraList::const_iterator i = mModStat.begin(); i != mModStat.end(); ++i)
+                Unit::AuraTypeList const& mModStat = m_target->GetAurasByType(SPELL_AURA_MOD_STAT);
+                for (Unit::AuraTypeList::const_iterator i = mModStat.begin(); i != mModStat.end(); ++i)
                 {
                     if ((*i)->GetId() == 1010)
                     {
@@ -3204,8 +3204,8 @@ void Aura::HandleAuraModShapeshift(bool apply, bool Real)
                 {
                     // get furor proc chance
                     uint32 FurorChance = 0;
-                    Unit::AuraList const& mDummy = m_target->GetAurasByType(SPELL_AURA_DUMMY);
-                    for (Unit::AuraList::const_iterator i = mDummy.begin(); i != mDummy.end(); ++i)
+                    Unit::AuraTypeList const& mDummy = m_target->GetAurasByType(SPELL_AURA_DUMMY);
+                    for (Unit::AuraTypeList::const_iterator i = mDummy.begin(); i != mDummy.end(); ++i)
                     {
                         if ((*i)->GetSpellProto()->SpellIconID == 238)
                         {
@@ -3270,7 +3270,7 @@ void Aura::HandleAuraModShapeshift(bool apply, bool Real)
     {
         if (modelid > 0)
         {
-            Unit::AuraList const& otherTransforms = m_target->GetAurasByType(SPELL_AURA_TRANSFORM);
+            Unit::AuraTypeList const& otherTransforms = m_target->GetAurasByType(SPELL_AURA_TRANSFORM);
             if (otherTransforms.empty())
             {
                 m_target->SetDisplayId(m_target->GetNativeDisplayId());
@@ -3280,7 +3280,7 @@ void Aura::HandleAuraModShapeshift(bool apply, bool Real)
             {
                 // look for other transform auras
                 Aura* handledAura = *otherTransforms.begin();
-                for (Unit::AuraList::const_iterator i = otherTransforms.begin();i != otherTransforms.end(); ++i)
+                for (Unit::AuraTypeList::const_iterator i = otherTransforms.begin();i != otherTransforms.end(); ++i)
                 {
                     // negative auras are preferred
                     if (!SpellMgr::IsPositiveSpell((*i)->GetSpellProto()->Id))
@@ -3516,7 +3516,7 @@ void Aura::HandleAuraTransform(bool apply, bool Real)
     }
     else
     {
-        Unit::AuraList const& otherTransforms = m_target->GetAurasByType(SPELL_AURA_TRANSFORM);
+        Unit::AuraTypeList const& otherTransforms = m_target->GetAurasByType(SPELL_AURA_TRANSFORM);
         if (otherTransforms.empty())
         {
             m_target->SetDisplayId(m_target->GetNativeDisplayId());
@@ -3528,7 +3528,7 @@ void Aura::HandleAuraTransform(bool apply, bool Real)
 
             // look for other transform auras
             Aura* handledAura = *otherTransforms.begin();
-            for (Unit::AuraList::const_iterator i = otherTransforms.begin();i != otherTransforms.end(); ++i)
+            for (Unit::AuraTypeList::const_iterator i = otherTransforms.begin();i != otherTransforms.end(); ++i)
             {
                 // negative auras are preferred
                 if (!SpellMgr::IsPositiveSpell((*i)->GetSpellProto()->Id))
@@ -4029,8 +4029,8 @@ void Aura::HandleModStealth(bool apply, bool Real)
     // Master of Subtlety
     if (Real && (apply || !pTarget->HasAuraType(SPELL_AURA_MOD_STEALTH))) // remove only when there are no more stealth auras on a player.
     {
-        Unit::AuraList const& mDummyAuras = pTarget->GetAurasByType(SPELL_AURA_DUMMY);
-        for (Unit::AuraList::const_iterator i = mDummyAuras.begin();i != mDummyAuras.end(); ++i)
+        Unit::AuraTypeList const& mDummyAuras = pTarget->GetAurasByType(SPELL_AURA_DUMMY);
+        for (Unit::AuraTypeList::const_iterator i = mDummyAuras.begin();i != mDummyAuras.end(); ++i)
         {
             if ((*i)->GetSpellProto()->SpellIconID == 2114)
             {
@@ -4071,8 +4071,8 @@ void Aura::HandleInvisibility(bool apply, bool Real)
     {
         // recalculate value at modifier remove (current aura already removed)
         m_target->m_invisibilityMask = 0;
-        Unit::AuraList const& auras = m_target->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
-        for (Unit::AuraList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+        Unit::AuraTypeList const& auras = m_target->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
+        for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
             m_target->m_invisibilityMask |= (1 << m_modifier.m_miscvalue);
 
         // only at real aura remove and if not have different invisibility auras.
@@ -4107,8 +4107,8 @@ void Aura::HandleInvisibilityDetect(bool apply, bool Real)
     {
         // recalculate value at modifier remove (current aura already removed)
         m_target->m_detectInvisibilityMask = 0;
-        Unit::AuraList const& auras = m_target->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY_DETECTION);
-        for (Unit::AuraList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+        Unit::AuraTypeList const& auras = m_target->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY_DETECTION);
+        for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
             m_target->m_detectInvisibilityMask |= (1 << m_modifier.m_miscvalue);
     }
 
@@ -4196,8 +4196,8 @@ void Aura::HandleModThreat(bool apply, bool Real)
                 if (!apply && !m_target->m_threatModifier[x])
                 {
                     m_target->m_threatModifier[x] = 1.0f;
-                    Unit::AuraList const& threatAuras = m_target->GetAurasByType(SPELL_AURA_MOD_THREAT);
-                    for (Unit::AuraList::const_iterator i = threatAuras.begin();i != threatAuras.end(); ++i)
+                    Unit::AuraTypeList const& threatAuras = m_target->GetAurasByType(SPELL_AURA_MOD_THREAT);
+                    for (Unit::AuraTypeList::const_iterator i = threatAuras.begin();i != threatAuras.end(); ++i)
                     {
                         if ((*i)->GetModifier()->m_miscvalue & int32(1<<x) && (*i) != this)
                             ApplyPercentModFloatVar(m_target->m_threatModifier[x], (*i)->GetModifier()->m_amount, !apply);
@@ -4256,7 +4256,8 @@ void Aura::HandleModTaunt(bool apply, bool Real)
         m_target->TauntApply(caster);
     else
     {
-        std::list<Aura*> taunts =  m_target->GetAurasByType(SPELL_AURA_MOD_TAUNT);
+        Unit::AuraTypeList const& tauntsByType = m_target->GetAurasByType(SPELL_AURA_MOD_TAUNT);
+        std::list<Aura*> taunts(tauntsByType.begin(), tauntsByType.end());
         if (taunts.empty())
             m_target->TauntFadeOut(caster);
         else
@@ -4545,7 +4546,8 @@ void Aura::HandleModMechanicImmunity(bool apply, bool Real)
 
     if (!apply)
     {
-        Unit::AuraList mAuras = m_target->GetAurasByType(SPELL_AURA_MECHANIC_IMMUNITY);
+        Unit::AuraTypeList const& mAurasByType = m_target->GetAurasByType(SPELL_AURA_MECHANIC_IMMUNITY);
+        Unit::AuraList mAuras(mAurasByType.begin(), mAurasByType.end());
         for (Unit::AuraList::iterator iter = mAuras.begin(); iter != mAuras.end(); ++iter)
         {
             if ((*iter)->GetMiscValue() == GetMiscValue())
@@ -4578,8 +4580,8 @@ void Aura::HandleModMechanicImmunity(bool apply, bool Real)
         if (Unit* owner = m_target->GetOwner())
         {
             // Search talent
-            Unit::AuraList const& m_dummyAuras = owner->GetAurasByType(SPELL_AURA_DUMMY);
-            for (Unit::AuraList::const_iterator i = m_dummyAuras.begin(); i != m_dummyAuras.end(); ++i)
+            Unit::AuraTypeList const& m_dummyAuras = owner->GetAurasByType(SPELL_AURA_DUMMY);
+            for (Unit::AuraTypeList::const_iterator i = m_dummyAuras.begin(); i != m_dummyAuras.end(); ++i)
             {
                 if ((*i)->GetSpellProto()->SpellIconID == 2229)
                 {
@@ -4661,8 +4663,8 @@ void Aura::HandleAuraModStateImmunity(bool apply, bool Real)
 {
     if (apply && Real && GetSpellProto()->AttributesEx & SPELL_ATTR_EX_DISPEL_AURAS_ON_IMMUNITY)
     {
-        Unit::AuraList const& auraList = m_target->GetAurasByType(AuraType(m_modifier.m_miscvalue));
-        for (Unit::AuraList::const_iterator itr = auraList.begin(); itr != auraList.end();)
+        Unit::AuraTypeList const& auraList = m_target->GetAurasByType(AuraType(m_modifier.m_miscvalue));
+        for (Unit::AuraTypeList::const_iterator itr = auraList.begin(); itr != auraList.end();)
         {
             if (auraList.front() != this)                   // skip itself aura (it already added)
             {
@@ -4944,8 +4946,8 @@ void Aura::HandlePeriodicHeal(bool apply, bool Real)
                 {
                     if (Unit* caster = GetCaster())
                     {
-                        Unit::AuraList const& classScripts = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                        for (Unit::AuraList::const_iterator k = classScripts.begin(); k != classScripts.end(); ++k)
+                        Unit::AuraTypeList const& classScripts = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                        for (Unit::AuraTypeList::const_iterator k = classScripts.begin(); k != classScripts.end(); ++k)
                         {
                             int32 tickcount = SpellMgr::GetSpellDuration(m_spellProto) / m_spellProto->EffectAmplitude[m_effIndex];
                             switch ((*k)->GetModifier()->m_miscvalue)
@@ -5100,8 +5102,8 @@ void Aura::HandlePeriodicDamage(bool apply, bool Real)
                     uint8 cp = ((Player*)caster)->GetComboPoints();
 
                     // Idol of Feral Shadows. Cant be handled as SpellMod in SpellAura:Dummy due its dependency from CPs
-                    Unit::AuraList const& dummyAuras = caster->GetAurasByType(SPELL_AURA_DUMMY);
-                    for (Unit::AuraList::const_iterator itr = dummyAuras.begin(); itr != dummyAuras.end(); ++itr)
+                    Unit::AuraTypeList const& dummyAuras = caster->GetAurasByType(SPELL_AURA_DUMMY);
+                    for (Unit::AuraTypeList::const_iterator itr = dummyAuras.begin(); itr != dummyAuras.end(); ++itr)
                     {
                         if ((*itr)->GetId()==34241)
                         {
@@ -5132,8 +5134,8 @@ void Aura::HandlePeriodicDamage(bool apply, bool Real)
                 {
                     // current aura already removed, search present of another
                     bool found = false;
-                    Unit::AuraList const& auras = m_target->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                    for (Unit::AuraList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+                    Unit::AuraTypeList const& auras = m_target->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                    for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
                     {
                         SpellEntry const* itr_spell = (*itr)->GetSpellProto();
                         if (itr_spell && itr_spell->SpellFamilyName==SPELLFAMILY_ROGUE && (itr_spell->SpellFamilyFlags & 0x10000) && itr_spell->SpellVisual==5100)
@@ -5217,8 +5219,8 @@ void Aura::HandlePeriodicDamage(bool apply, bool Real)
                 {
                     if (Unit* caster = GetCaster())
                     {
-                        Unit::AuraList const& classScripts = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                        for (Unit::AuraList::const_iterator k = classScripts.begin(); k != classScripts.end(); ++k)
+                        Unit::AuraTypeList const& classScripts = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                        for (Unit::AuraTypeList::const_iterator k = classScripts.begin(); k != classScripts.end(); ++k)
                         {
                             int32 tickcount = SpellMgr::GetSpellDuration(m_spellProto) / m_spellProto->EffectAmplitude[m_effIndex];
                             switch ((*k)->GetModifier()->m_miscvalue)
@@ -5297,7 +5299,8 @@ void Aura::HandleAuraModResistanceExclusive(bool apply, bool Real)
         if (m_modifier.m_miscvalue & int32(1<<x))
         {
             float maxModifier = 0;
-            Unit::AuraList auraResistanceExclusive = m_target->GetAurasByType(SPELL_AURA_MOD_RESISTANCE_EXCLUSIVE);
+            Unit::AuraTypeList const& auraResistanceExclusiveByType = m_target->GetAurasByType(SPELL_AURA_MOD_RESISTANCE_EXCLUSIVE);
+            Unit::AuraList auraResistanceExclusive(auraResistanceExclusiveByType.begin(), auraResistanceExclusiveByType.end());
             for (Unit::AuraList::iterator it = auraResistanceExclusive.begin(); it != auraResistanceExclusive.end(); it++)
             {
                 if (*it != this && ((*it)->GetMiscValue() & int32(1<<x)) && (*it)->GetModifierValue() > maxModifier)
@@ -6318,8 +6321,8 @@ void Aura::HandleShapeshiftBoosts(bool apply)
             // HotW
             if (HotWSpellId)
             {
-                Unit::AuraList const& mModTotalStatPct = m_target->GetAurasByType(SPELL_AURA_MOD_TOTAL_STAT_PERCENTAGE);
-                for (Unit::AuraList::const_iterator i = mModTotalStatPct.begin(); i != mModTotalStatPct.end(); ++i)
+                Unit::AuraTypeList const& mModTotalStatPct = m_target->GetAurasByType(SPELL_AURA_MOD_TOTAL_STAT_PERCENTAGE);
+                for (Unit::AuraTypeList::const_iterator i = mModTotalStatPct.begin(); i != mModTotalStatPct.end(); ++i)
                 {
                     if ((*i)->GetSpellProto()->SpellIconID == 240 && (*i)->GetModifier()->m_miscvalue == 3)
                     {
@@ -6713,8 +6716,8 @@ void Aura::PeriodicTick()
                     }
                     case 41337:// aura of anger
                     {
-                        Unit::AuraList const& mMod = m_target->GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
-                        for (Unit::AuraList::const_iterator i = mMod.begin(); i != mMod.end(); ++i)
+                        Unit::AuraTypeList const& mMod = m_target->GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
+                        for (Unit::AuraTypeList::const_iterator i = mMod.begin(); i != mMod.end(); ++i)
                         {
                             if ((*i)->GetId() == 41337)
                             {
@@ -6925,8 +6928,8 @@ void Aura::PeriodicTick()
             if (GetSpellProto()->SpellFamilyName == SPELLFAMILY_WARLOCK && (GetSpellProto()->SpellFamilyFlags & 0x8))
             {
                 // find talent max bonus percentage
-                Unit::AuraList const& mClassScriptAuras = pCaster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                for (Unit::AuraList::const_iterator i = mClassScriptAuras.begin(); i != mClassScriptAuras.end(); ++i)
+                Unit::AuraTypeList const& mClassScriptAuras = pCaster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                for (Unit::AuraTypeList::const_iterator i = mClassScriptAuras.begin(); i != mClassScriptAuras.end(); ++i)
                 {
                     if ((*i)->GetModifier()->m_miscvalue == 4992 || (*i)->GetModifier()->m_miscvalue == 4993)
                     {
@@ -7369,8 +7372,8 @@ void Aura::PeriodicDummyTick()
             if (m_target->GetTypeId() != TYPEID_PLAYER)
                 return;
             // Search SPELL_AURA_MOD_POWER_REGEN aura for this spell and add bonus
-            Unit::AuraList const& aura = m_target->GetAurasByType(SPELL_AURA_MOD_POWER_REGEN);
-            for (Unit::AuraList::const_iterator i = aura.begin(); i != aura.end(); ++i)
+            Unit::AuraTypeList const& aura = m_target->GetAurasByType(SPELL_AURA_MOD_POWER_REGEN);
+            for (Unit::AuraTypeList::const_iterator i = aura.begin(); i != aura.end(); ++i)
             {
                 if ((*i)->GetId() == GetId())
                 {
@@ -7679,7 +7682,8 @@ void Aura::HandlePreventFleeing(bool apply, bool Real)
     
     if (!apply)
     {
-        Unit::AuraList list = target->GetAurasByType(SPELL_AURA_MOD_FEAR);
+        Unit::AuraTypeList const& listByType = target->GetAurasByType(SPELL_AURA_MOD_FEAR);
+        Unit::AuraList list(listByType.begin(), listByType.end());
         if (list.empty())
             return;
 
@@ -7781,7 +7785,8 @@ void Aura::HandleAuraMeleeAPAttackerBonus(bool apply, bool Real)
         {
             if (Unit* caster = GetCaster())
             {
-                Unit::AuraList overrideClassScriptAuras = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                Unit::AuraTypeList const& overrideClassScriptAurasByType = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                Unit::AuraList overrideClassScriptAuras(overrideClassScriptAurasByType.begin(), overrideClassScriptAurasByType.end());
                 for (Unit::AuraList::iterator i = overrideClassScriptAuras.begin(); i != overrideClassScriptAuras.end();)
                 {
                     switch ((*i)->GetSpellProto()->Id)
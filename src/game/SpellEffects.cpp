@@ -487,8 +487,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                     if (m_caster->HasAura(37384, 0))
                     {
                         // look for immolate cast by m_caster
-                        Unit::AuraList const &mPeriodic = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                        for (Unit::AuraList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
+                        Unit::AuraTypeList const &mPeriodic = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                        for (Unit::AuraTypeList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
                         {
                             if ((*i)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_WARLOCK && ((*i)->GetSpellProto()->SpellFamilyFlags & 4) &&
                                 (*i)->GetCasterGUID()==m_caster->GetGUID())
@@ -514,8 +514,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                     if (m_caster->HasAura(37384, 0))
                     {
                         // look for corruption cast by m_caster
-                        Unit::AuraList const &mPeriodic = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                        for (Unit::AuraList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
+                        Unit::AuraTypeList const &mPeriodic = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                        for (Unit::AuraTypeList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
                         {
                             if ((*i)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_WARLOCK && ((*i)->GetSpellProto()->SpellFamilyFlags & 2) &&
                                 (*i)->GetCasterGUID()==m_caster->GetGUID())
@@ -531,8 +531,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                 if (spellInfo->TargetAuraState == AURA_STATE_IMMOLATE)
                 {
                     // for caster applied auras only
-                    Unit::AuraList const &mPeriodic = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                    for (Unit::AuraList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
+                    Unit::AuraTypeList const &mPeriodic = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                    for (Unit::AuraTypeList::const_iterator i = mPeriodic.begin(); i != mPeriodic.end(); ++i)
                     {
                         if ((*i)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_WARLOCK && ((*i)->GetSpellProto()->SpellFamilyFlags & 4) &&
                             (*i)->GetCasterGUID()==m_caster->GetGUID())
@@ -568,16 +568,16 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                 // Starfire
                 else if (spellInfo->SpellFamilyFlags & 0x0004LL)
                 {
-                    Unit::AuraList const& m_OverrideClassScript = m_caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                    for (Unit::AuraList::const_iterator i = m_OverrideClassScript.begin(); i != m_OverrideClassScript.end(); ++i)
+                    Unit::AuraTypeList const& m_OverrideClassScript = m_caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                    for (Unit::AuraTypeList::const_iterator i = m_OverrideClassScript.begin(); i != m_OverrideClassScript.end(); ++i)
                     {
                         // Starfire Bonus (caster)
                         switch ((*i)->GetModifier()->m_miscvalue)
                         {
                             case 5481:                      // Nordrassil Regalia - bonus
                             {
-                                Unit::AuraList const& m_periodicDamageAuras = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                                for (Unit::AuraList::const_iterator itr = m_periodicDamageAuras.begin(); itr != m_periodicDamageAuras.end(); ++itr)
+                                Unit::AuraTypeList const& m_periodicDamageAuras = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                                for (Unit::AuraTypeList::const_iterator itr = m_periodicDamageAuras.begin(); itr != m_periodicDamageAuras.end(); ++itr)
                                 {
                                     // Moonfire or Insect Swarm (target debuff from any casters)
                                     if ((*itr)->GetSpellProto()->SpellFamilyFlags & 0x00200002LL)
@@ -600,8 +600,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                 if ((spellInfo->SpellFamilyFlags==0x0000000000001000LL && spellInfo->SpellIconID==494) ||
                     (spellInfo->SpellFamilyFlags==0x0000010000000000LL && spellInfo->SpellIconID==2246))
                 {
-                    Unit::AuraList const& mDummyAuras = unitTarget->GetAurasByType(SPELL_AURA_DUMMY);
-                    for (Unit::AuraList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
+                    Unit::AuraTypeList const& mDummyAuras = unitTarget->GetAurasByType(SPELL_AURA_DUMMY);
+                    for (Unit::AuraTypeList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
                         if ((*i)->GetSpellProto()->SpellFamilyFlags & 0x0000044000000000LL && (*i)->GetSpellProto()->SpellFamilyName==SPELLFAMILY_DRUID)
                         {
                             totalDmgModPct *= 1 + (*i)->GetModifierValue() / 100.0f;
@@ -625,8 +625,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                         uint32 doses = 0;
 
                         // remove consumed poison doses
-                        Unit::AuraList const& auras = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                        for (Unit::AuraList::const_iterator itr = auras.begin(); itr!=auras.end() && combo;)
+                        Unit::AuraTypeList const& auras = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                        for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr!=auras.end() && combo;)
                         {
                             // Deadly poison (only attacker applied)
                             if ((*itr)->GetSpellProto()->SpellFamilyName==SPELLFAMILY_ROGUE && ((*itr)->GetSpellProto()->SpellFamilyFlags & 0x10000) &&
@@ -687,8 +687,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                     bool found = false;
 
                     // check dazed affect
-                    Unit::AuraList const& decSpeedList = unitTarget->GetAurasByType(SPELL_AURA_MOD_DECREASE_SPEED);
-                    for (Unit::AuraList::const_iterator iter = decSpeedList.begin(); iter != decSpeedList.end(); ++iter)
+                    Unit::AuraTypeList const& decSpeedList = unitTarget->GetAurasByType(SPELL_AURA_MOD_DECREASE_SPEED);
+                    for (Unit::AuraTypeList::const_iterator iter = decSpeedList.begin(); iter != decSpeedList.end(); ++iter)
                     {
                         if ((*iter)->GetSpellProto()->SpellIconID==15 && (*iter)->GetSpellProto()->Dispel==0)
                         {
@@ -714,8 +714,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                 if ((spellInfo->SpellFamilyFlags & 0x800000000LL) && spellInfo->SpellIconID==2292 && spellInfo->Id != 42463)
                 {
                     uint32 stacks = 0;
-                    Unit::AuraList const& auras = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                    for (Unit::AuraList::const_iterator itr = auras.begin(); itr!=auras.end(); ++itr)
+                    Unit::AuraTypeList const& auras = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                    for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr!=auras.end(); ++itr)
                         if ((*itr)->GetId() == 31803 && (*itr)->GetCasterGUID()==m_caster->GetGUID())
                         {
                             stacks = (*itr)->GetStackAmount();
@@ -736,8 +736,8 @@ void Spell::SpellDamageSchoolDmg(uint32 effect_idx)
                 if (spellInfo->SpellFamilyFlags & 0x0003LL)
                 {
                     bool stop = false;
-                    Unit::AuraList const& auras = m_caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                    for (Unit::AuraList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+                    Unit::AuraTypeList const& auras = m_caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                    for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
                     {
                         switch ((*itr)->GetId())
                         {
@@ -2159,8 +2159,8 @@ void Spell::EffectDummy(uint32 i)
 
                     int32 mana = dmg;
 
-                    Unit::AuraList const& auraDummy = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
-                    for (Unit::AuraList::const_iterator itr = auraDummy.begin(); itr != auraDummy.end(); ++itr)
+                    Unit::AuraTypeList const& auraDummy = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
+                    for (Unit::AuraTypeList::const_iterator itr = auraDummy.begin(); itr != auraDummy.end(); ++itr)
                     {
                         // only Imp. Life Tap have this in combination with dummy aura
                         if ((*itr)->GetSpellProto()->SpellFamilyName==SPELLFAMILY_WARLOCK && (*itr)->GetSpellProto()->SpellIconID == 208)
@@ -2269,7 +2269,8 @@ void Spell::EffectDummy(uint32 i)
                 case 5171:
                 case 6774:
                 {
-                    Unit::AuraList procTriggerAuras = m_caster->GetAurasByType(SPELL_AURA_PROC_TRIGGER_SPELL);
+                    Unit::AuraTypeList const& procTriggerAurasByType = m_caster->GetAurasByType(SPELL_AURA_PROC_TRIGGER_SPELL);
+                    Unit::AuraList procTriggerAuras(procTriggerAurasByType.begin(), procTriggerAurasByType.end());
                     for (Unit::AuraList::iterator i = procTriggerAuras.begin(); i != procTriggerAuras.end(); i++)
                     {
                         switch ((*i)->GetSpellProto()->Id)
@@ -3496,8 +3497,8 @@ void Spell::SpellDamageHeal(uint32 /*i*/)
         {
             // Amount of heal - depends from stacked Holy Energy
             int damageAmount = 0;
-            Unit::AuraList const& mDummyAuras = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
-            for (Unit::AuraList::const_iterator i = mDummyAuras.begin();i != mDummyAuras.end(); ++i)
+            Unit::AuraTypeList const& mDummyAuras = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
+            for (Unit::AuraTypeList::const_iterator i = mDummyAuras.begin();i != mDummyAuras.end(); ++i)
                 if ((*i)->GetId() == 45062)
                     damageAmount+=(*i)->GetModifierValue();
             if (damageAmount)
@@ -3508,10 +3509,10 @@ void Spell::SpellDamageHeal(uint32 /*i*/)
         // Swiftmend - consumes Regrowth or Rejuvenation
         else if (GetSpellEntry()->TargetAuraState == AURA_STATE_SWIFTMEND && unitTarget->HasAuraState(AURA_STATE_SWIFTMEND))
         {
-            Unit::AuraList const& RejorRegr = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_HEAL);
+            Unit::AuraTypeList const& RejorRegr = unitTarget->GetAurasByType(SPELL_AURA_PERIODIC_HEAL);
             // find most short by duration
             Aura *targetAura = NULL;
-            for (Unit::AuraList::const_iterator i = RejorRegr.begin(); i != RejorRegr.end(); ++i)
+            for (Unit::AuraTypeList::const_iterator i = RejorRegr.begin(); i != RejorRegr.end(); ++i)
             {
                 if ((*i)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_DRUID
                     && ((*i)->GetSpellProto()->SpellFamilyFlags == 0x40 || (*i)->GetSpellProto()->SpellFamilyFlags == 0x10))
@@ -5242,8 +5243,8 @@ void Spell::SpellDamageWeaponDmg(uint32 i)
                     case 29707:
                     case 30324:
                     {
-                        Unit::AuraList const& decSpeedList = unitTarget->GetAurasByType(SPELL_AURA_MOD_DECREASE_SPEED);
-                        for (Unit::AuraList::const_iterator iter = decSpeedList.begin(); iter != decSpeedList.end(); ++iter)
+                        Unit::AuraTypeList const& decSpeedList = unitTarget->GetAurasByType(SPELL_AURA_MOD_DECREASE_SPEED);
+                        for (Unit::AuraTypeList::const_iterator iter = decSpeedList.begin(); iter != decSpeedList.end(); ++iter)
                         {
                             if ((*iter)->GetSpellProto()->SpellIconID == 15 && (*iter)->GetSpellProto()->Dispel == 0)
                             {
@@ -5261,8 +5262,8 @@ void Spell::SpellDamageWeaponDmg(uint32 i)
             {
                 uint32 stack = 0;
 
-                Unit::AuraList const& list = unitTarget->GetAurasByType(SPELL_AURA_MOD_RESISTANCE);
-                for (Unit::AuraList::const_iterator itr=list.begin();itr!=list.end();++itr)
+                Unit::AuraTypeList const& list = unitTarget->GetAurasByType(SPELL_AURA_MOD_RESISTANCE);
+                for (Unit::AuraTypeList::const_iterator itr=list.begin();itr!=list.end();++itr)
                 {
                     SpellEntry const *proto = (*itr)->GetSpellProto();
                     if (proto->SpellFamilyName == SPELLFAMILY_WARRIOR
@@ -5350,8 +5351,8 @@ void Spell::SpellDamageWeaponDmg(uint32 i)
             // Stormstrike
             if (GetSpellEntry()->SpellFamilyFlags & 0x001000000000LL)
             {
-                Unit::AuraList const& m_OverrideClassScript = m_caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                for (Unit::AuraList::const_iterator citr = m_OverrideClassScript.begin(); citr != m_OverrideClassScript.end(); ++citr)
+                Unit::AuraTypeList const& m_OverrideClassScript = m_caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                for (Unit::AuraTypeList::const_iterator citr = m_OverrideClassScript.begin(); citr != m_OverrideClassScript.end(); ++citr)
                 {
                     // Stormstrike AP Buff
                     if ((*citr)->GetModifier()->m_miscvalue == 5634)
@@ -6796,8 +6797,8 @@ void Spell::EffectScriptEffect(uint32 effIndex)
                 uint32 spellId2 = 0;
 
                 // all seals have aura dummy
-                Unit::AuraList const& m_dummyAuras = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
-                for (Unit::AuraList::const_iterator itr = m_dummyAuras.begin(); itr != m_dummyAuras.end(); ++itr)
+                Unit::AuraTypeList const& m_dummyAuras = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
+                for (Unit::AuraTypeList::const_iterator itr = m_dummyAuras.begin(); itr != m_dummyAuras.end(); ++itr)
                 {
                     SpellEntry const *spellInfo = (*itr)->GetSpellProto();
 
@@ -6815,8 +6816,8 @@ void Spell::EffectScriptEffect(uint32 effIndex)
                     m_caster->RemoveAurasDueToSpell((*itr)->GetId());
 
                     // Sanctified Judgement
-                    Unit::AuraList const& m_auras = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
-                    for (Unit::AuraList::const_iterator i = m_auras.begin(); i != m_auras.end(); ++i)
+                    Unit::AuraTypeList const& m_auras = m_caster->GetAurasByType(SPELL_AURA_DUMMY);
+                    for (Unit::AuraTypeList::const_iterator i = m_auras.begin(); i != m_auras.end(); ++i)
                     {
                         if ((*i)->GetSpellProto()->SpellIconID == 205 && (*i)->GetSpellProto()->Attributes == 0x01D0LL)
                         {
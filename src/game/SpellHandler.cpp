@@ -499,7 +499,7 @@ void WorldSession::HandleGetMirrorimageData(WorldPacket& recv_data)
     if (!pCreature)
         return;
 
-    Unit::AuraList const& images = pCreature->GetAurasByType(SPELL_AURA_MIRROR_IMAGE);
+    Unit::AuraTypeList const& images = pCreature->GetAurasByType(SPELL_AURA_MIRROR_IMAGE);
 
     if (images.empty())
         return;
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2008-2017 Hellground <http://wow-hellground.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "StartupLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+
+// loaders query these databases, each thread gets its own connection to them
+// so tasks don't queue on the shared sync pool (one connection by default)
+static Database* const StartupLoadDatabases[] = { &GameDataDatabase, &RealmDataDatabase, &AccountsDatabase };
+static const uint32 StartupLoadDatabasesCount = sizeof(StartupLoadDatabases) / sizeof(Database*);
+
+class StartupLoadThreadStart : public ACE_Method_Request
+{
+    public:
+        virtual int call(void)
+        {
+            GameDataDatabase.ThreadStart();
+            for (uint32 i = 0; i < StartupLoadDatabasesCount; ++i)
+                if (!StartupLoadDatabases[i]->OpenThreadConnection())
+                    sLog.outLog(LOG_DEFAULT, "ERROR: StartupLoader: unable to open thread database connection, using shared pool");
+            return 0;
+        }
+};
+
+class StartupLoadThreadEnd : public ACE_Method_Request
+{
+    public:
+        virtual int call(void)
+        {
+            for (uint32 i = 0; i < StartupLoadDatabasesCount; ++i)
+                StartupLoadDatabases[i]->CloseThreadConnection();
+            GameDataDatabase.ThreadEnd();
+            return 0;
+        }
+};
+
+class StartupLoadRequest : public ACE_Method_Request
+{
+    public:
+        // tasks added first have higher priority, so free threads follow the sequential order
+        StartupLoadRequest(StartupLoader& loader, uint32 task)
+            : ACE_Method_Request(loader.m_tasks.size() - task), m_loader(loader), m_task(task) {}
+
+        virtual int call(void)
+        {
+            uint32 startTime = WorldTimer::getMSTime();
+            m_loader.m_tasks[m_task].function();
+            m_loader.TaskDone(m_task, WorldTimer::getMSTimeDiffToNow(startTime));
+            return 0;
+        }
+
+    private:
+        StartupLoader& m_loader;
+        uint32 m_task;
+};
+
+StartupLoader::StartupLoader() : m_barrier(0), m_totalTime(0), m_mutex(), m_condition(m_mutex), m_pending(0)
+{
+}
+
+uint32 StartupLoader::FindTask(char const* name) const
+{
+    for (uint32 i = 0; i < m_tasks.size(); ++i)
+        if (m_tasks[i].name == name)
+            return i;
+
+    sLog.outLog(LOG_DEFAULT, "ERROR: StartupLoader: dependency %s is not added before its dependents", name);
+    ASSERT(false);
+    return 0;
+}
+
+void StartupLoader::AddDependency(uint32 task, uint32 dependency)
+{
+    m_tasks[dependency].dependents.push_back(task);
+    ++m_tasks[task].dependencies;
+}
+
+void StartupLoader::AddTask(char const* name, LoadFunction function, std::initializer_list<char const*> dependencies)
+{
+    Task task;
+    task.name = name;
+    task.function = function;
+    task.dependencies = 0;
+    task.time = 0;
+    m_tasks.push_back(task);
+
+    uint32 index = m_tasks.size() - 1;
+    if (m_barrier)
+        AddDependency(index, m_barrier - 1);
+
+    for (std::initializer_list<char const*>::const_iterator itr = dependencies.begin(); itr != dependencies.end(); ++itr)
+    {
+        uint32 dependency = FindTask(*itr);
+        if (!m_barrier || dependency >= m_barrier)
+            AddDependency(index, dependency);
+    }
+}
+
+void StartupLoader::AddBarrier(char const* name, LoadFunction function)
+{
+    AddTask(name, function);
+
+    uint32 index = m_tasks.size() - 1;
+    for (uint32 i = m_barrier; i < index; ++i)
+        AddDependency(index, i);
+
+    m_barrier = index + 1;
+}
+
+void StartupLoader::Schedule(uint32 task)
+{
+    if (m_executor.execute(new StartupLoadRequest(*this, task)) == -1)
+    {
+        sLog.outLog(LOG_DEFAULT, "ERROR: StartupLoader: unable to queue task %s", m_tasks[task].name.c_str());
+        ASSERT(false);
+    }
+}
+
+void StartupLoader::TaskDone(uint32 task, uint32 time)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    m_tasks[task].time = time;
+    for (std::vector<uint32>::const_iterator itr = m_tasks[task].dependents.begin(); itr != m_tasks[task].dependents.end(); ++itr)
+    {
+        if (!--m_tasks[*itr].dependencies)
+            Schedule(*itr);
+    }
+
+    if (!--m_pending)
+        m_condition.broadcast();
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    if (threads <= 1)
+    {
+        // dependencies are always added first, so added order is valid
+        for (std::vector<Task>::iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        {
+            uint32 taskTime = WorldTimer::getMSTime();
+            itr->function();
+            itr->time = WorldTimer::getMSTimeDiffToNow(taskTime);
+        }
+    }
+    else
+    {
+        sLog.outString("Running startup loaders on %u threads...", threads);
+
+        m_executor.activate(threads, new StartupLoadThreadStart, new StartupLoadThreadEnd);
+
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+            m_pending = m_tasks.size();
+            for (uint32 i = 0; i < m_tasks.size(); ++i)
+                if (!m_tasks[i].dependencies)
+                    Schedule(i);
+
+            while (m_pending)
+                m_condition.wait();
+        }
+
+        m_executor.deactivate();
+    }
+
+    m_totalTime = WorldTimer::getMSTimeDiffToNow(startTime);
+}
+
+void StartupLoader::PrintTimes() const
+{
+    std::vector<Task const*> tasks;
+    uint32 sumTime = 0;
+    for (std::vector<Task>::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+    {
+        tasks.push_back(&*itr);
+        sumTime += itr->time;
+    }
+
+    std::stable_sort(tasks.begin(), tasks.end(), [](Task const* a, Task const* b) { return a->time > b->time; });
+
+    sLog.outString();
+    sLog.outString("Startup loaders: %u tasks, %u ms total, %u ms sum of tasks", uint32(m_tasks.size()), m_totalTime, sumTime);
+    for (std::vector<Task const*>::const_iterator itr = tasks.begin(); itr != tasks.end(); ++itr)
+        sLog.outString("%8u ms  %s", (*itr)->time, (*itr)->name.c_str());
+    sLog.outString();
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2008-2017 Hellground <http://wow-hellground.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef HELLGROUND_STARTUPLOADER_H
+#define HELLGROUND_STARTUPLOADER_H
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "DelayExecutor.h"
+#include "Common.h"
+
+#include <functional>
+#include <initializer_list>
+
+/// Startup data loaders declared with the loaders they need to run after.
+/// With one thread tasks run in the order they were added, with more
+/// threads every task is started as soon as all its dependencies are done.
+class StartupLoader
+{
+    public:
+        typedef std::function<void()> LoadFunction;
+
+        StartupLoader();
+
+        /// dependencies must be names of tasks added before
+        void AddTask(char const* name, LoadFunction function, std::initializer_list<char const*> dependencies = {});
+
+        /// task running alone: waits for all tasks added before it, all tasks added after wait for it
+        void AddBarrier(char const* name, LoadFunction function);
+
+        void Run(uint32 threads);
+
+        /// time of each task, longest first
+        void PrintTimes() const;
+
+    private:
+        friend class StartupLoadRequest;
+
+        struct Task
+        {
+            std::string name;
+            LoadFunction function;
+            std::vector<uint32> dependents;
+            uint32 dependencies;                            // count of dependencies not done yet
+            uint32 time;
+        };
+
+        uint32 FindTask(char const* name) const;
+        void AddDependency(uint32 task, uint32 dependency);
+        void Schedule(uint32 task);
+        void TaskDone(uint32 task, uint32 time);
+
+        std::vector<Task> m_tasks;
+        uint32 m_barrier;                                   // index of last barrier + 1, 0 if none
+        uint32 m_totalTime;
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        uint32 m_pending;
+};
+
+#endif
@@ -39,6 +39,10 @@ void TargetedMovementGeneratorMedium<T,D>::_setTargetLocation(T &owner)
     if (!_target.isValid() || !_target->IsInWorld())
         return;
 
+    // path to previous target location is still searched, new search starts after it is applied
+    if (_pathSearch)
+        return;
+
     float x, y, z;
     bool targetIsVictim = owner.getVictimGUID() == _target->GetGUID();
 
@@ -91,11 +95,50 @@ void TargetedMovementGeneratorMedium<T,D>::_setTargetLocation(T &owner)
 
     // allow pets following their master to cheat while generating paths
     bool forceDest = (owner.GetObjectGuid().IsPet() && owner.HasUnitState(UNIT_STAT_FOLLOW));
-    bool result = _path->calculate(x, y, z, forceDest);
+    bool result;
+
+    bool moving = !owner.IsStopped() && _path->getPathType() != PATHFIND_BLANK && owner.GetTerrain()->IsPathFindingEnabled();
+    if (moving && sWorld.getConfig(CONFIG_MMAP_PATH_THREADS))
+    {
+        // keep moving on current spline, Update applies the path when path worker is done
+        _pathSearch = _path->calculateAsync(x, y, z, forceDest, result);
+        if (_pathSearch)
+            return;
+    }
+    else if (moving && !owner.GetMap()->TakeRepathBudget())
+    {
+        // map spent its path searches for this update, keep moving on current spline and retry at next update
+        static_cast<MovementGenerator*>(this)->_recalculateTravel = true;
+        return;
+    }
+    else
+        result = _path->calculate(x, y, z, forceDest);
+
+    _moveByPath(owner, result, forceDest);
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T,D>::_applyPathSearch(T &owner)
+{
+    delete _path;
+    _path = _pathSearch->TakePath();
+    _pathSearch->Release();
+    _pathSearch = NULL;
+
+    bool forceDest = (owner.GetObjectGuid().IsPet() && owner.HasUnitState(UNIT_STAT_FOLLOW));
+    _moveByPath(owner, true, forceDest);
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T,D>::_moveByPath(T &owner, bool result, bool forceDest)
+{
     //if (!result || _path->getPathType() & PATHFIND_NOPATH)
     //    return;
     if (!forceDest && _path->getPathType() & PATHFIND_NOPATH)
-        result = _path->calculate(x, y, z, true);
+    {
+        Vector3 dest = _path->getEndPosition();
+        result = _path->calculate(dest.x, dest.y, dest.z, true);
+    }
     if (!result)
         return;
 
@@ -148,6 +191,9 @@ bool TargetedMovementGeneratorMedium<T,D>::Update(T &owner, const uint32 & time_
     if (static_cast<D*>(this)->_lostTarget(owner))
         return true;
 
+    if (_pathSearch && _pathSearch->IsDone())
+        _applyPathSearch(owner);
+
     _recheckDistance.Update(time_diff);
     if (_recheckDistance.Passed())
     {
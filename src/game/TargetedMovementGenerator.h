@@ -47,10 +47,16 @@ class TargetedMovementGeneratorMedium
         TargetedMovementGeneratorMedium(Unit &target, float offset, float angle) :
             TargetedMovementGeneratorBase(target), _offset(offset), _angle(angle),
             _targetReached(false), _recheckDistance(0),
-            _path(NULL), m_fTargetLastX(0), m_fTargetLastY(0), m_fTargetLastZ(0)
+            _path(NULL), _pathSearch(NULL), m_fTargetLastX(0), m_fTargetLastY(0), m_fTargetLastZ(0)
         {
         }
-        ~TargetedMovementGeneratorMedium() { delete _path; }
+        ~TargetedMovementGeneratorMedium()
+        {
+            if (_pathSearch)
+                _pathSearch->Release();
+
+            delete _path;
+        }
 
     public:
         bool Update(T &, const uint32 &);
@@ -66,6 +72,8 @@ class TargetedMovementGeneratorMedium
 
     protected:
         void _setTargetLocation(T &);
+        void _applyPathSearch(T &);
+        void _moveByPath(T &, bool result, bool forceDest);
 
         TimeTracker _recheckDistance;
         float _offset;
@@ -73,6 +81,7 @@ class TargetedMovementGeneratorMedium
         bool _targetReached : 1;
 
         PathFinder* _path;
+        PathSearch* _pathSearch;                            // searched by path worker, unit keeps its spline until done
         float m_fTargetLastX;
         float m_fTargetLastY;
         float m_fTargetLastZ;
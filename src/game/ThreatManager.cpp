@@ -61,6 +61,8 @@ HostileReference::HostileReference(Unit* pUnit, ThreatManager *pThreatManager, f
     iUnitGuid = pUnit->GetGUID();
     iOnline = true;
     iAccessible = true;
+    iContainer = NULL;
+    iMoved = false;
 }
 
 //============================================================
@@ -209,33 +211,96 @@ Unit* HostileReference::getSourceUnit()
 
 void ThreatContainer::clearReferences()
 {
-    for (std::list<HostileReference*>::iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for (ThreatRefList::iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
     {
+        (*i)->iContainer = NULL;
         (*i)->unlink();
         delete (*i);
     }
     iThreatList.clear();
+    iThreatIndex.clear();
+    iMovedRefs.clear();
 }
 
 //============================================================
-// Return the HostileReference of NULL, if not found
-HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
+
+void ThreatContainer::addReference(HostileReference* pRef)
 {
-    HostileReference* result = NULL;
-    if (!pVictim)
-        return NULL;
+    pRef->iContainer = this;
+    pRef->iListPos = iThreatList.insert(iThreatList.end(), pRef);
+    iThreatIndex[pRef->getUnitGuid()] = pRef;
+    setMoved(pRef);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    if (pRef->iContainer != this)
+        return;
+
+    iThreatList.erase(pRef->iListPos);
+    iThreatIndex.erase(pRef->getUnitGuid());
+    pRef->iContainer = NULL;
+
+    if (pRef->iMoved)
+    {
+        iMovedRefs.erase(std::find(iMovedRefs.begin(), iMovedRefs.end(), pRef));
+        pRef->iMoved = false;
+    }
+}
+
+//============================================================
 
-    uint64 guid = pVictim->GetGUID();
-    for (std::list<HostileReference*>::iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+void ThreatContainer::setMoved(HostileReference* pRef)
+{
+    if (pRef->iContainer != this || pRef->iMoved)
+        return;
+
+    pRef->iMoved = true;
+    iMovedRefs.push_back(pRef);
+}
+
+//============================================================
+
+bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
+{
+    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
+    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
+}
+
+//============================================================
+// Take changed references out, sort only them and merge them back into
+// the rest of the list, which is still sorted. Merge is stable, so equal
+// threat keeps unchanged references first. Nodes are moved, not copied,
+// so references keep their list positions valid
+
+void ThreatContainer::update()
+{
+    if (!iMovedRefs.empty())
     {
-        if ((*i)->getUnitGuid() == guid)
+        ThreatRefList moved;
+        for (std::vector<HostileReference*>::iterator i = iMovedRefs.begin(); i != iMovedRefs.end(); ++i)
         {
-            result = (*i);
-            break;
+            (*i)->iMoved = false;
+            moved.splice(moved.end(), iThreatList, (*i)->iListPos);
         }
+        iMovedRefs.clear();
+
+        moved.sort(HostileReferenceSortPredicate);
+        iThreatList.merge(moved, HostileReferenceSortPredicate);
     }
+}
 
-    return result;
+//============================================================
+// Return the HostileReference of NULL, if not found
+HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
+{
+    if (!pVictim)
+        return NULL;
+
+    ThreatIndex::const_iterator itr = iThreatIndex.find(pVictim->GetGUID());
+    return itr != iThreatIndex.end() ? itr->second : NULL;
 }
 
 //============================================================
@@ -265,26 +330,6 @@ void ThreatContainer::modifyThreatPercent(Unit *pVictim, int32 pPercent)
     }
 }
 
-//============================================================
-
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
-{
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
-}
-
-//============================================================
-// Check if the list is dirty and sort if necessary
-
-void ThreatContainer::update()
-{
-    if (iDirty && iThreatList.size() >1)
-    {
-        iThreatList.sort(HostileReferenceSortPredicate);
-    }
-    iDirty = false;
-}
-
 bool DropAggro(Creature* pAttacker, Unit * target)
 {
     if (!target)
@@ -442,8 +487,8 @@ void ThreatManager::clearReferences()
 
 void ThreatManager::addThreat(Unit* pVictim, float pThreat, SpellSchoolMask schoolMask, SpellEntry const *pThreatSpell)
 {
-    //function deals with adding threat and adding players and pets into ThreatList
-    //mobs, NPCs, guards have ThreatList and HateOfflineList
+    //function deals with adding threat and adding players and pets into ThreatRefList
+    //mobs, NPCs, guards have ThreatRefList and HateOfflineList
     //players and pets have only InHateListOf
     //HateOfflineList is used co contain unattackable victims (in-flight, in-water, GM etc.)
 
@@ -571,35 +616,28 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch(threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
-                (getCurrentVictim() != hostileRef && threatRefStatusChangeEvent->getFValue()>0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            if (hostileRef->isOnline())
+                iThreatContainer.setMoved(hostileRef);
+            else
+                iThreatOfflineContainer.setMoved(hostileRef);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileRef->isOnline())
             {
                 if (hostileRef == getCurrentVictim())
-                {
                     setCurrentVictim(NULL);
-                    setDirty(true);
-                }
                 iThreatContainer.remove(hostileRef);
                 iThreatOfflineContainer.addReference(hostileRef);
             }
             else
             {
-                if (getCurrentVictim() && hostileRef->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
-                    setDirty(true);
-                iThreatContainer.addReference(hostileRef);
                 iThreatOfflineContainer.remove(hostileRef);
+                iThreatContainer.addReference(hostileRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
             if (hostileRef == getCurrentVictim())
-            {
                 setCurrentVictim(NULL);
-                setDirty(true);
-            }
             if (hostileRef ->isOnline())
                 iThreatContainer.remove(hostileRef);
             else
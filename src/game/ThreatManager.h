@@ -27,14 +27,19 @@
 #include "UnitEvents.h"
 
 #include <list>
+#include <vector>
 
 //==============================================================
 
 class Unit;
 class Creature;
 class ThreatManager;
+class ThreatContainer;
+class HostileReference;
 struct SpellEntry;
 
+typedef std::list<HostileReference*> ThreatRefList;
+
 //==============================================================
 // Class to calculate the real threat based
 
@@ -116,6 +121,8 @@ class HELLGROUND_IMPORT_EXPORT HostileReference : public Reference<Unit, ThreatM
         void sourceObjectDestroyLink();
 
     private:
+        friend class ThreatContainer;
+
         // Inform the source, that the status of that reference was changed
         void fireStatusChanged(ThreatRefStatusChangeEvent& pThreatRefStatusChangeEvent);
 
@@ -127,26 +134,39 @@ class HELLGROUND_IMPORT_EXPORT HostileReference : public Reference<Unit, ThreatM
         uint64 iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        ThreatContainer* iContainer;                        // container holding this reference, NULL if none
+        ThreatRefList::iterator iListPos;                   // position in iContainer threat list
+        bool iMoved;                                        // threat changed since the list was last ordered
 };
 
 //==============================================================
 class ThreatManager;
 
+// Threat list is sorted by threat. References whose threat changed are
+// remembered and merged back to their place on update() instead of resorting
+// the whole list, so scripts iterating the list while changing threat see
+// the same order as before. References are indexed by unit guid for lookup.
 class HELLGROUND_IMPORT_EXPORT ThreatContainer
 {
     private:
-        std::list<HostileReference*> iThreatList;
-        bool iDirty;
+        typedef UNORDERED_MAP<uint64, HostileReference*> ThreatIndex;
+
+        ThreatRefList iThreatList;
+        ThreatIndex iThreatIndex;
+        std::vector<HostileReference*> iMovedRefs;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-        void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+        void remove(HostileReference* pRef);
+        void addReference(HostileReference* pHostileReference);
         void clearReferences();
-        // Sort the list if necessary
+        // Remember reference to move after its threat was changed
+        void setMoved(HostileReference* pRef);
+        // Move changed references to their place
         void update();
     public:
-        ThreatContainer() { iDirty = false; }
+        ThreatContainer() {}
         ~ThreatContainer() { clearReferences(); }
 
         HostileReference* addThreat(Unit* pVictim, float pThreat);
@@ -155,17 +175,13 @@ class HELLGROUND_IMPORT_EXPORT ThreatContainer
 
         HostileReference* selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim);
 
-        void setDirty(bool pDirty) { iDirty = pDirty; }
-
-        bool isDirty() { return iDirty; }
-
         bool empty() { return(iThreatList.empty()); }
 
         HostileReference* getMostHated() { return iThreatList.empty() ? NULL : iThreatList.front(); }
 
         HostileReference* getReferenceByTarget(Unit* pVictim);
 
-        std::list<HostileReference*>& getThreatList() { return iThreatList; }
+        ThreatRefList& getThreatList() { return iThreatList; }
 };
 
 //=================================================
@@ -201,8 +217,6 @@ class HELLGROUND_IMPORT_EXPORT ThreatManager
 
         void setCurrentVictim(HostileReference* pHostileReference);
 
-        void setDirty(bool pDirty) { iThreatContainer.setDirty(pDirty); }
-
         // methods to access the lists from the outside to do sume dirty manipulation (scriping and such)
         // I hope they are used as little as possible.
         std::list<HostileReference*>& getThreatList() { return iThreatContainer.getThreatList(); }
@@ -264,7 +264,7 @@ Unit::Unit() :
     IsAIEnabled(false), NeedChangeAI(false), i_AI(NULL), i_disabledAI(NULL),
     m_procDeep(0), m_AI_locked(false), m_removedAurasCount(0)
 {
-    m_modAuras = new AuraList[TOTAL_AURAS];
+    m_modAuras = new AuraTypeList[TOTAL_AURAS];
     m_objectType |= TYPEMASK_UNIT;
     m_objectTypeId = TYPEID_UNIT;
                                                             // 2.3.2 - 0x70
@@ -390,11 +390,10 @@ Unit::~Unit()
 
     for (int i = 0; i < TOTAL_AURAS; i++)
     {
-        while (!m_modAuras[i].empty())
-        {
-            delete m_modAuras[i].front();
-            m_modAuras[i].pop_front();
-        }
+        for (AuraTypeList::const_iterator itr = m_modAuras[i].begin(); itr != m_modAuras[i].end(); ++itr)
+            delete *itr;
+
+        m_modAuras[i].clear();
     }
 
     delete [] m_modAuras;
@@ -652,7 +651,7 @@ void Unit::RemoveSpellsCausingAura(AuraType auraType)
     if (auraType >= TOTAL_AURAS)
         return;
 
-    AuraList::iterator iter, next;
+    AuraTypeList::const_iterator iter, next;
     for (iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end(); iter = next)
     {
         next = iter;
@@ -674,7 +673,7 @@ void Unit::RemoveAuraTypeByCaster(AuraType auraType, uint64 casterGUID)
     if (auraType >= TOTAL_AURAS)
         return;
 
-    for (AuraList::iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    for (AuraTypeList::const_iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
     {
         Aura *aur = *iter;
         ++iter;
@@ -758,8 +757,8 @@ bool Unit::HasAuraType(AuraType auraType) const
 bool Unit::HasAuraTypeWithFamilyFlags(AuraType auraType, uint32 familyName  ,uint64 familyFlags) const
 {
     if (!HasAuraType(auraType)) return false;
-    AuraList const &auras = GetAurasByType(auraType);
-    for (AuraList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+    AuraTypeList const &auras = GetAurasByType(auraType);
+    for (AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
         if (SpellEntry const *iterSpellProto = (*itr)->GetSpellProto())
             if (iterSpellProto->SpellFamilyName == familyName && iterSpellProto->SpellFamilyFlags & familyFlags)
                 return true;
@@ -769,7 +768,8 @@ bool Unit::HasAuraTypeWithFamilyFlags(AuraType auraType, uint32 familyName  ,uin
 uint32 Unit::GetAurasAmountByMiscValue(AuraType auraType, uint32 misc)
 {
     uint32 count = 0;
-    Unit::AuraList mAuras = GetAurasByType(SPELL_AURA_MECHANIC_IMMUNITY);
+    Unit::AuraTypeList const& mAurasByType = GetAurasByType(SPELL_AURA_MECHANIC_IMMUNITY);
+    Unit::AuraList mAuras(mAurasByType.begin(), mAurasByType.end());
     for (Unit::AuraList::iterator iter = mAuras.begin(); iter != mAuras.end(); ++iter)
     {
         if ((*iter)->GetMiscValue() == misc)
@@ -915,7 +915,8 @@ uint32 Unit::DealDamage(DamageLog *damageInfo, DamageEffectType damagetype, cons
         // Handle Blessed Life
         if (pVictim->GetClass() == CLASS_PALADIN)
         {
-            AuraList procTriggerAuras = pVictim->GetAurasByType(SPELL_AURA_PROC_TRIGGER_SPELL);
+            Unit::AuraTypeList const& procTriggerAurasByType = pVictim->GetAurasByType(SPELL_AURA_PROC_TRIGGER_SPELL);
+            AuraList procTriggerAuras(procTriggerAurasByType.begin(), procTriggerAurasByType.end());
             for (AuraList::iterator i = procTriggerAuras.begin(); i != procTriggerAuras.end(); ++i)
             {
                 switch ((*i)->GetSpellProto()->Id)
@@ -1824,8 +1825,8 @@ void Unit::DealMeleeDamage(MeleeDamageLog *damageInfo, bool durabilityLoss)
         // victim's damage shield
         std::set<Aura*> alreadyDone;
         uint32 removedAuras = pVictim->m_removedAurasCount;
-        AuraList const& vDamageShields = pVictim->GetAurasByType(SPELL_AURA_DAMAGE_SHIELD);
-        for (AuraList::const_iterator i = vDamageShields.begin(), next = vDamageShields.begin(); i != vDamageShields.end(); i = next)
+        AuraTypeList const& vDamageShields = pVictim->GetAurasByType(SPELL_AURA_DAMAGE_SHIELD);
+        for (AuraTypeList::const_iterator i = vDamageShields.begin(), next = vDamageShields.begin(); i != vDamageShields.end(); i = next)
         {
            next++;
            if (alreadyDone.find(*i) == alreadyDone.end())
@@ -1993,8 +1994,8 @@ void Unit::CalcAbsorb(Unit *pVictim,SpellSchoolMask schoolMask, const uint32 dam
     // absorb without mana cost
     int32 reflectDamage = 0;
     Aura* reflectAura = NULL;
-    AuraList const& vSchoolAbsorb = pVictim->GetAurasByType(SPELL_AURA_SCHOOL_ABSORB);
-    for (AuraList::const_iterator i = vSchoolAbsorb.begin(); i != vSchoolAbsorb.end() && RemainingDamage > 0; ++i)
+    AuraTypeList const& vSchoolAbsorb = pVictim->GetAurasByType(SPELL_AURA_SCHOOL_ABSORB);
+    for (AuraTypeList::const_iterator i = vSchoolAbsorb.begin(); i != vSchoolAbsorb.end() && RemainingDamage > 0; ++i)
     {
         int32 *p_absorbAmount = &(*i)->GetModifier()->m_amount;
 
@@ -2042,8 +2043,8 @@ void Unit::CalcAbsorb(Unit *pVictim,SpellSchoolMask schoolMask, const uint32 dam
             {
                 if (Unit* caster = (*i)->GetCaster())
                 {
-                    AuraList const& vOverRideCS = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                    for (AuraList::const_iterator k = vOverRideCS.begin(); k != vOverRideCS.end(); ++k)
+                    AuraTypeList const& vOverRideCS = caster->GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                    for (AuraTypeList::const_iterator k = vOverRideCS.begin(); k != vOverRideCS.end(); ++k)
                     {
                         switch ((*k)->GetModifier()->m_miscvalue)
                         {
@@ -2101,7 +2102,7 @@ void Unit::CalcAbsorb(Unit *pVictim,SpellSchoolMask schoolMask, const uint32 dam
     // Remove all expired absorb auras
     if (expiredExists)
     {
-        for (AuraList::const_iterator i = vSchoolAbsorb.begin(); i != vSchoolAbsorb.end();)
+        for (AuraTypeList::const_iterator i = vSchoolAbsorb.begin(); i != vSchoolAbsorb.end();)
         {
             Aura *aur = (*i);
             ++i;
@@ -2119,8 +2120,8 @@ void Unit::CalcAbsorb(Unit *pVictim,SpellSchoolMask schoolMask, const uint32 dam
     }
 
     // absorb by mana cost
-    AuraList const& vManaShield = pVictim->GetAurasByType(SPELL_AURA_MANA_SHIELD);
-    for (AuraList::const_iterator i = vManaShield.begin(), next; i != vManaShield.end() && RemainingDamage > 0; i = next)
+    AuraTypeList const& vManaShield = pVictim->GetAurasByType(SPELL_AURA_MANA_SHIELD);
+    for (AuraTypeList::const_iterator i = vManaShield.begin(), next; i != vManaShield.end() && RemainingDamage > 0; i = next)
     {
         next = i; ++next;
 
@@ -2181,8 +2182,8 @@ void Unit::CalcAbsorb(Unit *pVictim,SpellSchoolMask schoolMask, const uint32 dam
     // only split damage if not damaging yourself
     if (pVictim != this)
     {
-        AuraList const& vSplitDamageFlat = pVictim->GetAurasByType(SPELL_AURA_SPLIT_DAMAGE_FLAT);
-        for (AuraList::const_iterator i = vSplitDamageFlat.begin(), next; i != vSplitDamageFlat.end() && RemainingDamage >= 0; i = next)
+        AuraTypeList const& vSplitDamageFlat = pVictim->GetAurasByType(SPELL_AURA_SPLIT_DAMAGE_FLAT);
+        for (AuraTypeList::const_iterator i = vSplitDamageFlat.begin(), next; i != vSplitDamageFlat.end() && RemainingDamage >= 0; i = next)
         {
             next = i; ++next;
             int32 *p_absorbAmount = &(*i)->GetModifier()->m_amount;
@@ -2210,8 +2211,8 @@ void Unit::CalcAbsorb(Unit *pVictim,SpellSchoolMask schoolMask, const uint32 dam
             DealDamage(&damageInfo, DOT, (*i)->GetSpellProto(), false);
         }
 
-        AuraList const& vSplitDamagePct = pVictim->GetAurasByType(SPELL_AURA_SPLIT_DAMAGE_PCT);
-        for (AuraList::const_iterator i = vSplitDamagePct.begin(), next; i != vSplitDamagePct.end() && RemainingDamage >= 0; i = next)
+        AuraTypeList const& vSplitDamagePct = pVictim->GetAurasByType(SPELL_AURA_SPLIT_DAMAGE_PCT);
+        for (AuraTypeList::const_iterator i = vSplitDamagePct.begin(), next; i != vSplitDamagePct.end() && RemainingDamage >= 0; i = next)
         {
             next = i; ++next;
 
@@ -2294,8 +2295,8 @@ void Unit::AttackerStateUpdate (Unit *pVictim, WeaponAttackType attType, bool ex
 
     if (pVictim->HasAuraType(SPELL_AURA_ADD_CASTER_HIT_TRIGGER))
     {
-        Unit::AuraList const& hitTriggerAuras = pVictim->GetAurasByType(SPELL_AURA_ADD_CASTER_HIT_TRIGGER);
-        for (Unit::AuraList::const_iterator itr = hitTriggerAuras.begin(); itr != hitTriggerAuras.end(); ++itr)
+        Unit::AuraTypeList const& hitTriggerAuras = pVictim->GetAurasByType(SPELL_AURA_ADD_CASTER_HIT_TRIGGER);
+        for (Unit::AuraTypeList::const_iterator itr = hitTriggerAuras.begin(); itr != hitTriggerAuras.end(); ++itr)
         {
             if (Unit* hitTarget = (*itr)->GetCaster())
             {
@@ -2914,8 +2915,8 @@ SpellMissInfo Unit::MeleeSpellHitResult(Unit *pVictim, SpellEntry const *spell,
     }
 
     // Rogue talent`s cant be dodged
-    AuraList const& mCanNotBeDodge = GetAurasByType(SPELL_AURA_IGNORE_COMBAT_RESULT);
-    for (AuraList::const_iterator i = mCanNotBeDodge.begin(); i != mCanNotBeDodge.end(); ++i)
+    AuraTypeList const& mCanNotBeDodge = GetAurasByType(SPELL_AURA_IGNORE_COMBAT_RESULT);
+    for (AuraTypeList::const_iterator i = mCanNotBeDodge.begin(); i != mCanNotBeDodge.end(); ++i)
     {
         if ((*i)->GetModifier()->m_miscvalue == VICTIMSTATE_DODGE)       // can't be dodged rogue finishing move
         {
@@ -3119,8 +3120,8 @@ SpellMissInfo Unit::SpellHitResult(Unit *pVictim, SpellEntry const *spell, bool
 SpellMissInfo Unit::SpellReflectCheck(SpellEntry const * spell)
 {
     int32 reflectchance = GetTotalAuraModifier(SPELL_AURA_REFLECT_SPELLS);
-    Unit::AuraList const& mReflectSpellsSchool = GetAurasByType(SPELL_AURA_REFLECT_SPELLS_SCHOOL);
-    for (Unit::AuraList::const_iterator i = mReflectSpellsSchool.begin(); i != mReflectSpellsSchool.end(); ++i)
+    Unit::AuraTypeList const& mReflectSpellsSchool = GetAurasByType(SPELL_AURA_REFLECT_SPELLS_SCHOOL);
+    for (Unit::AuraTypeList::const_iterator i = mReflectSpellsSchool.begin(); i != mReflectSpellsSchool.end(); ++i)
         if ((*i)->GetModifier()->m_miscvalue & SpellMgr::GetSpellSchoolMask(spell))
             reflectchance += (*i)->GetModifierValue();
 
@@ -3337,6 +3338,11 @@ void Unit::_DeleteAuras()
 
 void Unit::_UpdateSpells(uint32 time)
 {
+    // nothing iterates aura type lists here, drop holes left by removed auras
+    for (std::vector<AuraType>::const_iterator itr = m_holedAuraTypes.begin(); itr != m_holedAuraTypes.end(); ++itr)
+        m_modAuras[*itr].compact();
+    m_holedAuraTypes.clear();
+
     if (m_currentSpells[CURRENT_AUTOREPEAT_SPELL])
         _UpdateAutoRepeatSpell();
 
@@ -3704,8 +3710,8 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
     if (sWorld.getConfig(CONFIG_VMAP_INDOOR_CHECK))
         outdoors = GetTerrain()->IsOutdoors(GetPositionX(),GetPositionY(),GetPositionZ());
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
         if(outdoors || !((*i)->GetSpellProto()->Attributes & SPELL_ATTR_OUTDOORS_ONLY))
             modifier += (*i)->GetModifierValue();
 
@@ -3720,8 +3726,8 @@ float Unit::GetTotalAuraMultiplier(AuraType auratype) const
     if (sWorld.getConfig(CONFIG_VMAP_INDOOR_CHECK))
         outdoors = GetTerrain()->IsOutdoors(GetPositionX(),GetPositionY(),GetPositionZ());
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
         if(outdoors || !((*i)->GetSpellProto()->Attributes & SPELL_ATTR_OUTDOORS_ONLY))
             multiplier *= (100.0f + (*i)->GetModifierValue())/100.0f;
 
@@ -3736,8 +3742,8 @@ int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
     if (sWorld.getConfig(CONFIG_VMAP_INDOOR_CHECK))
         outdoors = GetTerrain()->IsOutdoors(GetPositionX(),GetPositionY(),GetPositionZ());
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         if(outdoors || !((*i)->GetSpellProto()->Attributes & SPELL_ATTR_OUTDOORS_ONLY))
         {
@@ -3754,8 +3760,8 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         int32 amount = (*i)->GetModifierValue();
         if (amount < modifier)
@@ -3769,8 +3775,8 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask)
 {
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         if (mod->m_miscvalue & misc_mask)
@@ -3783,8 +3789,8 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask
 {
     float multiplier = 1.0f;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         if (mod->m_miscvalue & misc_mask)
@@ -3797,8 +3803,8 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 {
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         int32 amount = (*i)->GetModifierValue();
@@ -3813,8 +3819,8 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 {
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         int32 amount = (*i)->GetModifierValue();
@@ -3829,8 +3835,8 @@ int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value)
 {
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         if (mod->m_miscvalue == misc_value)
@@ -3843,8 +3849,8 @@ float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_valu
 {
     float multiplier = 1.0f;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         if (mod->m_miscvalue == misc_value)
@@ -3857,8 +3863,8 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_
 {
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         int32 amount = (*i)->GetModifierValue();
@@ -3873,8 +3879,8 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_
 {
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
+    AuraTypeList const& mTotalAuraList = GetAurasByType(auratype);
+    for (AuraTypeList::const_iterator i = mTotalAuraList.begin();i != mTotalAuraList.end(); ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         int32 amount = (*i)->GetModifierValue();
@@ -4115,7 +4121,8 @@ bool Unit::CheckForStrongerAuras(Aura* Aur)
         Aur->GetModifier()->m_auraname == SPELL_AURA_HASTE_MELEE) &&
         !Aur->IsPersistent() && Aur->GetModifierValue() < 0 && Aur->GetCasterGUID() != GetGUID())
     {
-        Unit::AuraList list = GetAurasByType(Aur->GetModifier()->m_auraname);
+        Unit::AuraTypeList const& listByType = GetAurasByType(Aur->GetModifier()->m_auraname);
+        Unit::AuraList list(listByType.begin(), listByType.end());
         for (Unit::AuraList::iterator itr = list.begin(); itr != list.end(); itr++)
         {
             if ((*itr)->GetModifierValue() > 0 || (*itr)->GetCasterGUID() == GetGUID())
@@ -4131,7 +4138,8 @@ bool Unit::CheckForStrongerAuras(Aura* Aur)
     if (Aur->GetModifier()->m_auraname == SPELL_AURA_MOD_STAT  && spellProto->SpellIconID &&
         Aur->GetModifierValue() > 0) // positive pure stat buff
     {
-        Unit::AuraList list = GetAurasByType(SPELL_AURA_MOD_STAT);
+        Unit::AuraTypeList const& listByType = GetAurasByType(SPELL_AURA_MOD_STAT);
+        Unit::AuraList list(listByType.begin(), listByType.end());
         for (Unit::AuraList::iterator itr = list.begin(); itr != list.end(); itr++)
         {
             if ((*itr)->GetMiscValue() == Aur->GetMiscValue() && (*itr)->GetModifierValue() > Aur->GetModifierValue()
@@ -4323,8 +4331,8 @@ void Unit::RemoveAurasByCasterSpell(uint32 spellId, uint64 casterGUID)
 
 void Unit::RemoveAurasWithFamilyFlagsAndTypeByCaster(uint32 familyName,  uint64 familyFlags, AuraType aurType, uint64 casterGUID)
 {
-    Unit::AuraList const& auras = GetAurasByType(aurType);
-    for (Unit::AuraList::const_iterator itr = auras.begin(); itr != auras.end();)
+    Unit::AuraTypeList const& auras = GetAurasByType(aurType);
+    for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end();)
     {
         if ((*itr)->GetCasterGUID() == casterGUID)
         {
@@ -4697,7 +4705,8 @@ void Unit::RemoveAura(AuraMap::iterator &i, AuraRemoveMode mode)
     // remove from list before mods removing (prevent cyclic calls, mods added before including to aura list - use reverse order)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
-        m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur); //**
+        if (m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur)) //**
+            m_holedAuraTypes.push_back(AuraType(Aur->GetModifier()->m_auraname));
 
         if (Aur->GetSpellProto()->AuraInterruptFlags)
         {
@@ -5391,8 +5400,8 @@ bool Unit::HandleDummyAuraProc(Unit *pVictim, uint32 damage, Aura* triggeredByAu
 
                     // find Mage Armor
                     bool found = false;
-                    AuraList const& mRegenInterupt = GetAurasByType(SPELL_AURA_MOD_MANA_REGEN_INTERRUPT);
-                    for (AuraList::const_iterator iter = mRegenInterupt.begin(); iter != mRegenInterupt.end(); ++iter)
+                    AuraTypeList const& mRegenInterupt = GetAurasByType(SPELL_AURA_MOD_MANA_REGEN_INTERRUPT);
+                    for (AuraTypeList::const_iterator iter = mRegenInterupt.begin(); iter != mRegenInterupt.end(); ++iter)
                     {
                         if (SpellEntry const* iterSpellProto = (*iter)->GetSpellProto())
                         {
@@ -5749,8 +5758,8 @@ bool Unit::HandleDummyAuraProc(Unit *pVictim, uint32 damage, Aura* triggeredByAu
                              return false;
                      }
 
-                    AuraList const &DoT = pVictim->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                    for (AuraList::const_iterator itr = DoT.begin(); itr != DoT.end(); ++itr)
+                    AuraTypeList const &DoT = pVictim->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                    for (AuraTypeList::const_iterator itr = DoT.begin(); itr != DoT.end(); ++itr)
                         if ((*itr)->GetId() == 12654 && (*itr)->GetCaster() == this)
                             if ((*itr)->GetBasePoints() > 0)
                                 basepoints0 += int((*itr)->GetBasePoints()/((*itr)->GetTickNumber() + 1));
@@ -6254,8 +6263,8 @@ bool Unit::HandleDummyAuraProc(Unit *pVictim, uint32 damage, Aura* triggeredByAu
 
                     // On target with 5 stacks of Holy Vengeance direct damage is done
                     Aura* sealAura = NULL;
-                    Unit::AuraList const& auras = pVictim->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-                    for (Unit::AuraList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
+                    Unit::AuraTypeList const& auras = pVictim->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
+                    for (Unit::AuraTypeList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
                     {
                         if ((*itr)->GetId() == 31803 && (*itr)->GetCasterGUID() == GetGUID())
                         {
@@ -6847,8 +6856,8 @@ bool Unit::HandleProcTriggerSpell(Unit *pVictim, uint32 damage, Aura* triggeredB
          // Drain Soul
          else if (auraSpellEntry->SpellFamilyFlags & 0x0000000000004000LL)
          {
-             Unit::AuraList const& mAddFlatModifier = GetAurasByType(SPELL_AURA_ADD_FLAT_MODIFIER);
-             for (Unit::AuraList::const_iterator i = mAddFlatModifier.begin(); i != mAddFlatModifier.end(); ++i)
+             Unit::AuraTypeList const& mAddFlatModifier = GetAurasByType(SPELL_AURA_ADD_FLAT_MODIFIER);
+             for (Unit::AuraTypeList::const_iterator i = mAddFlatModifier.begin(); i != mAddFlatModifier.end(); ++i)
              {
                  if ((*i)->GetModifier()->m_miscvalue == SPELLMOD_CHANCE_OF_SUCCESS && (*i)->GetSpellProto()->SpellIconID == 113)
                  {
@@ -8277,8 +8286,8 @@ uint32 Unit::SpellDamageBonus(Unit *pVictim, SpellEntry const *spellProto, uint3
     float TakenTotalMod = 1.0f;
 
     // ..done
-    AuraList const& mModDamagePercentDone = GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
-    for (AuraList::const_iterator i = mModDamagePercentDone.begin(); i != mModDamagePercentDone.end(); ++i)
+    AuraTypeList const& mModDamagePercentDone = GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
+    for (AuraTypeList::const_iterator i = mModDamagePercentDone.begin(); i != mModDamagePercentDone.end(); ++i)
     {
         switch ((*i)->GetId())
         {
@@ -8302,8 +8311,8 @@ uint32 Unit::SpellDamageBonus(Unit *pVictim, SpellEntry const *spellProto, uint3
         }
     }
 
-    AuraList const& mDamageDoneVersus = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE_VERSUS);
-    for (AuraList::const_iterator i = mDamageDoneVersus.begin();i != mDamageDoneVersus.end(); ++i)
+    AuraTypeList const& mDamageDoneVersus = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE_VERSUS);
+    for (AuraTypeList::const_iterator i = mDamageDoneVersus.begin();i != mDamageDoneVersus.end(); ++i)
         if (creatureTypeMask & uint32((*i)->GetModifier()->m_miscvalue))
             DoneTotalMod *= ((float)(*i)->GetModifierValue() +100.0f)/100.0f;
 
@@ -8316,14 +8325,14 @@ uint32 Unit::SpellDamageBonus(Unit *pVictim, SpellEntry const *spellProto, uint3
     }
 
     // ..taken
-    AuraList const& mModDamagePercentTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN);
-    for (AuraList::const_iterator i = mModDamagePercentTaken.begin(); i != mModDamagePercentTaken.end(); ++i)
+    AuraTypeList const& mModDamagePercentTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN);
+    for (AuraTypeList::const_iterator i = mModDamagePercentTaken.begin(); i != mModDamagePercentTaken.end(); ++i)
         if ((*i)->GetModifier()->m_miscvalue & SpellMgr::GetSpellSchoolMask(spellProto))
             TakenTotalMod *= ((float)(*i)->GetModifierValue() +100.0f)/100.0f;
 
     // .. taken pct: scripted (increases damage of * against targets *)
-    AuraList const& mOverrideClassScript = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-    for (AuraList::const_iterator i = mOverrideClassScript.begin(); i != mOverrideClassScript.end(); ++i)
+    AuraTypeList const& mOverrideClassScript = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+    for (AuraTypeList::const_iterator i = mOverrideClassScript.begin(); i != mOverrideClassScript.end(); ++i)
     {
         switch ((*i)->GetModifier()->m_miscvalue)
         {
@@ -8340,8 +8349,8 @@ uint32 Unit::SpellDamageBonus(Unit *pVictim, SpellEntry const *spellProto, uint3
 
     bool hasmangle=false;
     // .. taken pct: dummy auras
-    AuraList const& mDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
-    for (AuraList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
+    AuraTypeList const& mDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
+    for (AuraTypeList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
     {
         switch ((*i)->GetSpellProto()->SpellIconID)
         {
@@ -8667,8 +8676,8 @@ int32 Unit::SpellBaseDamageBonus(SpellSchoolMask schoolMask)
     int32 DoneAdvertisedBenefit = 0;
 
     // ..done
-    AuraList const& mDamageDone = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE);
-    for (AuraList::const_iterator i = mDamageDone.begin();i != mDamageDone.end(); ++i)
+    AuraTypeList const& mDamageDone = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE);
+    for (AuraTypeList::const_iterator i = mDamageDone.begin();i != mDamageDone.end(); ++i)
         if (((*i)->GetModifier()->m_miscvalue & schoolMask) != 0 &&
         (*i)->GetSpellProto()->EquippedItemClass == -1 &&
                                                             // -1 == any item class (not wand then)
@@ -8679,8 +8688,8 @@ int32 Unit::SpellBaseDamageBonus(SpellSchoolMask schoolMask)
     if (GetTypeId() == TYPEID_PLAYER)
     {
         // Damage bonus from stats
-        AuraList const& mDamageDoneOfStatPercent = GetAurasByType(SPELL_AURA_MOD_SPELL_DAMAGE_OF_STAT_PERCENT);
-        for (AuraList::const_iterator i = mDamageDoneOfStatPercent.begin();i != mDamageDoneOfStatPercent.end(); ++i)
+        AuraTypeList const& mDamageDoneOfStatPercent = GetAurasByType(SPELL_AURA_MOD_SPELL_DAMAGE_OF_STAT_PERCENT);
+        for (AuraTypeList::const_iterator i = mDamageDoneOfStatPercent.begin();i != mDamageDoneOfStatPercent.end(); ++i)
         {
             if ((*i)->GetModifier()->m_miscvalue & schoolMask)
             {
@@ -8696,8 +8705,8 @@ int32 Unit::SpellBaseDamageBonus(SpellSchoolMask schoolMask)
             }
         }
         // ... and attack power
-        AuraList const& mDamageDonebyAP = GetAurasByType(SPELL_AURA_MOD_SPELL_DAMAGE_OF_ATTACK_POWER);
-        for (AuraList::const_iterator i =mDamageDonebyAP.begin();i != mDamageDonebyAP.end(); ++i)
+        AuraTypeList const& mDamageDonebyAP = GetAurasByType(SPELL_AURA_MOD_SPELL_DAMAGE_OF_ATTACK_POWER);
+        for (AuraTypeList::const_iterator i =mDamageDonebyAP.begin();i != mDamageDonebyAP.end(); ++i)
             if ((*i)->GetModifier()->m_miscvalue & schoolMask)
                 DoneAdvertisedBenefit += int32(GetTotalAttackPowerValue(BASE_ATTACK) * (*i)->GetModifierValue() / 100.0f);
 
@@ -8711,14 +8720,14 @@ int32 Unit::SpellBaseDamageBonusForVictim(SpellSchoolMask schoolMask, Unit *pVic
 
     int32 TakenAdvertisedBenefit = 0;
     // ..done (for creature type by mask) in taken
-    AuraList const& mDamageDoneCreature = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE_CREATURE);
-    for (AuraList::const_iterator i = mDamageDoneCreature.begin();i != mDamageDoneCreature.end(); ++i)
+    AuraTypeList const& mDamageDoneCreature = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE_CREATURE);
+    for (AuraTypeList::const_iterator i = mDamageDoneCreature.begin();i != mDamageDoneCreature.end(); ++i)
         if (creatureTypeMask & uint32((*i)->GetModifier()->m_miscvalue))
             TakenAdvertisedBenefit += (*i)->GetModifierValue();
 
     // ..taken
-    AuraList const& mDamageTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_DAMAGE_TAKEN);
-    for (AuraList::const_iterator i = mDamageTaken.begin();i != mDamageTaken.end(); ++i)
+    AuraTypeList const& mDamageTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_DAMAGE_TAKEN);
+    for (AuraTypeList::const_iterator i = mDamageTaken.begin();i != mDamageTaken.end(); ++i)
         if (((*i)->GetModifier()->m_miscvalue & schoolMask) != 0)
             TakenAdvertisedBenefit += (*i)->GetModifierValue();
 
@@ -8766,8 +8775,8 @@ bool Unit::isSpellCrit(Unit *pVictim, SpellEntry const *spellProto, SpellSchoolM
                 // scripted (increase crit chance ... against ... target by x%
                 if (pVictim->isFrozen()) // Shatter
                 {
-                    AuraList const& mOverrideClassScript = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-                    for (AuraList::const_iterator i = mOverrideClassScript.begin(); i != mOverrideClassScript.end(); ++i)
+                    AuraTypeList const& mOverrideClassScript = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+                    for (AuraTypeList::const_iterator i = mOverrideClassScript.begin(); i != mOverrideClassScript.end(); ++i)
                     {
                         switch ((*i)->GetModifier()->m_miscvalue)
                         {
@@ -8889,8 +8898,8 @@ uint32 Unit::SpellHealingBonus(SpellEntry const *spellProto, uint32 healamount,
     // Blessing of Light dummy effects healing taken from Holy Light and Flash of Light
     if (spellProto->SpellFamilyName == SPELLFAMILY_PALADIN && (spellProto->SpellFamilyFlags & 0x00000000C0000000LL))
     {
-        AuraList const& mDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
-        for (AuraList::const_iterator i = mDummyAuras.begin();i != mDummyAuras.end(); ++i)
+        AuraTypeList const& mDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
+        for (AuraTypeList::const_iterator i = mDummyAuras.begin();i != mDummyAuras.end(); ++i)
         {
             if ((*i)->GetSpellProto()->SpellVisual == 9180)
             {
@@ -8915,8 +8924,8 @@ uint32 Unit::SpellHealingBonus(SpellEntry const *spellProto, uint32 healamount,
     // Flash of Light
     if (spellProto->SpellFamilyName == SPELLFAMILY_PALADIN && (spellProto->SpellFamilyFlags & 0x0000000040000000LL))
     {
-        AuraList const& dummyAuras = GetAurasByType(SPELL_AURA_DUMMY);
-        for (AuraList::const_iterator i = dummyAuras.begin(); i != dummyAuras.end(); i++)
+        AuraTypeList const& dummyAuras = GetAurasByType(SPELL_AURA_DUMMY);
+        for (AuraTypeList::const_iterator i = dummyAuras.begin(); i != dummyAuras.end(); i++)
         {
             uint32 id = (*i)->GetSpellProto()->Id;
             if (id == 28851 || id == 28853 || id == 32403)   // bonuses from various librams
@@ -8927,8 +8936,8 @@ uint32 Unit::SpellHealingBonus(SpellEntry const *spellProto, uint32 healamount,
     // Lesser Healing Wave
     if (spellProto->SpellFamilyName == SPELLFAMILY_SHAMAN && spellProto->SpellFamilyFlags & 0x80)
     {
-        AuraList const& classScriptsAuras = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-        for (AuraList::const_iterator i = classScriptsAuras.begin(); i != classScriptsAuras.end(); i++)
+        AuraTypeList const& classScriptsAuras = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+        for (AuraTypeList::const_iterator i = classScriptsAuras.begin(); i != classScriptsAuras.end(); i++)
         {
             // Increased Lesser Healing Wave (few items has this effect)
             if ((*i)->GetMiscValue() == 3736)
@@ -9061,8 +9070,8 @@ uint32 Unit::SpellHealingBonus(SpellEntry const *spellProto, uint32 healamount,
     // TODO: check for ALL/SPELLS type
     // Healing done percent
     float HealingDonePct = 1.0f;
-    AuraList const& mHealingDonePct = GetAurasByType(SPELL_AURA_MOD_HEALING_DONE_PERCENT);
-    for (AuraList::const_iterator i = mHealingDonePct.begin();i != mHealingDonePct.end(); ++i)
+    AuraTypeList const& mHealingDonePct = GetAurasByType(SPELL_AURA_MOD_HEALING_DONE_PERCENT);
+    for (AuraTypeList::const_iterator i = mHealingDonePct.begin();i != mHealingDonePct.end(); ++i)
         HealingDonePct *= (100.0f + (*i)->GetModifierValue()) / 100.0f;
     if (casterModifiers)
     {
@@ -9083,8 +9092,8 @@ uint32 Unit::SpellHealingBonus(SpellEntry const *spellProto, uint32 healamount,
     {
         // Search for Healing Way on Victim (stack up to 3 time)
         int32 pctMod = 0;
-        Unit::AuraList const& auraDummy = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
-        for (Unit::AuraList::const_iterator itr = auraDummy.begin(); itr!=auraDummy.end(); ++itr)
+        Unit::AuraTypeList const& auraDummy = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
+        for (Unit::AuraTypeList::const_iterator itr = auraDummy.begin(); itr!=auraDummy.end(); ++itr)
         {
             if ((*itr)->GetId() == 29203)
             {
@@ -9107,8 +9116,8 @@ int32 Unit::SpellBaseHealingBonus(SpellSchoolMask schoolMask)
 {
     int32 AdvertisedBenefit = 0;
 
-    AuraList const& mHealingDone = GetAurasByType(SPELL_AURA_MOD_HEALING_DONE);
-    for (AuraList::const_iterator i = mHealingDone.begin();i != mHealingDone.end(); ++i)
+    AuraTypeList const& mHealingDone = GetAurasByType(SPELL_AURA_MOD_HEALING_DONE);
+    for (AuraTypeList::const_iterator i = mHealingDone.begin();i != mHealingDone.end(); ++i)
         if (((*i)->GetModifier()->m_miscvalue & schoolMask) != 0)
             AdvertisedBenefit += (*i)->GetModifierValue();
 
@@ -9116,8 +9125,8 @@ int32 Unit::SpellBaseHealingBonus(SpellSchoolMask schoolMask)
     if (GetTypeId() == TYPEID_PLAYER)
     {
         // Healing bonus from stats
-        AuraList const& mHealingDoneOfStatPercent = GetAurasByType(SPELL_AURA_MOD_SPELL_HEALING_OF_STAT_PERCENT);
-        for (AuraList::const_iterator i = mHealingDoneOfStatPercent.begin();i != mHealingDoneOfStatPercent.end(); ++i)
+        AuraTypeList const& mHealingDoneOfStatPercent = GetAurasByType(SPELL_AURA_MOD_SPELL_HEALING_OF_STAT_PERCENT);
+        for (AuraTypeList::const_iterator i = mHealingDoneOfStatPercent.begin();i != mHealingDoneOfStatPercent.end(); ++i)
         {
             // stat used dependent from misc value (stat index)
             Stats usedStat = Stats((*i)->GetSpellProto()->EffectMiscValue[(*i)->GetEffIndex()]);
@@ -9125,8 +9134,8 @@ int32 Unit::SpellBaseHealingBonus(SpellSchoolMask schoolMask)
         }
 
         // ... and attack power
-        AuraList const& mHealingDonebyAP = GetAurasByType(SPELL_AURA_MOD_SPELL_HEALING_OF_ATTACK_POWER);
-        for (AuraList::const_iterator i = mHealingDonebyAP.begin();i != mHealingDonebyAP.end(); ++i)
+        AuraTypeList const& mHealingDonebyAP = GetAurasByType(SPELL_AURA_MOD_SPELL_HEALING_OF_ATTACK_POWER);
+        for (AuraTypeList::const_iterator i = mHealingDonebyAP.begin();i != mHealingDonebyAP.end(); ++i)
             if ((*i)->GetModifier()->m_miscvalue & schoolMask)
                 AdvertisedBenefit += int32(GetTotalAttackPowerValue(BASE_ATTACK) * (*i)->GetModifierValue() / 100.0f);
     }
@@ -9136,8 +9145,8 @@ int32 Unit::SpellBaseHealingBonus(SpellSchoolMask schoolMask)
 int32 Unit::SpellBaseHealingBonusForVictim(SpellSchoolMask schoolMask, Unit *pVictim)
 {
     int32 AdvertisedBenefit = 0;
-    AuraList const& mDamageTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_HEALING);
-    for (AuraList::const_iterator i = mDamageTaken.begin();i != mDamageTaken.end(); ++i)
+    AuraTypeList const& mDamageTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_HEALING);
+    for (AuraTypeList::const_iterator i = mDamageTaken.begin();i != mDamageTaken.end(); ++i)
         if (((*i)->GetModifier()->m_miscvalue & schoolMask) != 0)
             AdvertisedBenefit += (*i)->GetModifierValue();
     return AdvertisedBenefit;
@@ -9145,7 +9154,7 @@ int32 Unit::SpellBaseHealingBonusForVictim(SpellSchoolMask schoolMask, Unit *pVi
 
 bool Unit::IsTotalImmune() const
 {
-    AuraList const& immune = GetAurasByType(SPELL_AURA_SCHOOL_IMMUNITY);
+    AuraTypeList const& immune = GetAurasByType(SPELL_AURA_SCHOOL_IMMUNITY);
 
     uint32 immuneMask = 0;
     for (const auto itr : immune)
@@ -9302,8 +9311,8 @@ void Unit::MeleeDamageBonus(Unit *pVictim, uint32 *pdamage,WeaponAttackType attT
 
     if (spellProto && (SpellMgr::GetSpellSchoolMask(spellProto) & this->GetMeleeDamageSchoolMask()) == 0)
     {
-        AuraList const& mModDamagePercentDone = GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
-        for (AuraList::const_iterator i = mModDamagePercentDone.begin(); i != mModDamagePercentDone.end(); ++i)
+        AuraTypeList const& mModDamagePercentDone = GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_DONE);
+        for (AuraTypeList::const_iterator i = mModDamagePercentDone.begin(); i != mModDamagePercentDone.end(); ++i)
         {
             switch ((*i)->GetId())
             {
@@ -9328,21 +9337,21 @@ void Unit::MeleeDamageBonus(Unit *pVictim, uint32 *pdamage,WeaponAttackType attT
         }
     }
 
-    AuraList const& mDamageDoneVersus = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE_VERSUS);
-    for (AuraList::const_iterator i = mDamageDoneVersus.begin();i != mDamageDoneVersus.end(); ++i)
+    AuraTypeList const& mDamageDoneVersus = GetAurasByType(SPELL_AURA_MOD_DAMAGE_DONE_VERSUS);
+    for (AuraTypeList::const_iterator i = mDamageDoneVersus.begin();i != mDamageDoneVersus.end(); ++i)
         if (creatureTypeMask & uint32((*i)->GetModifier()->m_miscvalue))
             DoneTotalMod *= ((*i)->GetModifierValue()+100.0f)/100.0f;
 
     // ..taken
-    AuraList const& mModDamagePercentTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN);
-    for (AuraList::const_iterator i = mModDamagePercentTaken.begin(); i != mModDamagePercentTaken.end(); ++i)
+    AuraTypeList const& mModDamagePercentTaken = pVictim->GetAurasByType(SPELL_AURA_MOD_DAMAGE_PERCENT_TAKEN);
+    for (AuraTypeList::const_iterator i = mModDamagePercentTaken.begin(); i != mModDamagePercentTaken.end(); ++i)
         if ((*i)->GetModifier()->m_miscvalue & this->GetMeleeDamageSchoolMask())
             TakenTotalMod *= ((*i)->GetModifierValue()+100.0f)/100.0f;
 
     // .. taken pct: dummy auras
     bool hasmangle = false;         // apply mangle effect only once
-    AuraList const& mDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
-    for (AuraList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
+    AuraTypeList const& mDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
+    for (AuraTypeList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
     {
         switch ((*i)->GetSpellProto()->SpellIconID)
         {
@@ -9376,8 +9385,8 @@ void Unit::MeleeDamageBonus(Unit *pVictim, uint32 *pdamage,WeaponAttackType attT
     if (spellProto)
     {
         // .. taken pct: class scripts
-        AuraList const& mclassScritAuras = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
-        for (AuraList::const_iterator i = mclassScritAuras.begin(); i != mclassScritAuras.end(); ++i)
+        AuraTypeList const& mclassScritAuras = GetAurasByType(SPELL_AURA_OVERRIDE_CLASS_SCRIPTS);
+        for (AuraTypeList::const_iterator i = mclassScritAuras.begin(); i != mclassScritAuras.end(); ++i)
         {
             switch ((*i)->GetMiscValue())
             {
@@ -9391,14 +9400,14 @@ void Unit::MeleeDamageBonus(Unit *pVictim, uint32 *pdamage,WeaponAttackType attT
 
     if (attType != RANGED_ATTACK)
     {
-        AuraList const& mModMeleeDamageTakenPercent = pVictim->GetAurasByType(SPELL_AURA_MOD_MELEE_DAMAGE_TAKEN_PCT);
-        for (AuraList::const_iterator i = mModMeleeDamageTakenPercent.begin(); i != mModMeleeDamageTakenPercent.end(); ++i)
+        AuraTypeList const& mModMeleeDamageTakenPercent = pVictim->GetAurasByType(SPELL_AURA_MOD_MELEE_DAMAGE_TAKEN_PCT);
+        for (AuraTypeList::const_iterator i = mModMeleeDamageTakenPercent.begin(); i != mModMeleeDamageTakenPercent.end(); ++i)
             TakenTotalMod *= ((*i)->GetModifierValue()+100.0f)/100.0f;
     }
     else
     {
-        AuraList const& mModRangedDamageTakenPercent = pVictim->GetAurasByType(SPELL_AURA_MOD_RANGED_DAMAGE_TAKEN_PCT);
-        for (AuraList::const_iterator i = mModRangedDamageTakenPercent.begin(); i != mModRangedDamageTakenPercent.end(); ++i)
+        AuraTypeList const& mModRangedDamageTakenPercent = pVictim->GetAurasByType(SPELL_AURA_MOD_RANGED_DAMAGE_TAKEN_PCT);
+        for (AuraTypeList::const_iterator i = mModRangedDamageTakenPercent.begin(); i != mModRangedDamageTakenPercent.end(); ++i)
             TakenTotalMod *= ((*i)->GetModifierValue()+100.0f)/100.0f;
     }
 
@@ -9878,8 +9887,8 @@ bool Unit::canDetectInvisibilityOf(Unit const* u) const
     if(m_invisibilityMask == 1) // normal invisibility
     {
         uint32 invLevel = 0;
-        Unit::AuraList const& iAuras = GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
-        for (Unit::AuraList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
+        Unit::AuraTypeList const& iAuras = GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
+        for (Unit::AuraTypeList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
             if (invLevel < (*itr)->GetModifier()->m_amount)
                 invLevel = (*itr)->GetModifier()->m_amount;
 
@@ -9892,8 +9901,8 @@ bool Unit::canDetectInvisibilityOf(Unit const* u) const
     {
         uint32 invLevel = 0;
         int32 invLevelPenalty = 0;  //some auras reduce invisibility level
-        Unit::AuraList const& iAuras = u->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
-        for (Unit::AuraList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
+        Unit::AuraTypeList const& iAuras = u->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
+        for (Unit::AuraTypeList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
         {
             if ((*itr)->GetModifier()->m_amount < invLevelPenalty)
             {
@@ -9908,8 +9917,8 @@ bool Unit::canDetectInvisibilityOf(Unit const* u) const
             return true;
     }
 
-    AuraList const& auras = u->GetAurasByType(SPELL_AURA_MOD_STALKED); // Hunter mark
-    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end(); ++iter)
+    AuraTypeList const& auras = u->GetAurasByType(SPELL_AURA_MOD_STALKED); // Hunter mark
+    for (AuraTypeList::const_iterator iter = auras.begin(); iter != auras.end(); ++iter)
         if ((*iter)->GetCasterGUID()==GetGUID())
             return true;
 
@@ -9922,8 +9931,8 @@ bool Unit::canDetectInvisibilityOf(Unit const* u) const
 
             // find invisibility level
             uint32 invLevel = 0;
-            Unit::AuraList const& iAuras = u->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
-            for (Unit::AuraList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
+            Unit::AuraTypeList const& iAuras = u->GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
+            for (Unit::AuraTypeList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
                 if (((*itr)->GetModifier()->m_miscvalue)==i && invLevel < (*itr)->GetModifier()->m_amount)
                     invLevel = (*itr)->GetModifier()->m_amount;
 
@@ -9935,8 +9944,8 @@ bool Unit::canDetectInvisibilityOf(Unit const* u) const
             }
             else
             {
-                Unit::AuraList const& dAuras = GetAurasByType(SPELL_AURA_MOD_INVISIBILITY_DETECTION);
-                for (Unit::AuraList::const_iterator itr = dAuras.begin(); itr != dAuras.end(); ++itr)
+                Unit::AuraTypeList const& dAuras = GetAurasByType(SPELL_AURA_MOD_INVISIBILITY_DETECTION);
+                for (Unit::AuraTypeList::const_iterator itr = dAuras.begin(); itr != dAuras.end(); ++itr)
                     if (((*itr)->GetModifier()->m_miscvalue)==i && detectLevel < (*itr)->GetModifier()->m_amount)
                         detectLevel = (*itr)->GetModifier()->m_amount;
             }
@@ -9967,8 +9976,8 @@ bool Unit::canDetectStealthOf(Unit const* target, WorldObject const* viewPoint)
     if (HasAuraType(SPELL_AURA_DETECT_STEALTH))
         return true;
 
-    AuraList const& auras = target->GetAurasByType(SPELL_AURA_MOD_STALKED); // Hunter mark
-    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end(); ++iter)
+    AuraTypeList const& auras = target->GetAurasByType(SPELL_AURA_MOD_STALKED); // Hunter mark
+    for (AuraTypeList::const_iterator iter = auras.begin(); iter != auras.end(); ++iter)
         if ((*iter)->GetCasterGUID() == GetGUID())
             return true;
 
@@ -10441,8 +10450,8 @@ Unit* Creature::SelectVictim()
 
     if (m_invisibilityMask)
     {
-        Unit::AuraList const& iAuras = GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
-        for (Unit::AuraList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
+        Unit::AuraTypeList const& iAuras = GetAurasByType(SPELL_AURA_MOD_INVISIBILITY);
+        for (Unit::AuraTypeList::const_iterator itr = iAuras.begin(); itr != iAuras.end(); ++itr)
         {
             if ((*itr)->IsPermanent())
             {
@@ -11128,11 +11137,11 @@ void Unit::ApplyPowerMod(Powers power, uint32 val, bool apply)
 
 void Unit::ApplyAuraProcTriggerDamage(Aura* aura, bool apply)
 {
-    AuraList& tAuraProcTriggerDamage = m_modAuras[SPELL_AURA_PROC_TRIGGER_DAMAGE];
+    AuraTypeList& tAuraProcTriggerDamage = m_modAuras[SPELL_AURA_PROC_TRIGGER_DAMAGE];
     if (apply)
         tAuraProcTriggerDamage.push_back(aura);
-    else
-        tAuraProcTriggerDamage.remove(aura);
+    else if (tAuraProcTriggerDamage.remove(aura))
+        m_holedAuraTypes.push_back(SPELL_AURA_PROC_TRIGGER_DAMAGE);
 }
 
 uint32 Unit::GetCreatePowers(Powers power) const
@@ -11264,8 +11273,8 @@ void Unit::DeleteCharmInfo()
 
 bool Unit::isFrozen() const
 {
-    AuraList const& mRoot = GetAurasByType(SPELL_AURA_MOD_ROOT);
-    for (AuraList::const_iterator i = mRoot.begin(); i != mRoot.end(); ++i)
+    AuraTypeList const& mRoot = GetAurasByType(SPELL_AURA_MOD_ROOT);
+    for (AuraTypeList::const_iterator i = mRoot.begin(); i != mRoot.end(); ++i)
         if (SpellMgr::GetSpellSchoolMask((*i)->GetSpellProto()) & SPELL_SCHOOL_MASK_FROST)
             return true;
     return false;
@@ -11951,10 +11960,10 @@ Unit* Unit::SelectNearbyTarget(float dist, Unit* erase) const
     else if (erase)
         targets.remove(erase);
 
-    // remove not LoS targets
+    // remove not selectable targets
     for (std::list<Unit *>::iterator tIter = targets.begin(); tIter != targets.end();)
     {
-        if (!IsWithinLOSInMap(*tIter) || (*tIter)->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NOT_SELECTABLE) ||
+        if ((*tIter)->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NOT_SELECTABLE) ||
             (*tIter)->GetTypeId() == TYPEID_UNIT && (
                 (((Creature*)(*tIter))->isCivilian() && !(*tIter)->IsInCombat()) ||
                 ((Creature*)(*tIter))->isTrigger() || ((Creature*)(*tIter))->isTotem()))
@@ -11967,6 +11976,9 @@ Unit* Unit::SelectNearbyTarget(float dist, Unit* erase) const
             ++tIter;
     }
 
+    // remove not LoS targets
+    FilterWithinLOSInMap(targets);
+
     // no appropriate targets
     if (targets.empty())
         return NULL;
@@ -12147,8 +12159,8 @@ float Unit::GetAPMultiplier(WeaponAttackType attType, bool normalized)
 
 Aura* Unit::GetDummyAura(uint32 spell_id) const
 {
-    Unit::AuraList const& mDummy = GetAurasByType(SPELL_AURA_DUMMY);
-    for (Unit::AuraList::const_iterator itr = mDummy.begin(); itr != mDummy.end(); ++itr)
+    Unit::AuraTypeList const& mDummy = GetAurasByType(SPELL_AURA_DUMMY);
+    for (Unit::AuraTypeList::const_iterator itr = mDummy.begin(); itr != mDummy.end(); ++itr)
         if ((*itr)->GetId() == spell_id)
             return *itr;
 
@@ -12655,8 +12667,8 @@ void Unit::Kill(Unit *pVictim, bool durabilityLoss)
     bool SpiritOfRedemption = false;
     if (pVictim->GetTypeId()==TYPEID_PLAYER && pVictim->GetClass()==CLASS_PRIEST)
     {
-        AuraList const& vDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
-        for (AuraList::const_iterator itr = vDummyAuras.begin(); itr != vDummyAuras.end(); ++itr)
+        AuraTypeList const& vDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
+        for (AuraTypeList::const_iterator itr = vDummyAuras.begin(); itr != vDummyAuras.end(); ++itr)
         {
             if ((*itr)->GetSpellProto()->SpellIconID==1654)
             {
@@ -12680,8 +12692,8 @@ void Unit::Kill(Unit *pVictim, bool durabilityLoss)
     bool VengeanceSpirit = false;
     if (pVictim->GetTypeId()==TYPEID_PLAYER)
     {
-        AuraList const& vDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
-        for (AuraList::const_iterator itr = vDummyAuras.begin(); itr != vDummyAuras.end(); ++itr)
+        AuraTypeList const& vDummyAuras = pVictim->GetAurasByType(SPELL_AURA_DUMMY);
+        for (AuraTypeList::const_iterator itr = vDummyAuras.begin(); itr != vDummyAuras.end(); ++itr)
         {
             if ((*itr)->GetSpellProto()->Id == 40251)
             {
@@ -821,6 +821,79 @@ class HELLGROUND_IMPORT_EXPORT Unit : public WorldObject
         typedef std::pair<uint32, uint8> spellEffectPair;
         typedef std::multimap< spellEffectPair, Aura*> AuraMap;
         typedef std::list<Aura *> AuraList;
+
+        // auras of one AuraType stored contiguously. Removed auras leave a hole
+        // skipped by iterators and compacted on next spells update, so removing
+        // or adding auras while iterating keeps iterators to other auras valid
+        class AuraTypeList
+        {
+            public:
+                class const_iterator
+                {
+                    public:
+                        typedef std::forward_iterator_tag iterator_category;
+                        typedef Aura* value_type;
+                        typedef ptrdiff_t difference_type;
+                        typedef Aura* const* pointer;
+                        typedef Aura* const& reference;
+
+                        const_iterator() : m_auras(NULL), m_index(0) {}
+                        const_iterator(std::vector<Aura*> const* auras, size_t index) : m_auras(auras), m_index(index) { SkipHoles(); }
+
+                        reference operator*() const { return (*m_auras)[m_index]; }
+                        pointer operator->() const { return &(*m_auras)[m_index]; }
+
+                        const_iterator& operator++() { ++m_index; SkipHoles(); return *this; }
+                        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+
+                        bool operator==(const_iterator const& other) const { return m_index == other.m_index; }
+                        bool operator!=(const_iterator const& other) const { return m_index != other.m_index; }
+
+                    private:
+                        void SkipHoles()
+                        {
+                            while (m_index < m_auras->size() && !(*m_auras)[m_index])
+                                ++m_index;
+                        }
+
+                        std::vector<Aura*> const* m_auras;
+                        size_t m_index;
+                };
+                typedef const_iterator iterator;
+
+                AuraTypeList() : m_count(0) {}
+
+                const_iterator begin() const { return const_iterator(&m_auras, 0); }
+                const_iterator end() const { return const_iterator(&m_auras, m_auras.size()); }
+
+                bool empty() const { return !m_count; }
+                size_t size() const { return m_count; }
+                Aura* front() const { return *begin(); }
+
+                void push_back(Aura* aura) { m_auras.push_back(aura); ++m_count; }
+
+                // returns true if this made the first hole since last compact
+                bool remove(Aura* aura)
+                {
+                    std::vector<Aura*>::iterator itr = std::find(m_auras.begin(), m_auras.end(), aura);
+                    if (itr == m_auras.end())
+                        return false;
+
+                    *itr = NULL;
+                    --m_count;
+                    return m_auras.size() == m_count + 1;
+                }
+
+                void clear() { m_auras.clear(); m_count = 0; }
+
+                // must not be called while the list is iterated
+                void compact() { m_auras.erase(std::remove(m_auras.begin(), m_auras.end(), (Aura*)NULL), m_auras.end()); }
+
+            private:
+                std::vector<Aura*> m_auras;
+                size_t m_count;
+        };
+
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<AuraType> AuraTypeSet;
         typedef std::set<uint32> ComboPointHolderSet;
@@ -1452,7 +1525,7 @@ class HELLGROUND_IMPORT_EXPORT Unit : public WorldObject
         Aura* GetAura(uint32 spellId, uint32 effindex);
         AuraMap      & GetAuras()       { return m_Auras; }
         AuraMap const& GetAuras() const { return m_Auras; }
-        AuraList const& GetAurasByType(AuraType type) const { return m_modAuras[type]; }
+        AuraTypeList const& GetAurasByType(AuraType type) const { return m_modAuras[type]; }
         void ApplyAuraProcTriggerDamage(Aura* aura, bool apply);
 
         int32 GetTotalAuraModifier(AuraType auratype) const;
@@ -1685,7 +1758,8 @@ class HELLGROUND_IMPORT_EXPORT Unit : public WorldObject
         uint32 m_transform;
         AuraList m_removedAuras;
 
-        AuraList *m_modAuras;
+        AuraTypeList *m_modAuras;
+        std::vector<AuraType> m_holedAuraTypes;    // m_modAuras entries to compact on next spells update
         AuraList m_scAuras;                        // cast singlecast auras
         AuraList m_interruptableAuras;
         AuraList m_ccAuras;
@@ -27,6 +27,11 @@
 #include "World.h"
 #include <zlib/zlib.h>
 
+#include <ace/TSS_T.h>
+#include <ace/High_Res_Timer.h>
+
+#include <atomic>
+
 UpdateData::UpdateData() : m_blockCount(0)
 {
 }
@@ -47,44 +52,164 @@ void UpdateData::AddUpdateBlock(const ByteBuffer &block)
     ++m_blockCount;
 }
 
-void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+// zlib state (~256KB with default settings) and packet assembly buffer kept per thread,
+// so compressing update packets does not allocate after the first packet
+class UpdateDataCompressor
 {
-    z_stream c_stream;
+    public:
+        UpdateDataCompressor() : m_level(0)
+        {
+            m_stream.zalloc = (alloc_func)0;
+            m_stream.zfree = (free_func)0;
+            m_stream.opaque = (voidpf)0;
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_registryLock);
+            m_registry.insert(this);
+        }
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        sLog.outLog(LOG_DEFAULT, "ERROR: Can't compress update packet (zlib: deflateInit) Error code: %i (%s)",z_res,zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        ~UpdateDataCompressor()
+        {
+            if (m_level)
+                deflateEnd(&m_stream);
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_registryLock);
+            m_stats.AddTo(m_finished);
+            m_registry.erase(this);
+        }
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        sLog.outLog(LOG_DEFAULT, "ERROR: Can't compress update packet (zlib: deflate) Error code: %i (%s)",z_res,zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        z_stream* GetStream(int level)
+        {
+            if (m_level == level)
+            {
+                int z_res = deflateReset(&m_stream);
+                if (z_res == Z_OK)
+                    return &m_stream;
+
+                sLog.outLog(LOG_DEFAULT, "ERROR: Can't compress update packet (zlib: deflateReset) Error code: %i (%s)",z_res,zError(z_res));
+            }
+
+            // first use or compression level changed
+            if (m_level)
+            {
+                deflateEnd(&m_stream);
+                m_level = 0;
+            }
+
+            int z_res = deflateInit(&m_stream, level);
+            if (z_res != Z_OK)
+            {
+                sLog.outLog(LOG_DEFAULT, "ERROR: Can't compress update packet (zlib: deflateInit) Error code: %i (%s)",z_res,zError(z_res));
+                return NULL;
+            }
+
+            m_level = level;
+            return &m_stream;
+        }
+
+        ByteBuffer& GetBuffer() { return m_buffer; }
 
-    if (c_stream.avail_in != 0)
+        void AddStats(uint32 in, uint32 out, uint64 timeNs)
+        {
+            m_stats.packets.fetch_add(1, std::memory_order_relaxed);
+            m_stats.bytesIn.fetch_add(in, std::memory_order_relaxed);
+            m_stats.bytesOut.fetch_add(out, std::memory_order_relaxed);
+            m_stats.timeNs.fetch_add(timeNs, std::memory_order_relaxed);
+        }
+
+        static UpdateCompressionStats GetStats()
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_registryLock, UpdateCompressionStats());
+
+            UpdateCompressionStats stats = m_finished;
+            for (std::set<UpdateDataCompressor*>::const_iterator itr = m_registry.begin(); itr != m_registry.end(); ++itr)
+                (*itr)->m_stats.AddTo(stats);
+
+            return stats;
+        }
+
+        static void ResetStats()
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_registryLock);
+
+            m_finished = UpdateCompressionStats();
+            for (std::set<UpdateDataCompressor*>::const_iterator itr = m_registry.begin(); itr != m_registry.end(); ++itr)
+                (*itr)->m_stats.Reset();
+        }
+
+    private:
+        // written by owning thread only, read and reset by others through the registry
+        struct Counters
+        {
+            Counters() : packets(0), bytesIn(0), bytesOut(0), timeNs(0) {}
+
+            void AddTo(UpdateCompressionStats& stats) const
+            {
+                stats.packets += packets.load(std::memory_order_relaxed);
+                stats.bytesIn += bytesIn.load(std::memory_order_relaxed);
+                stats.bytesOut += bytesOut.load(std::memory_order_relaxed);
+                stats.timeNs += timeNs.load(std::memory_order_relaxed);
+            }
+
+            void Reset()
+            {
+                packets.store(0, std::memory_order_relaxed);
+                bytesIn.store(0, std::memory_order_relaxed);
+                bytesOut.store(0, std::memory_order_relaxed);
+                timeNs.store(0, std::memory_order_relaxed);
+            }
+
+            std::atomic<uint64> packets;
+            std::atomic<uint64> bytesIn;
+            std::atomic<uint64> bytesOut;
+            std::atomic<uint64> timeNs;
+        };
+
+        z_stream m_stream;
+        int m_level;
+        ByteBuffer m_buffer;
+        Counters m_stats;
+
+        static ACE_Thread_Mutex m_registryLock;
+        static std::set<UpdateDataCompressor*> m_registry;
+        static UpdateCompressionStats m_finished;           // stats of already finished threads
+};
+
+ACE_Thread_Mutex UpdateDataCompressor::m_registryLock;
+std::set<UpdateDataCompressor*> UpdateDataCompressor::m_registry;
+UpdateCompressionStats UpdateDataCompressor::m_finished;
+
+typedef ACE_TSS<UpdateDataCompressor> UpdateDataCompressorTSS;
+static UpdateDataCompressorTSS compressor;
+
+UpdateCompressionStats UpdateData::GetCompressionStats()
+{
+    return UpdateDataCompressor::GetStats();
+}
+
+void UpdateData::ResetCompressionStats()
+{
+    UpdateDataCompressor::ResetStats();
+}
+
+void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
+{
+    ACE_hrtime_t startTime = ACE_OS::gethrtime();
+
+    // default Z_BEST_SPEED (1)
+    z_stream* c_stream = compressor->GetStream(sWorld.getConfig(CONFIG_COMPRESSION));
+    if (!c_stream)
     {
-        sLog.outLog(LOG_DEFAULT, "ERROR: Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
+
+    // whole packet is available, single call finishes the stream
+    int z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outLog(LOG_DEFAULT, "ERROR: Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)",z_res,zError(z_res));
@@ -92,21 +217,17 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outLog(LOG_DEFAULT, "ERROR: Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)",z_res,zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
 
-    *dst_size = c_stream.total_out;
+    compressor->AddStats(src_size, *dst_size, ACE_OS::gethrtime() - startTime);
 }
 
 bool UpdateData::BuildPacket(WorldPacket *packet, bool hasTransport)
 {
     //ByteBuffer buf(m_data.size() + 10 + m_outOfRangeGUIDs.size()*8);
-    ByteBuffer buf(4 + 1 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.size());
+    ByteBuffer& buf = compressor->GetBuffer();
+    buf.clear();
+    buf.reserve(4 + 1 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.size());
 
     buf << uint32(!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
     buf << uint8(hasTransport ? 1 : 0);
@@ -45,6 +45,16 @@ enum OBJECT_UPDATE_FLAGS
     UPDATEFLAG_HAS_POSITION  = 0x40
 };
 
+struct UpdateCompressionStats
+{
+    UpdateCompressionStats() : packets(0), bytesIn(0), bytesOut(0), timeNs(0) {}
+
+    uint64 packets;
+    uint64 bytesIn;
+    uint64 bytesOut;
+    uint64 timeNs;
+};
+
 class UpdateData
 {
     public:
@@ -59,6 +69,10 @@ class UpdateData
 
         std::set<uint64> const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        // summed over all threads compressing update packets
+        static UpdateCompressionStats GetCompressionStats();
+        static void ResetCompressionStats();
+
     protected:
         uint32 m_blockCount;
         std::set<uint64> m_outOfRangeGUIDs;
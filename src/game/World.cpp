@@ -51,6 +51,7 @@
 #include "TemporarySummon.h"
 #include "WaypointMovementGenerator.h"
 #include "VMapFactory.h"
+#include "LoSPool.h"
 #include "movemap/MoveMap.h"
 #include "GameEvent.h"
 #include "PoolManager.h"
@@ -70,6 +71,7 @@
 
 //#include "Timer.h"
 #include "GuildMgr.h"
+#include "StartupLoader.h"
 
 volatile bool World::m_stopEvent = false;
 uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -150,6 +152,8 @@ World::~World()
         delete command;
 
 
+    sTerrainMgr.StopPreload();
+    sLoSPool.Stop();
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 
@@ -469,6 +473,8 @@ void World::LoadConfigSettings(bool reload)
     loadConfig(CONFIG_ADDON_CHANNEL, "AddonChannel", false);
     loadConfig(CONFIG_SAVE_RESPAWN_TIME_IMMEDIATELY, "SaveRespawnTimeImmediately", true);
     loadConfig(CONFIG_GRID_UNLOAD, "GridUnload", true);
+    loadConfig(CONFIG_GRID_PRELOAD_TIME, "GridPreload.LookAhead", 10);
+    loadConfig(CONFIG_GRID_PRELOAD_CELLS, "GridPreload.CellsPerUpdate", 16);
 
     loadConfig(CONFIG_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 600000);
     loadConfig(CONFIG_INTERVAL_SAVE, "PlayerSaveInterval", 900000);
@@ -482,6 +488,12 @@ void World::LoadConfigSettings(bool reload)
     loadConfig(CONFIG_MAPUPDATE_INSTANCES, "MapUpdate.Instances", 50);
     loadConfig(CONFIG_MAPUPDATE_BATTLEGROUNDS, "MapUpdate.Battlegrounds", 50);
     loadConfig(CONFIG_MAPUPDATE_ARENAS, "MapUpdate.Arena", 50);
+    loadConfig(CONFIG_MAPUPDATE_COST_SAMPLES, "MapUpdate.CostSamples", 10);
+    loadConfig(CONFIG_MAPUPDATE_REGION_THREADS, "MapUpdate.ContinentRegionThreads", 0);
+    loadConfig(CONFIG_MAPUPDATE_PACKET_THREADS, "MapUpdate.PacketThreads", 0);
+    loadConfig(CONFIG_MAPUPDATE_PACKET_MIN_PLAYERS, "MapUpdate.PacketMinPlayers", 10);
+
+    loadConfig(CONFIG_STARTUP_LOAD_THREADS, "StartupLoad.Threads", 1);
 
     sessionThreads = sConfig.GetIntDefault("SessionUpdate.Threads", 0);
     loadConfig(CONFIG_SESSION_UPDATE_MAX_TIME, "SessionUpdate.MaxTime", 1000);
@@ -489,6 +501,7 @@ void World::LoadConfigSettings(bool reload)
     loadConfig(CONFIG_SESSION_UPDATE_VERBOSE_LOG, "SessionUpdate.VerboseLog", 0);
     loadConfig(CONFIG_SESSION_UPDATE_IDLE_KICK, "SessionUpdate.IdleKickTimer", 15*MINUTE*IN_MILISECONDS);
     loadConfig(CONFIG_SESSION_UPDATE_MIN_LOG_DIFF, "SessionUpdate.MinLogDiff", 25);
+    loadConfig(CONFIG_SESSION_RECV_QUEUE_SIZE, "SessionUpdate.RecvQueueSize", 4096);
     loadConfig(CONFIG_INTERVAL_LOG_UPDATE, "RecordUpdateTimeDiffInterval", 60000);
     loadConfig(CONFIG_MIN_LOG_UPDATE, "DiffRecord.Update", 300);
     loadConfig(CONFIG_MIN_LOG_CELL, "DiffRecord.Cell", 300);
@@ -805,12 +818,20 @@ void World::LoadConfigSettings(bool reload)
     loadConfig(CONFIG_VMAP_TOTEM, "vmap.totem", false);
     loadConfig(CONFIG_VMAP_GROUND, "vmap.ground.enable", 0);
     loadConfig(CONFIG_VMAP_GROUND_TOLERANCE, "vmap.ground.tolerance", 5.0f);
+    loadConfig(CONFIG_VMAP_LOS_THREADS, "vmap.losThreads", 0);
+    loadConfig(CONFIG_GRIDMAP_MMAP, "GridMap.MemoryMapped", false);
 
     loadConfig(CONFIG_MMAP_ENABLED, "mmap.enabled", true);
     sLog.outString("WORLD: mmap pathfinding %sabled", getConfig(CONFIG_MMAP_ENABLED) ? "en" : "dis");
+    loadConfig(CONFIG_MMAP_PATH_CACHE_SIZE, "mmap.pathCacheSize", 1024);
+    loadConfig(CONFIG_MMAP_REPATH_PER_UPDATE, "mmap.repathsPerUpdate", 64);
+    loadConfig(CONFIG_MMAP_PATH_THREADS, "mmap.pathThreads", 2);
+    loadConfig(CONFIG_MMAP_QUERY_POOL_SIZE, "mmap.queryPoolSize", 4);
+    loadConfig(CONFIG_MMAP_MEMORY_MAPPED, "mmap.memoryMapped", false);
 
     // visibility and radiuses
     loadConfig(CONFIG_GROUP_VISIBILITY, "Visibility.GroupMode", 0);
+    loadConfig(CONFIG_VISIBILITY_INCREMENTAL, "Visibility.Incremental", true);
     m_activeObjectUpdateDistanceOnContinents = sConfig.GetIntDefault("Visibility.Distance.ActiveObjectUpdate.Continents", DEFAULT_VISIBILITY_DISTANCE);
     m_activeObjectUpdateDistanceInInstances = sConfig.GetIntDefault("Visibility.Distance.ActiveObjectUpdate.Instances", DEFAULT_VISIBILITY_DISTANCE);
 
@@ -1149,260 +1170,508 @@ void World::SetInitialWorldSettings()
     //sLog.outString("Loading Localization strings...");
     sObjectMgr.SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
+    ///- Load static and dynamic data, loaders run in parallel when StartupLoad.Threads > 1
+    ///- dependencies list loaders whose data is needed, loaders sharing a container are chained
+    StartupLoader loader;
 
-    sLog.outString("Loading Game Object Templates...");   // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
+    loader.AddTask("PageTexts", []()
+    {
+        sLog.outString("Loading Page Texts...");
+        sObjectMgr.LoadPageTexts();
+    });
 
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
+    loader.AddTask("GameobjectInfo", []()
+    {
+        sLog.outString("Loading Game Object Templates...");
+        sObjectMgr.LoadGameobjectInfo();
+    }, { "PageTexts" });
 
-    sLog.outString("Loading Spell Required Data...");
-    sSpellMgr.LoadSpellRequired();
+    loader.AddTask("SpellChains", []()
+    {
+        sLog.outString("Loading Spell Chain Data...");
+        sSpellMgr.LoadSpellChains();
+    });
 
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
+    loader.AddTask("SpellRequired", []()
+    {
+        sLog.outString("Loading Spell Required Data...");
+        sSpellMgr.LoadSpellRequired();
+    }, { "SpellChains" });
 
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                        // must be after LoadSpellChains
+    loader.AddTask("SpellElixirs", []()
+    {
+        sLog.outString("Loading Spell Elixir types...");
+        sSpellMgr.LoadSpellElixirs();
+    });
 
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
+    loader.AddTask("SpellLearnSkills", []()
+    {
+        sLog.outString("Loading Spell Learn Skills...");
+        sSpellMgr.LoadSpellLearnSkills();
+    }, { "SpellChains" });
 
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
+    loader.AddTask("SpellLearnSpells", []()
+    {
+        sLog.outString("Loading Spell Learn Spells...");
+        sSpellMgr.LoadSpellLearnSpells();
+    }, { "SpellChains" });
 
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
+    loader.AddTask("SpellProcEvents", []()
+    {
+        sLog.outString("Loading Spell Proc Event conditions...");
+        sSpellMgr.LoadSpellProcEvents();
+    });
 
-    sLog.outString("Loading Unqueued Account List...");
-    sObjectMgr.LoadUnqueuedAccountList();
+    loader.AddTask("SpellThreats", []()
+    {
+        sLog.outString("Loading Aggro Spells Definitions...");
+        sSpellMgr.LoadSpellThreats();
+    });
 
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
+    loader.AddTask("UnqueuedAccountList", []()
+    {
+        sLog.outString("Loading Unqueued Account List...");
+        sObjectMgr.LoadUnqueuedAccountList();
+    });
 
-    sLog.outString("Loading Enchant Spells Proc datas...");
-    sSpellMgr.LoadSpellEnchantProcData();
+    loader.AddTask("GossipText", []()
+    {
+        sLog.outString("Loading NPC Texts...");
+        sObjectMgr.LoadGossipText();
+    });
 
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    loader.AddTask("SpellEnchantProcData", []()
+    {
+        sLog.outString("Loading Enchant Spells Proc datas...");
+        sSpellMgr.LoadSpellEnchantProcData();
+    });
 
-    sLog.outString("Loading Items...");                   // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
+    loader.AddTask("RandomEnchantments", []()
+    {
+        sLog.outString("Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
+
+    loader.AddTask("ItemPrototypes", []()
+    {
+        sLog.outString("Loading Items...");
+        sObjectMgr.LoadItemPrototypes();
+    }, { "RandomEnchantments", "PageTexts" });
 
-    sLog.outString("Loading Item Texts...");
-    sObjectMgr.LoadItemTexts();
+    loader.AddTask("ItemTexts", []()
+    {
+        sLog.outString("Loading Item Texts...");
+        sObjectMgr.LoadItemTexts();
+    });
 
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
+    loader.AddTask("CreatureModelInfo", []()
+    {
+        sLog.outString("Loading Creature Model Based Info Data...");
+        sObjectMgr.LoadCreatureModelInfo();
+    });
 
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
+    loader.AddTask("EquipmentTemplates", []()
+    {
+        sLog.outString("Loading Equipment templates...");
+        sObjectMgr.LoadEquipmentTemplates();
+    }, { "ItemPrototypes" });
 
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
+    loader.AddTask("CreatureTemplates", []()
+    {
+        sLog.outString("Loading Creature templates...");
+        sObjectMgr.LoadCreatureTemplates();
+    }, { "CreatureModelInfo", "EquipmentTemplates" });
 
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                       // must be after LoadCreatureTemplates and LoadGameobjectInfo
+    loader.AddTask("SpellScriptTarget", []()
+    {
+        sLog.outString("Loading SpellsScriptTarget...");
+        sSpellMgr.LoadSpellScriptTarget();
+    }, { "CreatureTemplates", "GameobjectInfo" });
 
-    sLog.outString( "Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
+    loader.AddTask("ReputationRewardRate", []()
+    {
+        sLog.outString( "Loading Reputation Reward Rates...");
+        sObjectMgr.LoadReputationRewardRate();
+    });
 
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
+    loader.AddTask("ReputationOnKill", []()
+    {
+        sLog.outString("Loading Creature Reputation OnKill Data...");
+        sObjectMgr.LoadReputationOnKill();
+    }, { "CreatureTemplates" });
 
-    sLog.outString( "Loading Reputation Spillover Data..." );
-    sObjectMgr.LoadReputationSpilloverTemplate();
+    loader.AddTask("ReputationSpillover", []()
+    {
+        sLog.outString( "Loading Reputation Spillover Data..." );
+        sObjectMgr.LoadReputationSpilloverTemplate();
+    });
 
-    sLog.outString("Loading Pet Create Spells...");
-    sObjectMgr.LoadPetCreateSpells();
+    loader.AddTask("PetCreateSpells", []()
+    {
+        sLog.outString("Loading Pet Create Spells...");
+        sObjectMgr.LoadPetCreateSpells();
+    }, { "CreatureTemplates" });
 
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
+    loader.AddTask("Creatures", []()
+    {
+        sLog.outString("Loading Creature Data...");
+        sObjectMgr.LoadCreatures();
+    }, { "CreatureTemplates" });
 
-    sLog.outString("Loading Creature Linked Respawn...");
-    sObjectMgr.LoadCreatureLinkedRespawn();                     // must be after LoadCreatures()
+    loader.AddTask("CreatureLinkedRespawn", []()
+    {
+        sLog.outString("Loading Creature Linked Respawn...");
+        sObjectMgr.LoadCreatureLinkedRespawn();
+    }, { "Creatures" });
 
-    sLog.outString("Loading Creature Addon Data...");
-    sObjectMgr.LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+    loader.AddTask("CreatureAddons", []()
+    {
+        sLog.outString("Loading Creature Addon Data...");
+        sObjectMgr.LoadCreatureAddons();
+    }, { "CreatureTemplates", "Creatures" });
 
-    sLog.outString("Loading Creature Respawn Data...");   // must be after PackInstances()
-    sObjectMgr.LoadCreatureRespawnTimes();
+    loader.AddTask("CreatureRespawnTimes", []()
+    {
+        sLog.outString("Loading Creature Respawn Data...");
+        sObjectMgr.LoadCreatureRespawnTimes();
+    });
 
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameobjects();
+    // creatures, gameobjects, pools, game events and corpses all fill the cell guid maps
+    loader.AddTask("Gameobjects", []()
+    {
+        sLog.outString("Loading Gameobject Data...");
+        sObjectMgr.LoadGameobjects();
+    }, { "GameobjectInfo", "Creatures" });
 
-    sLog.outString("Loading Gameobject Respawn Data..."); // must be after PackInstances()
-    sObjectMgr.LoadGameobjectRespawnTimes();
+    loader.AddTask("GameobjectRespawnTimes", []()
+    {
+        sLog.outString("Loading Gameobject Respawn Data...");
+        sObjectMgr.LoadGameobjectRespawnTimes();
+    });
 
-    sLog.outString("Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
+    loader.AddTask("Pools", []()
+    {
+        sLog.outString("Loading Objects Pooling Data...");
+        sPoolMgr.LoadFromDB();
+    }, { "Creatures", "Gameobjects" });
 
-    sLog.outString("Loading Game Event Data...");
-    sGameEventMgr.LoadFromDB();
+    loader.AddTask("GameEvents", []()
+    {
+        sLog.outString("Loading Game Event Data...");
+        sGameEventMgr.LoadFromDB();
+    }, { "Pools" });
 
-    sLog.outString("Loading Weather Data...");
-    sObjectMgr.LoadWeatherZoneChances();
+    loader.AddTask("WeatherZoneChances", []()
+    {
+        sLog.outString("Loading Weather Data...");
+        sObjectMgr.LoadWeatherZoneChances();
+    });
 
-    sLog.outString("Loading Quests...");
-    sObjectMgr.LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loader.AddTask("Quests", []()
+    {
+        sLog.outString("Loading Quests...");
+        sObjectMgr.LoadQuests();
+    }, { "ItemPrototypes", "CreatureTemplates", "Gameobjects" });
 
-    sLog.outString("Loading Quests Relations...");
-    sObjectMgr.LoadQuestRelations();                            // must be after quest load
+    loader.AddTask("QuestRelations", []()
+    {
+        sLog.outString("Loading Quests Relations...");
+        sObjectMgr.LoadQuestRelations();
+    }, { "Quests", "GameEvents" });
 
-    sLog.outString("Loading AreaTrigger definitions...");
-    sObjectMgr.LoadAreaTriggerTeleports();
+    loader.AddTask("AreaTriggerTeleports", []()
+    {
+        sLog.outString("Loading AreaTrigger definitions...");
+        sObjectMgr.LoadAreaTriggerTeleports();
+    });
 
-    sLog.outString("Loading Access Requirements...");
-    sObjectMgr.LoadAccessRequirements();                        // must be after item template load
+    loader.AddTask("AccessRequirements", []()
+    {
+        sLog.outString("Loading Access Requirements...");
+        sObjectMgr.LoadAccessRequirements();
+    }, { "ItemPrototypes", "Quests" });
 
-    sLog.outString("Loading Quest Area Triggers...");
-    sObjectMgr.LoadQuestAreaTriggers();                         // must be after LoadQuests
+    loader.AddTask("QuestAreaTriggers", []()
+    {
+        sLog.outString("Loading Quest Area Triggers...");
+        sObjectMgr.LoadQuestAreaTriggers();
+    }, { "Quests" });
 
-    sLog.outString("Loading Tavern Area Triggers...");
-    sObjectMgr.LoadTavernAreaTriggers();
+    loader.AddTask("TavernAreaTriggers", []()
+    {
+        sLog.outString("Loading Tavern Area Triggers...");
+        sObjectMgr.LoadTavernAreaTriggers();
+    });
 
-    sLog.outString("Loading AreaTrigger script names...");
-    sScriptMgr.LoadAreaTriggerScripts();
+    loader.AddTask("AreaTriggerScripts", []()
+    {
+        sLog.outString("Loading AreaTrigger script names...");
+        sScriptMgr.LoadAreaTriggerScripts();
+    });
 
-    sLog.outString("Loading CompletedCinematic script names...");
-    sScriptMgr.LoadCompletedCinematicScripts();
+    loader.AddTask("CompletedCinematicScripts", []()
+    {
+        sLog.outString("Loading CompletedCinematic script names...");
+        sScriptMgr.LoadCompletedCinematicScripts();
+    });
 
-    sLog.outString("Loading event id script names...");
-    sScriptMgr.LoadEventIdScripts();
+    loader.AddTask("EventIdScripts", []()
+    {
+        sLog.outString("Loading event id script names...");
+        sScriptMgr.LoadEventIdScripts();
+    }, { "GameobjectInfo" });
 
-    sLog.outString("Loading spell id script names...");
-    sScriptMgr.LoadSpellIdScripts();
+    loader.AddTask("SpellIdScripts", []()
+    {
+        sLog.outString("Loading spell id script names...");
+        sScriptMgr.LoadSpellIdScripts();
+    });
 
-    sLog.outString("Loading Graveyard-zone links...");
-    sObjectMgr.LoadGraveyardZones();
+    loader.AddTask("GraveyardZones", []()
+    {
+        sLog.outString("Loading Graveyard-zone links...");
+        sObjectMgr.LoadGraveyardZones();
+    });
 
-    sLog.outString("Loading Spell target coordinates...");
-    sSpellMgr.LoadSpellTargetPositions();
+    loader.AddTask("SpellTargetPositions", []()
+    {
+        sLog.outString("Loading Spell target coordinates...");
+        sSpellMgr.LoadSpellTargetPositions();
+    });
 
-    sLog.outString("Loading SpellAffect definitions...");
-    sSpellMgr.LoadSpellAffects();
+    loader.AddTask("SpellAffects", []()
+    {
+        sLog.outString("Loading SpellAffect definitions...");
+        sSpellMgr.LoadSpellAffects();
+    });
 
-    sLog.outString("Loading spell pet auras...");
-    sSpellMgr.LoadSpellPetAuras();
+    loader.AddTask("SpellPetAuras", []()
+    {
+        sLog.outString("Loading spell pet auras...");
+        sSpellMgr.LoadSpellPetAuras();
+    });
 
-    sLog.outString("Loading spell extra attributes...(TODO)");
-    sSpellMgr.LoadSpellCustomAttr();
+    // modifies spell entries read by most loaders
+    loader.AddBarrier("SpellCustomAttr", []()
+    {
+        sLog.outString("Loading spell extra attributes...(TODO)");
+        sSpellMgr.LoadSpellCustomAttr();
+    });
 
-    sLog.outString("Loading linked spells...");
-    sSpellMgr.LoadSpellLinked();
+    loader.AddTask("SpellLinked", []()
+    {
+        sLog.outString("Loading linked spells...");
+        sSpellMgr.LoadSpellLinked();
+    });
 
-    sLog.outString("Loading player Create Info & Level Stats...");
-    sObjectMgr.LoadPlayerInfo();
+    loader.AddTask("PlayerInfo", []()
+    {
+        sLog.outString("Loading player Create Info & Level Stats...");
+        sObjectMgr.LoadPlayerInfo();
+    }, { "ItemPrototypes" });
 
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
+    loader.AddTask("ExplorationBaseXP", []()
+    {
+        sLog.outString("Loading Exploration BaseXP Data...");
+        sObjectMgr.LoadExplorationBaseXP();
+    });
 
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
+    loader.AddTask("PetNames", []()
+    {
+        sLog.outString("Loading Pet Name Parts...");
+        sObjectMgr.LoadPetNames();
+    });
 
-    sLog.outString("Loading the max pet number...");
-    sObjectMgr.LoadPetNumber();
+    loader.AddTask("PetNumber", []()
+    {
+        sLog.outString("Loading the max pet number...");
+        sObjectMgr.LoadPetNumber();
+    });
 
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
+    loader.AddTask("PetLevelInfo", []()
+    {
+        sLog.outString("Loading pet level stats...");
+        sObjectMgr.LoadPetLevelInfo();
+    }, { "CreatureTemplates" });
 
-    sLog.outString("Loading Player Corpses...");
-    sObjectMgr.LoadCorpses();
+    loader.AddTask("Corpses", []()
+    {
+        sLog.outString("Loading Player Corpses...");
+        sObjectMgr.LoadCorpses();
+    }, { "GameEvents" });
 
-    sLog.outString("Loading Disabled Spells...");
-    sObjectMgr.LoadSpellDisabledEntrys();
+    loader.AddTask("SpellDisabledEntrys", []()
+    {
+        sLog.outString("Loading Disabled Spells...");
+        sObjectMgr.LoadSpellDisabledEntrys();
+    });
 
-    sLog.outString("Loading PlayerBot ..."); // Requires Players cache
-    sPlayerBotMgr.Load();
+    loader.AddTask("PlayerBots", []()
+    {
+        sLog.outString("Loading PlayerBot ..."); // Requires Players cache
+        sPlayerBotMgr.Load();
+    }, { "PlayerInfo" });
 
-    sLog.outString("Loading Loot Tables...");
-    LoadLootTables();
+    // loot conditions are checked against game events
+    loader.AddTask("LootTables", []()
+    {
+        sLog.outString("Loading Loot Tables...");
+        LoadLootTables();
+    }, { "ItemPrototypes", "CreatureTemplates", "GameobjectInfo", "Quests", "GameEvents" });
 
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loader.AddTask("SkillDiscoveryTable", []()
+    {
+        sLog.outString("Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    }, { "SpellChains" });
 
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    loader.AddTask("SkillExtraItemTable", []()
+    {
+        sLog.outString("Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    }, { "SpellChains" });
 
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
+    loader.AddTask("FishingBaseSkillLevel", []()
+    {
+        sLog.outString("Loading Skill Fishing base level requirements...");
+        sObjectMgr.LoadFishingBaseSkillLevel();
+    });
 
     ///- Load dynamic data tables from the database
-    sLog.outString("Loading Auctions...");
-    sAuctionMgr.LoadAuctionItems();
-    sAuctionMgr.LoadAuctions();
+    loader.AddTask("Auctions", []()
+    {
+        sLog.outString("Loading Auctions...");
+        sAuctionMgr.LoadAuctionItems();
+        sAuctionMgr.LoadAuctions();
+    }, { "ItemPrototypes" });
 
-    sLog.outString("Loading Guilds...");
-    sGuildMgr.LoadGuilds();
+    loader.AddTask("Guilds", []()
+    {
+        sLog.outString("Loading Guilds...");
+        sGuildMgr.LoadGuilds();
+    }, { "ItemPrototypes" });
 
-    sLog.outString("Loading ArenaTeams...");
-    sObjectMgr.LoadArenaTeams();
+    loader.AddTask("ArenaTeams", []()
+    {
+        sLog.outString("Loading ArenaTeams...");
+        sObjectMgr.LoadArenaTeams();
+    }, { "Guilds" });
 
-    sLog.outString("Loading Groups...");
-    sObjectMgr.LoadGroups();
+    loader.AddTask("Groups", []()
+    {
+        sLog.outString("Loading Groups...");
+        sObjectMgr.LoadGroups();
+    }, { "ArenaTeams" });
 
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
+    loader.AddTask("ReservedPlayersNames", []()
+    {
+        sLog.outString("Loading ReservedNames...");
+        sObjectMgr.LoadReservedPlayersNames();
+    });
 
     //sLog.outString("Loading GameObject for quests...");
     //sObjectMgr.LoadGameObjectForQuests();
 
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry();
+    loader.AddTask("BattleMasters", []()
+    {
+        sLog.outString("Loading BattleMasters...");
+        sBattleGroundMgr.LoadBattleMastersEntry();
+    }, { "CreatureTemplates" });
 
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
+    loader.AddTask("GameTele", []()
+    {
+        sLog.outString("Loading GameTeleports...");
+        sObjectMgr.LoadGameTele();
+    });
 
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcTextId();                                 // must be after load Creature and NpcText
+    loader.AddTask("NpcTextId", []()
+    {
+        sLog.outString("Loading Npc Text Id...");
+        sObjectMgr.LoadNpcTextId();
+    }, { "Creatures", "GossipText" });
 
-    sLog.outString("Loading Npc Options...");
-    sObjectMgr.LoadNpcOptions();
+    loader.AddTask("NpcOptions", []()
+    {
+        sLog.outString("Loading Npc Options...");
+        sObjectMgr.LoadNpcOptions();
+    });
 
-    sLog.outString("Loading vendors...");
-    sObjectMgr.LoadVendors();                                   // must be after load CreatureTemplate and ItemPrototype
+    loader.AddTask("Vendors", []()
+    {
+        sLog.outString("Loading vendors...");
+        sObjectMgr.LoadVendors();
+    }, { "CreatureTemplates", "ItemPrototypes" });
 
-    sLog.outString("Loading trainers...");
-    sObjectMgr.LoadTrainerSpell();                              // must be after load CreatureTemplate
+    loader.AddTask("TrainerSpell", []()
+    {
+        sLog.outString("Loading trainers...");
+        sObjectMgr.LoadTrainerSpell();
+    }, { "CreatureTemplates" });
 
-    sLog.outString("Loading opcodes cooldown...");
-    sObjectMgr.LoadOpcodesCooldown();
+    loader.AddTask("OpcodesCooldown", []()
+    {
+        sLog.outString("Loading opcodes cooldown...");
+        sObjectMgr.LoadOpcodesCooldown();
+    });
 
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
+    loader.AddTask("Waypoints", []()
+    {
+        sLog.outString("Loading Waypoints...");
+        sWaypointMgr.Load();
+    });
 
-    sLog.outString("Loading Creature Formations...");
-    CreatureGroupManager::LoadCreatureFormations();
+    loader.AddTask("CreatureFormations", []()
+    {
+        sLog.outString("Loading Creature Formations...");
+        CreatureGroupManager::LoadCreatureFormations();
+    }, { "Creatures" });
 
-    sLog.outString("Loading GM tickets...");
-    sTicketMgr.LoadGMTickets();
+    loader.AddTask("GMTickets", []()
+    {
+        sLog.outString("Loading GM tickets...");
+        sTicketMgr.LoadGMTickets();
+    });
 
     ///- Handle outdated emails (delete/return)
-    sLog.outString("Returning old mails...");
-    sObjectMgr.ReturnOrDeleteOldMails(false);
+    loader.AddBarrier("ReturnOldMails", []()
+    {
+        sLog.outString("Returning old mails...");
+        sObjectMgr.ReturnOrDeleteOldMails(false);
+    });
 
-    sLog.outString("Loading Autobroadcasts...");
-    LoadAutobroadcasts();
+    loader.AddTask("Autobroadcasts", [this]()
+    {
+        sLog.outString("Loading Autobroadcasts...");
+        LoadAutobroadcasts();
+    });
 
     ///- Load and initialize scripts
-    sLog.outString("Loading Scripts...");
-    sScriptMgr.LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadWaypointScripts();
+    loader.AddTask("Scripts", []()
+    {
+        sLog.outString("Loading Scripts...");
+        sScriptMgr.LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadWaypointScripts();
+    }, { "Creatures", "Gameobjects", "Quests", "Waypoints" });
+
+    // condition checks of receive emote events use game events
+    loader.AddTask("CreatureEventAI", []()
+    {
+        sLog.outString("Loading CreatureEventAI Texts...");
+        sCreatureEAIMgr.LoadCreatureEventAI_Texts(false);       // false, will checked in LoadCreatureEventAI_Scripts
 
-    sLog.outString("Loading CreatureEventAI Texts...");
-    sCreatureEAIMgr.LoadCreatureEventAI_Texts(false);       // false, will checked in LoadCreatureEventAI_Scripts
+        sLog.outString("Loading CreatureEventAI Summons...");
+        sCreatureEAIMgr.LoadCreatureEventAI_Summons(false);     // false, will checked in LoadCreatureEventAI_Scripts
 
-    sLog.outString("Loading CreatureEventAI Summons...");
-    sCreatureEAIMgr.LoadCreatureEventAI_Summons(false);     // false, will checked in LoadCreatureEventAI_Scripts
+        sLog.outString("Loading CreatureEventAI Scripts...");
+        sCreatureEAIMgr.LoadCreatureEventAI_Scripts();
+    }, { "Creatures", "GameEvents" });
 
-    sLog.outString("Loading CreatureEventAI Scripts...");
-    sCreatureEAIMgr.LoadCreatureEventAI_Scripts();
+    loader.Run(getConfig(CONFIG_STARTUP_LOAD_THREADS));
+    loader.PrintTimes();
 
     sLog.outString("Initializing Scripts...");
     sScriptMgr.LoadScriptLibrary();
@@ -1452,6 +1721,10 @@ void World::SetInitialWorldSettings()
     sLog.outString("Starting Map System");
     sMapMgr.Initialize();
 
+    // cluster processes already took over line of sight if enabled
+    if (!VMAP::VMapFactory::createOrGetVMapManager()->isClusterComputingEnabled())
+        sLoSPool.Start(getConfig(CONFIG_VMAP_LOS_THREADS));
+
     ///- Initialize Battlegrounds
     sLog.outString("Starting BattleGround System");
     sBattleGroundMgr.CreateInitialBattleGrounds();
@@ -1770,6 +2043,9 @@ void World::Update(uint32 diff)
     //diffRecorder.RecordTimeFor("Map manager"); done inside mapmgr
     diffRecorder.reset();
 
+    // map threads are idle now, no lookup can hold an old registry table
+    sObjectAccessor.ReclaimRegistries();
+
     sBattleGroundMgr.Update(diff);
     diffRecorder.RecordTimeFor("BattleGround manager", 50);
 
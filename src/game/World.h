@@ -103,6 +103,8 @@ enum WorldConfigs
     CONFIG_ADDON_CHANNEL,
     CONFIG_SAVE_RESPAWN_TIME_IMMEDIATELY,
     CONFIG_GRID_UNLOAD,
+    CONFIG_GRID_PRELOAD_TIME,
+    CONFIG_GRID_PRELOAD_CELLS,
     CONFIG_WORLD_SLEEP,
 
     CONFIG_SOCKET_SELECTTIME,
@@ -118,12 +120,19 @@ enum WorldConfigs
     CONFIG_MAPUPDATE_INSTANCES,
     CONFIG_MAPUPDATE_BATTLEGROUNDS,
     CONFIG_MAPUPDATE_ARENAS,
+    CONFIG_MAPUPDATE_COST_SAMPLES,
+    CONFIG_MAPUPDATE_REGION_THREADS,
+    CONFIG_MAPUPDATE_PACKET_THREADS,
+    CONFIG_MAPUPDATE_PACKET_MIN_PLAYERS,
+
+    CONFIG_STARTUP_LOAD_THREADS,
 
     CONFIG_SESSION_UPDATE_MAX_TIME,
     CONFIG_SESSION_UPDATE_OVERTIME_METHOD,
     CONFIG_SESSION_UPDATE_VERBOSE_LOG,
     CONFIG_SESSION_UPDATE_IDLE_KICK,
     CONFIG_SESSION_UPDATE_MIN_LOG_DIFF,
+    CONFIG_SESSION_RECV_QUEUE_SIZE,
     CONFIG_INTERVAL_LOG_UPDATE,
     CONFIG_MIN_LOG_UPDATE,
     CONFIG_MIN_LOG_CELL,
@@ -356,10 +365,18 @@ enum WorldConfigs
     CONFIG_PET_LOS,
     CONFIG_VMAP_TOTEM,
     CONFIG_VMAP_GROUND,
+    CONFIG_VMAP_LOS_THREADS,
+    CONFIG_GRIDMAP_MMAP,
     CONFIG_MMAP_ENABLED,
+    CONFIG_MMAP_PATH_CACHE_SIZE,
+    CONFIG_MMAP_REPATH_PER_UPDATE,
+    CONFIG_MMAP_PATH_THREADS,
+    CONFIG_MMAP_QUERY_POOL_SIZE,
+    CONFIG_MMAP_MEMORY_MAPPED,
 
     // visibility and radiuses
     CONFIG_GROUP_VISIBILITY,
+    CONFIG_VISIBILITY_INCREMENTAL,
     
     // movement
     CONFIG_TARGET_POS_RECHECK_TIMER,
@@ -30,6 +30,7 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "PlayerBotMgr.h"
@@ -98,7 +99,7 @@ m_trollmuteTime(trollmute_time), m_trollmuteReason(trollmute_reason), _player(NU
 m_permissions(permissions), _accountId(id), m_expansion(expansion), m_opcodesDisabled(opcDisabled),
 m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
 _logoutTime(0), m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerSave(false), m_playerRecentlyLogout(false), m_latency(0), m_clientTimeDelay(0),
-m_accFlags(accFlags), m_Warden(NULL), m_bot(nullptr)
+m_accFlags(accFlags), m_Warden(NULL), m_bot(nullptr), _recvQueue(SESSION_RECV_RING_SIZE, sWorld.getConfig(CONFIG_SESSION_RECV_QUEUE_SIZE))
 {
     _mailSendTimer.Reset(5*IN_MILISECONDS);
 
@@ -289,6 +290,21 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         m_Socket->CloseSocket();
 }
 
+/// Send a packet that goes to many sessions, sockets share its payload
+void WorldSession::SendPacket(SharedPacket const& packet)
+{
+    #ifndef HELLGROUND_DEBUG
+    if (m_Socket)
+    {
+        if (m_Socket->SendPacket(packet) == -1)
+            m_Socket->CloseSocket();
+        return;
+    }
+    #endif
+
+    SendPacket(packet.GetPacket());
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -304,7 +320,17 @@ void WorldSession::QueuePacket(WorldPacket* new_packet)
         i->second.SetCurrent(0);
     }
 
-    _recvQueue.add(new_packet);
+    if (!_recvQueue.add(new_packet))
+    {
+        // client floods us faster than session updates drain the queue
+        sLog.outLog(LOG_DEFAULT, "ERROR: Receive queue full (%u packets) for account %u, dropping %s (%u) and closing socket",
+            uint32(_recvQueue.limit()), GetAccountId(), LookupOpcodeName(new_packet->GetOpcode()), new_packet->GetOpcode());
+
+        delete new_packet;
+
+        if (m_Socket)
+            m_Socket->CloseSocket();
+    }
 }
 
 /// Logging helper for unexpected opcodes
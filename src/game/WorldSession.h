@@ -32,6 +32,7 @@
 #include "AuctionHouseMgr.h"
 #include "WardenBase.h"
 #include "Item.h"
+#include "MPSCQueue.h"
 
 struct ItemPrototype;
 struct AuctionEntry;
@@ -47,6 +48,7 @@ class Player;
 class Unit;
 class WorldPacket;
 class WorldSocket;
+class SharedPacket;
 class QueryResult;
 class LoginQueryHolder;
 class CharacterHandler;
@@ -58,6 +60,9 @@ struct OpcodeHandler;
 
 #define CHECK_PACKET_SIZE(P,S) if ((P).size() < (S)) return SizeError((P),(S));
 
+// ring slots allocated by every session, packets queued above it spill up to SessionUpdate.RecvQueueSize
+#define SESSION_RECV_RING_SIZE 128
+
 enum OpcodeDisabled
 {
     OPC_DISABLE_WEATHER  = 0x01
@@ -166,6 +171,7 @@ class HELLGROUND_IMPORT_EXPORT WorldSession
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(SharedPacket const& packet);
         void SendNotification(const char *format,...) ATTR_PRINTF(2,3);
         void SendNotification(int32 string_id,...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -279,10 +285,8 @@ class HELLGROUND_IMPORT_EXPORT WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction);
         static void SendAuctionOutbiddedMail(AuctionEntry *auction);
         void SendAuctionCancelledToBidderMail(AuctionEntry *auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
-            uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull);
-        void BuildListAuctionItems(AuctionHouseObject::AuctionEntryMap const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
-            uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull);
+        void FilterAuctionItems(std::vector<AuctionEntry*>& auctions, std::wstring const& searchedname, uint32 levelmin,
+            uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, bool isFull);
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid);
 
@@ -804,7 +808,7 @@ class HELLGROUND_IMPORT_EXPORT WorldSession
         typedef UNORDERED_MAP<uint16,Timer> OpcodesCooldown;
         OpcodesCooldown _opcodesCooldown;
 
-        ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        ACE_Based::MPSCQueue<WorldPacket*> _recvQueue;
 
         uint32 m_currentSessionTime;
         uint32 m_currentVerboseTime;
@@ -21,6 +21,7 @@
 #include <ace/Message_Block.h>
 #include <ace/OS_NS_string.h>
 #include <ace/OS_NS_unistd.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -30,6 +31,7 @@
 #include <ace/Auto_Ptr.h>
 
 #include "WorldSocket.h"
+#include "SharedPacket.h"
 #include "Common.h"
 
 #include "Util.h"
@@ -71,6 +73,23 @@ struct ClientPktHeader
 #pragma pack(pop)
 #endif
 
+/// Payloads up to this size are copied into the output buffer, or into the
+/// tail block of the queue when packets are queued, memcpy of few bytes is
+/// cheaper than an allocation or a reference per packet
+#define SHARED_PACKET_INLINE_SIZE   128
+
+/// Size of queue blocks collecting small packets
+#define OUTPUT_COALESCE_SIZE        4096
+
+/// Buffer plus queued packets written by one writev
+#define OUTPUT_IOV_MAX              64
+
+std::atomic<uint64> WorldSocket::m_statBuffered(0);
+std::atomic<uint64> WorldSocket::m_statCoalesced(0);
+std::atomic<uint64> WorldSocket::m_statQueued(0);
+std::atomic<uint64> WorldSocket::m_statShared(0);
+std::atomic<uint64> WorldSocket::m_statSharedBytes(0);
+
 WorldSocket::WorldSocket(void) :
 WorldHandler(),
 m_LastPingTime(ACE_Time_Value::zero),
@@ -99,9 +118,8 @@ WorldSocket::~WorldSocket(void)
 
     peer().close();
 
-    WorldPacket* pct;
-    while (m_PacketQueue.dequeue_head(pct) == 0)
-        delete pct;
+    for (PacketQueueT::iterator itr = m_PacketQueue.begin(); itr != m_PacketQueue.end(); ++itr)
+        itr->Release();
 }
 
 bool WorldSocket::IsClosed(void) const
@@ -140,25 +158,76 @@ int WorldSocket::SendPacket(const WorldPacket& pct)
     if (closing_)
         return -1;
 
-    if (iSendPacket(pct) == -1)
+    // once something is queued the buffer must wait, it is written first
+    if (m_PacketQueue.empty() && iSendPacket(pct) == 0)
+    {
+        ++m_statBuffered;
+        return 0;
+    }
+
+    if (pct.size() <= SHARED_PACKET_INLINE_SIZE)
     {
-        WorldPacket* npct;
+        iQueueSmallPacket(pct);
+        ++m_statCoalesced;
+        return 0;
+    }
+
+    // NOTE maybe check of the size of the queue can be good ?
+    // to make it bounded instead of unbounded
+    iQueuePacket(SharedPacketData::Create(pct));
+    ++m_statQueued;
+
+    return 0;
+}
+
+int WorldSocket::SendPacket(const SharedPacket& pct)
+{
+    ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
 
-        ACE_NEW_RETURN(npct, WorldPacket(pct), -1);
+    if (closing_)
+        return -1;
 
-        // NOTE maybe check of the size of the queue can be good ?
-        // to make it bounded instead of unbounded
-        if (m_PacketQueue.enqueue_tail(npct) == -1)
+    WorldPacket const& packet = *pct.GetPacket();
+    if (packet.size() <= SHARED_PACKET_INLINE_SIZE)
+    {
+        if (m_PacketQueue.empty() && iSendPacket(packet) == 0)
+            ++m_statBuffered;
+        else
         {
-            delete npct;
-            sLog.outLog(LOG_DEFAULT, "ERROR: WorldSocket::SendPacket: m_PacketQueue.enqueue_tail failed");
-            return -1;
+            iQueueSmallPacket(packet);
+            ++m_statCoalesced;
         }
+
+        return 0;
     }
 
+    iQueuePacket(pct.GetData());
+    ++m_statShared;
+    m_statSharedBytes += packet.size();
+
     return 0;
 }
 
+NetSendStats WorldSocket::GetSendStats()
+{
+    NetSendStats stats;
+    stats.buffered = m_statBuffered.load(std::memory_order_relaxed);
+    stats.coalesced = m_statCoalesced.load(std::memory_order_relaxed);
+    stats.queued = m_statQueued.load(std::memory_order_relaxed);
+    stats.shared = m_statShared.load(std::memory_order_relaxed);
+    stats.sharedBytes = m_statSharedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void WorldSocket::ResetSendStats()
+{
+    m_statBuffered = 0;
+    m_statCoalesced = 0;
+    m_statQueued = 0;
+    m_statShared = 0;
+    m_statSharedBytes = 0;
+}
+
 long WorldSocket::AddReference(void)
 {
     return static_cast<long>(add_reference());
@@ -273,15 +342,55 @@ int WorldSocket::handle_output(ACE_HANDLE)
     if (closing_)
         return -1;
 
-    const size_t send_len = m_OutBuffer->length();
+    // buffer first, then queued packets in order, each as header + payload
+    iovec iov[OUTPUT_IOV_MAX];
+    int iovcnt = 0;
+    size_t send_len = 0;
+
+    if (m_OutBuffer->length())
+    {
+        iov[iovcnt].iov_base = m_OutBuffer->rd_ptr();
+        iov[iovcnt].iov_len = m_OutBuffer->length();
+        send_len += iov[iovcnt++].iov_len;
+    }
+
+    for (PacketQueueT::iterator itr = m_PacketQueue.begin(); itr != m_PacketQueue.end() && iovcnt + 2 <= OUTPUT_IOV_MAX; ++itr)
+    {
+        if (itr->block)
+        {
+            iov[iovcnt].iov_base = itr->block->rd_ptr() + itr->sent;
+            iov[iovcnt].iov_len = itr->block->length() - itr->sent;
+            send_len += iov[iovcnt++].iov_len;
+            continue;
+        }
+
+        if (itr->sent < sizeof(itr->header))
+        {
+            iov[iovcnt].iov_base = (char*)itr->header + itr->sent;
+            iov[iovcnt].iov_len = sizeof(itr->header) - itr->sent;
+            send_len += iov[iovcnt++].iov_len;
+        }
+
+        uint32 offset = itr->sent > sizeof(itr->header) ? itr->sent - sizeof(itr->header) : 0;
+        if (itr->payload->size() > offset)
+        {
+            iov[iovcnt].iov_base = (char*)itr->payload->contents() + offset;
+            iov[iovcnt].iov_len = itr->payload->size() - offset;
+            send_len += iov[iovcnt++].iov_len;
+        }
+    }
 
     if (send_len == 0)
         return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = peer().sendv(iov, iovcnt);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -293,26 +402,45 @@ int WorldSocket::handle_output(ACE_HANDLE)
 
         return -1;
     }
-    else if (n <(ssize_t)send_len) //now n > 0
+
+    size_t left = static_cast<size_t>(n);
+
+    if (size_t buffered = m_OutBuffer->length())
     {
-        m_OutBuffer->rd_ptr(static_cast<size_t>(n));
+        if (left < buffered)
+        {
+            m_OutBuffer->rd_ptr(left);
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
 
-        return schedule_wakeup_output(Guard);
+            return schedule_wakeup_output(Guard);
+        }
+
+        m_OutBuffer->reset();
+        left -= buffered;
     }
-    else //now n == send_len
+
+    while (left && !m_PacketQueue.empty())
     {
-        m_OutBuffer->reset();
+        OutPacket& out = m_PacketQueue.front();
 
-        if (!iFlushPacketQueue())
-            return cancel_wakeup_output(Guard);
-        else
-            return schedule_wakeup_output(Guard);
+        size_t remain = out.size() - out.sent;
+        if (left < remain)
+        {
+            out.sent += uint32(left);
+            break;
+        }
+
+        left -= remain;
+        out.Release();
+        m_PacketQueue.pop_front();
     }
 
-    ACE_NOTREACHED(return 0);
+    if (m_PacketQueue.empty())
+        return cancel_wakeup_output(Guard);
+
+    return schedule_wakeup_output(Guard);
 }
 
 int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
@@ -343,7 +471,7 @@ int WorldSocket::Update(void)
     if (closing_)
         return -1;
 
-    if (m_OutActive || m_OutBuffer->length() == 0)
+    if (m_OutActive || (m_OutBuffer->length() == 0 && m_PacketQueue.empty()))
         return 0;
 
     return handle_output(get_handle());
@@ -992,7 +1120,12 @@ int WorldSocket::HandlePing(WorldPacket& recvPacket)
 
 int WorldSocket::iSendPacket(const WorldPacket& pct)
 {
-    if (m_OutBuffer->space() < pct.size() + sizeof(ServerPktHeader))
+    return iCopyPacket(pct, *m_OutBuffer);
+}
+
+int WorldSocket::iCopyPacket(const WorldPacket& pct, ACE_Message_Block& buffer)
+{
+    if (buffer.space() < pct.size() + sizeof(ServerPktHeader))
     {
         errno = ENOBUFS;
         return -1;
@@ -1008,42 +1141,67 @@ int WorldSocket::iSendPacket(const WorldPacket& pct)
 
     m_Crypt.EncryptSend((uint8*) & header, sizeof(header));
 
-    if (m_OutBuffer->copy((char*) & header, sizeof(header)) == -1)
+    if (buffer.copy((char*) & header, sizeof(header)) == -1)
         ACE_ASSERT(false);
 
     if (!pct.empty())
-        if (m_OutBuffer->copy((char*) pct.contents(), pct.size()) == -1)
+        if (buffer.copy((char*) pct.contents(), pct.size()) == -1)
             ACE_ASSERT(false);
 
     return 0;
 }
 
-bool WorldSocket::iFlushPacketQueue()
+size_t WorldSocket::OutPacket::size() const
 {
-    WorldPacket *pct;
-    bool haveone = false;
+    return block ? block->length() : sizeof(header) + payload->size();
+}
 
-    while (m_PacketQueue.dequeue_head(pct) == 0)
-    {
-        if (iSendPacket(*pct) == -1)
-        {
-            if (m_PacketQueue.enqueue_head(pct) == -1)
-            {
-                delete pct;
-                sLog.outLog(LOG_DEFAULT, "ERROR: WorldSocket::iFlushPacketQueue m_PacketQueue->enqueue_head");
-                return false;
-            }
+void WorldSocket::OutPacket::Release()
+{
+    if (block)
+        block->release();
+    else
+        payload->Release();
+}
 
-            break;
-        }
-        else
-        {
-            haveone = true;
-            delete pct;
-        }
-    }
+void WorldSocket::iQueueSmallPacket(const WorldPacket& pct)
+{
+    // appending to a block already partly written is fine, only its end moves
+    if (!m_PacketQueue.empty() && m_PacketQueue.back().block && iCopyPacket(pct, *m_PacketQueue.back().block) == 0)
+        return;
+
+    OutPacket out;
+    memset(out.header, 0, sizeof(out.header));
+    out.payload = NULL;
+    out.block = new ACE_Message_Block(OUTPUT_COALESCE_SIZE);
+    out.sent = 0;
+
+    if (iCopyPacket(pct, *out.block) == -1)
+        ACE_ASSERT(false);
+
+    m_PacketQueue.push_back(out);
+}
+
+void WorldSocket::iQueuePacket(SharedPacketData* payload)
+{
+    ServerPktHeader header;
+
+    header.cmd = payload->GetOpcode();
+    EndianConvert(header.cmd);
+
+    header.size =(uint16) payload->size() + 2;
+    EndianConvertReverse(header.size);
+
+    // encrypted now, crypt state must follow the order packets go out in
+    m_Crypt.EncryptSend((uint8*) & header, sizeof(header));
+
+    OutPacket out;
+    memcpy(out.header, &header, sizeof(header));
+    out.payload = payload;
+    out.block = NULL;
+    out.sent = 0;
 
-    return haveone;
+    m_PacketQueue.push_back(out);
 }
 
 bool WorldSocket::IsChatOpcode(uint16 opcode)
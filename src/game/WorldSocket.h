@@ -38,6 +38,9 @@
 #include <ace/Unbounded_Queue.h>
 #include <ace/Message_Block.h>
 
+#include <atomic>
+#include <deque>
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -48,6 +51,19 @@
 class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
+class SharedPacket;
+class SharedPacketData;
+
+struct NetSendStats
+{
+    NetSendStats() : buffered(0), coalesced(0), queued(0), shared(0), sharedBytes(0) {}
+
+    uint64 buffered;                                        // packets copied to socket output buffer
+    uint64 coalesced;                                       // small packets appended to a queued coalescing block
+    uint64 queued;                                          // packets copied to own payload and queued
+    uint64 shared;                                          // packets queued as reference to shared payload
+    uint64 sharedBytes;                                     // payload bytes not copied thanks to sharing
+};
 
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
@@ -62,7 +78,10 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  *
  * For output the class uses one buffer (64K usually) and
  * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
+ * the buffer. Queued packets keep a reference to their payload,
+ * broadcasts share one payload between all sockets and only
+ * the encrypted header is per socket. Buffer and queue are
+ * written with one writev. The reason this is done, is because the server
  * does really a lot of small-size writes to it, and it doesn't
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
@@ -103,8 +122,21 @@ class WorldSocket : protected WorldHandler
         typedef ACE_Thread_Mutex LockType;
         typedef ACE_Guard<LockType> GuardType;
 
+        /// Packet for which there was no space, header is already encrypted.
+        /// Small packets are collected in a block instead, headers included.
+        struct OutPacket
+        {
+            uint8 header[4];
+            SharedPacketData* payload;                      // NULL for block of small packets
+            ACE_Message_Block* block;
+            uint32 sent;                                    // bytes of header + payload (or block) already written
+
+            size_t size() const;
+            void Release();
+        };
+
         /// Queue for storing packets for which there is no space.
-        typedef ACE_Unbounded_Queue< WorldPacket* > PacketQueueT;
+        typedef std::deque<OutPacket> PacketQueueT;
 
         /// Check if socket is closed.
         bool IsClosed (void) const;
@@ -120,6 +152,13 @@ class WorldSocket : protected WorldHandler
         /// @return -1 of failure
         int SendPacket (const WorldPacket& pct);
 
+        /// Send packet whose payload is shared with other sockets.
+        /// Small payloads are still copied to the output buffer.
+        int SendPacket (const SharedPacket& pct);
+
+        static NetSendStats GetSendStats();
+        static void ResetSendStats();
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -175,11 +214,16 @@ class WorldSocket : protected WorldHandler
         /// Need to be called with m_OutBufferLock lock held
         int iSendPacket (const WorldPacket& pct);
 
-        /// Flush m_PacketQueue if there are packets in it
+        /// Encrypt header and copy WorldPacket to given buffer, return -1 if no space
+        int iCopyPacket (const WorldPacket& pct, ACE_Message_Block& buffer);
+
+        /// Append small packet to the last block of m_PacketQueue, or to a new one
         /// Need to be called with m_OutBufferLock lock held
-        /// @return true if it wrote to the buffer (AKA you need
-        /// to mark the socket for output).
-        bool iFlushPacketQueue ();
+        void iQueueSmallPacket (const WorldPacket& pct);
+
+        /// Append packet to m_PacketQueue, takes over the payload reference
+        /// Need to be called with m_OutBufferLock lock held
+        void iQueuePacket (SharedPacketData* payload);
 
         // Use to check if custom chat only client can use such opcode
         static bool IsChatOpcode(uint16 opcode);
@@ -231,6 +275,12 @@ class WorldSocket : protected WorldHandler
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
+        static std::atomic<uint64> m_statBuffered;
+        static std::atomic<uint64> m_statCoalesced;
+        static std::atomic<uint64> m_statQueued;
+        static std::atomic<uint64> m_statShared;
+        static std::atomic<uint64> m_statSharedBytes;
+
         uint32 m_Seed;
 
         uint8 operatingSystem; // stores client's operating system
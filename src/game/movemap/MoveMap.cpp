@@ -24,8 +24,58 @@
 #include "MoveMap.h"
 #include "MoveMapSharedDefines.h"
 
+#include <ace/OS_NS_unistd.h>
+
+#include "../../dep/recastnavigation/Detour/Include/DetourCommon.h"
+#include "../../dep/recastnavigation/Detour/Include/DetourNode.h"
+
+// node pool size of every dtNavMeshQuery
+#define MMAP_QUERY_MAX_NODES 1024
+
 namespace MMAP
 {
+    // memory allocated by dtNavMeshQuery::init
+    static uint32 NavMeshQuerySize(int maxNodes)
+    {
+        uint32 size = sizeof(dtNavMeshQuery);
+        size += sizeof(dtNodePool) + maxNodes * (sizeof(dtNode) + sizeof(unsigned short)) + dtNextPow2(maxNodes / 4) * sizeof(unsigned short);
+        size += sizeof(dtNodePool) + 64 * (sizeof(dtNode) + sizeof(unsigned short)) + 32 * sizeof(unsigned short);
+        size += sizeof(dtNodeQueue) + (maxNodes + 1) * sizeof(dtNode*);
+        return size;
+    }
+
+    // reads every page of a tile once, following mapping of the tile finds it in page cache
+    class TilePrefetchRequest : public ACE_Method_Request
+    {
+        public:
+            TilePrefetchRequest(std::string const& fileName, size_t offset, size_t length)
+                : m_fileName(fileName), m_offset(offset), m_length(length) {}
+
+            virtual int call()
+            {
+                // mapping offset must be multiple of allocation granularity
+                size_t delta = m_offset % ACE_OS::allocation_granularity();
+                size_t length = m_length ? m_length + delta : static_cast<size_t>(-1);
+
+                ACE_Mem_Map mapping;
+                if (mapping.map(m_fileName.c_str(), length, O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED, 0, ACE_OFF_T(m_offset - delta)) == -1)
+                    return 0;
+
+                size_t page = ACE_OS::getpagesize();
+                char const* data = (char const*)mapping.addr();
+                volatile char sum = 0;
+                for (size_t i = delta; i < mapping.size(); i += page)
+                    sum += data[i];
+
+                return 0;
+            }
+
+        private:
+            std::string m_fileName;
+            size_t m_offset;
+            size_t m_length;                                // 0 for whole file
+    };
+
     // ######################## MMapFactory ########################
     // our global singelton copy
     MMapManager *g_MMapManager = NULL;
@@ -47,9 +97,87 @@ namespace MMAP
         }
     }
 
+    // ######################## PolyPathCache ########################
+    bool PolyPathCache::Get(PolyPathKey const& key, dtPolyRef* polys, uint32& length, uint32 maxLength)
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, false);
+
+        EntryIndex::iterator itr = m_index.find(key);
+        if (itr == m_index.end() || itr->second->second.size() > maxLength)
+        {
+            ++m_misses;
+            return false;
+        }
+
+        // move to front, it is the most recently used one now
+        m_entries.splice(m_entries.begin(), m_entries, itr->second);
+
+        std::vector<dtPolyRef> const& path = itr->second->second;
+        length = path.size();
+        memcpy(polys, &path[0], length * sizeof(dtPolyRef));
+        ++m_hits;
+        return true;
+    }
+
+    void PolyPathCache::Put(PolyPathKey const& key, dtPolyRef const* polys, uint32 length, uint32 generation, uint32 capacity)
+    {
+        if (!length || !capacity)
+            return;
+
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+        if (generation != m_generation)
+            return;
+
+        EntryIndex::iterator itr = m_index.find(key);
+        if (itr != m_index.end())
+        {
+            itr->second->second.assign(polys, polys + length);
+            m_entries.splice(m_entries.begin(), m_entries, itr->second);
+            return;
+        }
+
+        while (m_index.size() >= capacity)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.push_front(Entry(key, std::vector<dtPolyRef>(polys, polys + length)));
+        m_index.insert(EntryIndex::value_type(key, m_entries.begin()));
+    }
+
+    void PolyPathCache::Clear()
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+        m_entries.clear();
+        m_index.clear();
+        ++m_generation;
+    }
+
+    uint32 PolyPathCache::GetGeneration()
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, 0);
+        return m_generation;
+    }
+
+    void PolyPathCache::GetStats(uint32& size, uint64& hits, uint64& misses)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+        size = m_index.size();
+        hits = m_hits;
+        misses = m_misses;
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
+        // no prefetch may touch files after this point
+        prefetcher.deactivate();
+        pathSearcher.deactivate();
+
         for (MMapDataSet::iterator i = loadedMMaps.begin(); i != loadedMMaps.end(); ++i)
             delete i->second;
 
@@ -98,10 +226,195 @@ namespace MMAP
         MMapData* mmap_data = new MMapData(mesh);
         mmap_data->mmapLoadedTiles.clear();
 
+        if (sWorld.getConfig(CONFIG_MMAP_MEMORY_MAPPED))
+            loadMapArchive(mapId, mmap_data);
+
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
         return true;
     }
 
+    void MMapManager::loadMapArchive(uint32 mapId, MMapData* mmap)
+    {
+        uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i.mmtiles")+1;
+        char *fileName = new char[pathLen];
+        snprintf(fileName, pathLen, (sWorld.GetDataPath()+"mmaps/%03i.mmtiles").c_str(), mapId);
+
+        // archive is optional, tiles are loaded from own files without it
+        ACE_Mem_Map* archive = new ACE_Mem_Map();
+        if (archive->map(fileName, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ | PROT_WRITE, ACE_MAP_PRIVATE) == -1)
+        {
+            delete archive;
+            delete [] fileName;
+            return;
+        }
+
+        // mapping stays valid without the file, do not keep its descriptor
+        archive->close_handle();
+
+        char const* base = (char const*)archive->addr();
+        size_t size = archive->size();
+
+        MmapArchiveHeader header;
+        memset(&header, 0, sizeof(MmapArchiveHeader));
+        if (size >= sizeof(MmapArchiveHeader))
+            memcpy(&header, base, sizeof(MmapArchiveHeader));
+
+        if (header.archiveMagic != MMAP_ARCHIVE_MAGIC || header.archiveVersion != MMAP_ARCHIVE_VERSION ||
+            (size - sizeof(MmapArchiveHeader)) / sizeof(MmapArchiveEntry) < header.tileCount)
+        {
+            sLog.outLog(LOG_DEFAULT, "ERROR: MMAP:loadMapArchive: Bad header in mmap archive %s", fileName);
+            delete archive;
+            delete [] fileName;
+            return;
+        }
+
+        MmapArchiveEntry const* entries = (MmapArchiveEntry const*)(base + sizeof(MmapArchiveHeader));
+        for (uint32 i = 0; i < header.tileCount; ++i)
+        {
+            MmapArchiveEntry entry;
+            memcpy(&entry, &entries[i], sizeof(MmapArchiveEntry));
+            if (entry.offset > size || entry.size > size - entry.offset)
+            {
+                sLog.outLog(LOG_DEFAULT, "ERROR: MMAP:loadMapArchive: Tile %u out of bounds in mmap archive %s", entry.tileId, fileName);
+                continue;
+            }
+
+            mmap->archiveIndex[entry.tileId] = entry;
+        }
+
+        mmap->archive = archive;
+        mmap->archiveName = fileName;
+        delete [] fileName;
+
+        sLog.outDetail("MMAP:loadMapArchive: Mapped %03i.mmtiles with %u tiles", mapId, uint32(mmap->archiveIndex.size()));
+    }
+
+    bool MMapManager::loadMappedTile(uint32 mapId, int32 x, int32 y, MMapData* mmap)
+    {
+        uint32 packedGridPos = packTileID(x, y);
+
+        unsigned char* tileData = NULL;
+        size_t tileSize = 0;
+        ACE_Mem_Map* mapping = NULL;
+
+        MMapArchiveIndex::const_iterator entry = mmap->archiveIndex.find(packedGridPos);
+        if (entry != mmap->archiveIndex.end())
+        {
+            tileData = (unsigned char*)mmap->archive->addr() + entry->second.offset;
+            tileSize = entry->second.size;
+        }
+        else
+        {
+            uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile")+1;
+            char *fileName = new char[pathLen];
+            snprintf(fileName, pathLen, (sWorld.GetDataPath()+"mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
+
+            // detour writes links into tile data, private mapping copies only pages it writes to
+            mapping = new ACE_Mem_Map();
+            if (mapping->map(fileName, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ | PROT_WRITE, ACE_MAP_PRIVATE) == -1)
+            {
+                delete mapping;
+                delete [] fileName;
+                return false;
+            }
+            delete [] fileName;
+            mapping->close_handle();
+
+            tileData = (unsigned char*)mapping->addr();
+            tileSize = mapping->size();
+        }
+
+        // anything unexpected is left for the regular loader to report
+        MmapTileHeader fileHeader;
+        if (tileSize < sizeof(MmapTileHeader))
+        {
+            delete mapping;
+            return false;
+        }
+
+        memcpy(&fileHeader, tileData, sizeof(MmapTileHeader));
+        unsigned char* data = tileData + sizeof(MmapTileHeader);
+
+        if (fileHeader.mmapMagic != MMAP_MAGIC || fileHeader.mmapVersion != MMAP_VERSION ||
+            size_t(fileHeader.size) > tileSize - sizeof(MmapTileHeader) || size_t(data) % 4)
+        {
+            delete mapping;
+            return false;
+        }
+
+        dtMeshHeader* header = (dtMeshHeader*)data;
+        dtTileRef tileRef = 0;
+
+        // data stays owned by mapping, detour must not free it
+        dtStatus status;
+        {
+            ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, mmap->tileLock, false);
+            status = mmap->navMesh->addTile(data, fileHeader.size, 0, 0, &tileRef);
+        }
+
+        if (DT_SUCCESS != status)
+        {
+            delete mapping;
+            return false;
+        }
+
+        mmap->pathCache.Clear();
+        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        mmap->mappedTiles.insert(MMapTileMappings::value_type(packedGridPos, mapping));
+        ++loadedTiles;
+        sLog.outDetail("MMAP:loadMap: Mapped mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+        return true;
+    }
+
+    void MMapManager::prefetchTile(uint32 mapId, int32 x, int32 y)
+    {
+        if (!sWorld.getConfig(CONFIG_MMAP_MEMORY_MAPPED))
+            return;
+
+        // navmesh is loaded with first tile, map without it has nothing to prefetch
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return;
+
+        MMapData* mmap = itr->second;
+        uint32 packedGridPos = packTileID(x, y);
+
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, prefetchLock);
+
+            // tiles prefetched but never entered are forgotten in bulk
+            if (prefetchedTiles.size() >= 4096)
+                prefetchedTiles.clear();
+
+            if (!prefetchedTiles.insert(uint64(mapId) << 32 | packedGridPos).second)
+                return;
+
+            if (!prefetcher.activated() && prefetcher.activate(1) == -1)
+                return;
+        }
+
+        TilePrefetchRequest* request = NULL;
+        MMapArchiveIndex::const_iterator entry = mmap->archiveIndex.find(packedGridPos);
+        if (entry != mmap->archiveIndex.end())
+            request = new TilePrefetchRequest(mmap->archiveName, entry->second.offset, entry->second.size);
+        else
+        {
+            uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile")+1;
+            char *fileName = new char[pathLen];
+            snprintf(fileName, pathLen, (sWorld.GetDataPath()+"mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
+            request = new TilePrefetchRequest(fileName, 0, 0);
+            delete [] fileName;
+        }
+
+        if (prefetcher.execute(request) == -1)
+        {
+            delete request;
+            return;
+        }
+
+        ++prefetchCount;
+    }
+
     uint32 MMapManager::packTileID(int32 x, int32 y)
     {
         return uint32(x << 16 | y);
@@ -125,6 +438,17 @@ namespace MMAP
             return false;
         }
 
+        if (sWorld.getConfig(CONFIG_MMAP_MEMORY_MAPPED))
+        {
+            {
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, prefetchLock, false);
+                prefetchedTiles.erase(uint64(mapId) << 32 | packedGridPos);
+            }
+
+            if (loadMappedTile(mapId, x, y, mmap))
+                return true;
+        }
+
         // load this tile :: mmaps/MMMXXYY.mmtile
         uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile")+1;
         char *fileName = new char[pathLen];
@@ -173,8 +497,15 @@ namespace MMAP
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if(DT_SUCCESS == mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef))
+        dtStatus status;
         {
+            ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, mmap->tileLock, false);
+            status = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        }
+
+        if(DT_SUCCESS == status)
+        {
+            mmap->pathCache.Clear();
             mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
             sLog.outDetail("MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
@@ -214,7 +545,13 @@ namespace MMAP
         dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
 
         // unload, and mark as non loaded
-        if(DT_SUCCESS != mmap->navMesh->removeTile(tileRef, NULL, NULL))
+        dtStatus status;
+        {
+            ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, mmap->tileLock, false);
+            status = mmap->navMesh->removeTile(tileRef, NULL, NULL);
+        }
+
+        if(DT_SUCCESS != status)
         {
             // this is technically a memory leak
             // if the grid is later reloaded, dtNavMesh::addTile will return error but no extra memory is used
@@ -224,8 +561,18 @@ namespace MMAP
         }
         else
         {
+            mmap->pathCache.Clear();
             mmap->mmapLoadedTiles.erase(packedGridPos);
             --loadedTiles;
+
+            // tile no longer references mapped data
+            MMapTileMappings::iterator mapping = mmap->mappedTiles.find(packedGridPos);
+            if (mapping != mmap->mappedTiles.end())
+            {
+                delete mapping->second;
+                mmap->mappedTiles.erase(mapping);
+            }
+
             sLog.outDetail("MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
         }
@@ -264,62 +611,170 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-            sLog.outDebug("MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
-        }
+            return NULL;
 
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        return loadedMMaps[mapId]->navMesh;
+    }
+
+    PolyPathCache* MMapManager::GetPolyPathCache(uint32 mapId)
+    {
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return NULL;
+
+        return &itr->second->pathCache;
+    }
+
+    ACE_RW_Thread_Mutex* MMapManager::GetTileLock(uint32 mapId)
+    {
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return NULL;
+
+        return &itr->second->tileLock;
+    }
+
+    bool MMapManager::queuePathSearch(ACE_Method_Request* request)
+    {
         {
-            sLog.outDebug("MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, pathSearchLock, false);
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
+            uint32 threads = sWorld.getConfig(CONFIG_MMAP_PATH_THREADS);
+            if (!pathSearcher.activated() && (!threads || pathSearcher.activate(threads) == -1))
+            {
+                delete request;
+                return false;
+            }
+        }
 
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        sLog.outDetail("MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
+        if (pathSearcher.execute(request) == -1)
+            return false;
 
+        ++pathSearchCount;
         return true;
     }
 
-    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
+    dtNavMeshQuery* MMapManager::AcquireNavMeshQuery(uint32 mapId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
             return NULL;
 
-        return loadedMMaps[mapId]->navMesh;
+        MMapData* mmap = itr->second;
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mmap->queryLock, NULL);
+
+            ++mmap->queriesInUse;
+            if (!mmap->freeQueries.empty())
+            {
+                dtNavMeshQuery* query = mmap->freeQueries.back();
+                mmap->freeQueries.pop_back();
+                return query;
+            }
+        }
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if(DT_SUCCESS != query->init(mmap->navMesh, MMAP_QUERY_MAX_NODES))
+        {
+            dtFreeNavMeshQuery(query);
+            sLog.outLog(LOG_DEFAULT, "ERROR: MMAP:AcquireNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mmap->queryLock, NULL);
+            --mmap->queriesInUse;
+            return NULL;
+        }
+
+        sLog.outDetail("MMAP:AcquireNavMeshQuery: created dtNavMeshQuery for mapId %03u", mapId);
+        return query;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    void MMapManager::ReleaseNavMeshQuery(uint32 mapId, dtNavMesh const* navMesh, dtNavMeshQuery* query)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-            return NULL;
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        // map unloaded while query was borrowed, query belongs to old navmesh
+        if (itr == loadedMMaps.end() || itr->second->navMesh != navMesh)
+        {
+            dtFreeNavMeshQuery(query);
+            return;
+        }
 
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        MMapData* mmap = itr->second;
         {
-             // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            ASSERT(query);
-            if(DT_SUCCESS != query->init(mmap->navMesh, 1024))
+            ACE_GUARD(ACE_Thread_Mutex, guard, mmap->queryLock);
+
+            --mmap->queriesInUse;
+            if (mmap->freeQueries.size() < sWorld.getConfig(CONFIG_MMAP_QUERY_POOL_SIZE))
             {
-                dtFreeNavMeshQuery(query);
-                sLog.outLog(LOG_DEFAULT, "ERROR: MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                return NULL;
+                mmap->freeQueries.push_back(query);
+                return;
             }
+        }
+
+        dtFreeNavMeshQuery(query);
+    }
 
-            sLog.outDetail("MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+    void MMapManager::GetMemoryStats(std::vector<MMapMemoryStats>& stats)
+    {
+        for (MMapDataSet::iterator itr = loadedMMaps.begin(); itr != loadedMMaps.end(); ++itr)
+        {
+            MMapData* mmap = itr->second;
+
+            MMapMemoryStats mapStats;
+            mapStats.mapId = itr->first;
+            mapStats.tiles = 0;
+            mapStats.tileBytes = 0;
+
+            const dtNavMesh* navmesh = mmap->navMesh;
+            for (int32 i = 0; i < navmesh->getMaxTiles(); ++i)
+            {
+                const dtMeshTile* tile = navmesh->getTile(i);
+                if (!tile || !tile->header)
+                    continue;
+
+                ++mapStats.tiles;
+                mapStats.tileBytes += tile->dataSize;
+            }
+
+            {
+                ACE_GUARD(ACE_Thread_Mutex, guard, mmap->queryLock);
+                mapStats.queriesInUse = mmap->queriesInUse;
+                mapStats.queries = mmap->queriesInUse + mmap->freeQueries.size();
+            }
+            mapStats.queryBytes = mapStats.queries * NavMeshQuerySize(MMAP_QUERY_MAX_NODES);
+            mapStats.mappedTiles = mmap->mappedTiles.size();
+            mapStats.archive = mmap->archive != NULL;
+
+            stats.push_back(mapStats);
         }
+    }
+
+    // ######################## NavMeshQueryHolder ########################
+    NavMeshQueryHolder::NavMeshQueryHolder(uint32 mapId) : m_mapId(mapId), m_navMesh(NULL), m_query(NULL), m_tileLock(NULL)
+    {
+        MMapManager* mmap = MMapFactory::createOrGetMMapManager();
+        m_navMesh = mmap->GetNavMesh(mapId);
+        if (!m_navMesh)
+            return;
+
+        m_query = mmap->AcquireNavMeshQuery(mapId);
+        if (m_query)
+        {
+            m_tileLock = mmap->GetTileLock(mapId);
+            m_tileLock->acquire_read();
+        }
+    }
+
+    NavMeshQueryHolder::~NavMeshQueryHolder()
+    {
+        if (m_tileLock)
+            m_tileLock->release();
 
-        return mmap->navMeshQueries[instanceId];
+        if (m_query)
+            MMapFactory::createOrGetMMapManager()->ReleaseNavMeshQuery(m_mapId, m_navMesh, m_query);
     }
 }
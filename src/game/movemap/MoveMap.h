@@ -22,6 +22,20 @@
 
 #include "Utilities/UnorderedMap.h"
 
+#include "ace/Thread_Mutex.h"
+#include "ace/RW_Thread_Mutex.h"
+#include "ace/Mem_Map.h"
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "DelayExecutor.h"
+#include "MoveMapSharedDefines.h"
+
 #include "../../dep/recastnavigation/Detour/Include/DetourAlloc.h"
 #include "../../dep/recastnavigation/Detour/Include/DetourNavMesh.h"
 #include "../../dep/recastnavigation/Detour/Include/DetourNavMeshQuery.h"
@@ -41,28 +55,110 @@ inline void dtCustomFree(void* ptr)
 namespace MMAP
 {
     typedef UNORDERED_MAP<uint32, dtTileRef> MMapTileSet;
-    typedef UNORDERED_MAP<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef UNORDERED_MAP<uint32, ACE_Mem_Map*> MMapTileMappings;
+    typedef UNORDERED_MAP<uint32, MmapArchiveEntry> MMapArchiveIndex;
+    typedef std::vector<dtNavMeshQuery*> NavMeshQueryPool;
+
+    struct PolyPathKey
+    {
+        PolyPathKey(dtPolyRef start, dtPolyRef end, uint16 include, uint16 exclude)
+            : startPoly(start), endPoly(end), flags(uint32(include) << 16 | exclude) {}
+
+        bool operator<(PolyPathKey const& other) const
+        {
+            if (startPoly != other.startPoly)
+                return startPoly < other.startPoly;
+            if (endPoly != other.endPoly)
+                return endPoly < other.endPoly;
+            return flags < other.flags;
+        }
+
+        dtPolyRef startPoly;
+        dtPolyRef endPoly;
+        uint32 flags;                                       // query filter include << 16 | exclude
+    };
+
+    // least recently used poly paths between two polygons, shared by all instances of a map.
+    // units chasing same target from same area end up asking for the same corridor
+    class PolyPathCache
+    {
+        public:
+            PolyPathCache() : m_generation(0), m_hits(0), m_misses(0) {}
+
+            // copies cached path into polys, false when not cached or longer than maxLength
+            bool Get(PolyPathKey const& key, dtPolyRef* polys, uint32& length, uint32 maxLength);
+            // generation must be read before path was searched, path is dropped if tiles changed meanwhile
+            void Put(PolyPathKey const& key, dtPolyRef const* polys, uint32 length, uint32 generation, uint32 capacity);
+            // called when tiles are loaded or unloaded, cached poly refs are no longer valid
+            void Clear();
+
+            uint32 GetGeneration();
+            void GetStats(uint32& size, uint64& hits, uint64& misses);
+
+        private:
+            typedef std::pair<PolyPathKey, std::vector<dtPolyRef> > Entry;
+            typedef std::list<Entry> EntryList;
+            typedef std::map<PolyPathKey, EntryList::iterator> EntryIndex;
+
+            ACE_Thread_Mutex m_lock;
+            EntryList m_entries;                            // most recently used first
+            EntryIndex m_index;
+            uint32 m_generation;
+            uint64 m_hits;
+            uint64 m_misses;
+    };
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), queriesInUse(0), archive(NULL) {}
         ~MMapData()
         {
-            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
+            for (NavMeshQueryPool::iterator i = freeQueries.begin(); i != freeQueries.end(); ++i)
+                dtFreeNavMeshQuery(*i);
 
             if (navMesh)
                 dtFreeNavMesh(navMesh);
+
+            // mapped tile data must outlive the navmesh
+            for (MMapTileMappings::iterator i = mappedTiles.begin(); i != mappedTiles.end(); ++i)
+                delete i->second;
+
+            delete archive;
         }
 
         dtNavMesh* navMesh;
+        // searches read tiles of the navmesh while other instances of the map or
+        // path workers add and remove them, write locked only around addTile/removeTile
+        ACE_RW_Thread_Mutex tileLock;
+
+        // dtNavMeshQuery is not thread safe, each path search borrows one for its duration,
+        // so all instances of the map together need only as many as threads searching at once
+        ACE_Thread_Mutex queryLock;
+        NavMeshQueryPool freeQueries;
+        uint32 queriesInUse;
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        PolyPathCache pathCache;
+
+        // tiles added to navmesh without copy, mapping of own .mmtile file or NULL for tiles in archive
+        MMapTileMappings mappedTiles;
+        ACE_Mem_Map* archive;               // mmaps/MMM.mmtiles, whole map in one file
+        std::string archiveName;
+        MMapArchiveIndex archiveIndex;
     };
 
+    struct MMapMemoryStats
+    {
+        uint32 mapId;
+        uint32 tiles;
+        uint32 tileBytes;                   // navmesh tile data
+        uint32 queries;                     // idle and borrowed queries
+        uint32 queriesInUse;
+        uint32 queryBytes;                  // node pools and open lists of all queries
+        uint32 mappedTiles;                 // tiles used in place from file mapping
+        bool archive;
+    };
 
     typedef UNORDERED_MAP<uint32, MMapData*> MMapDataSet;
 
@@ -71,26 +167,67 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), prefetchCount(0), pathSearchCount(0) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
+            // reads tile pages into page cache in background, so loadMap of mapped tile does not wait for disk
+            void prefetchTile(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
-            bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // query is owned by calling thread until released, use NavMeshQueryHolder
+            dtNavMeshQuery* AcquireNavMeshQuery(uint32 mapId);
+            // read lock held by NavMeshQueryHolder for the search
+            ACE_RW_Thread_Mutex* GetTileLock(uint32 mapId);
+            void ReleaseNavMeshQuery(uint32 mapId, dtNavMesh const* navMesh, dtNavMeshQuery* query);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            PolyPathCache* GetPolyPathCache(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+            uint32 getPrefetchCount() const { return prefetchCount; }
+            uint32 getPathSearchCount() const { return pathSearchCount; }
+
+            // runs request on path worker thread, request is deleted when it can't be queued
+            bool queuePathSearch(ACE_Method_Request* request);
+            void GetMemoryStats(std::vector<MMapMemoryStats>& stats);
         private:
             bool loadMapData(uint32 mapId);
+            void loadMapArchive(uint32 mapId, MMapData* mmap);
+            bool loadMappedTile(uint32 mapId, int32 x, int32 y, MMapData* mmap);
             uint32 packTileID(int32 x, int32 y);
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+
+            ACE_Thread_Mutex prefetchLock;
+            std::set<uint64> prefetchedTiles;   // mapId << 32 | tile id, until tile is loaded
+            DelayExecutor prefetcher;
+            std::atomic<uint32> prefetchCount;
+
+            ACE_Thread_Mutex pathSearchLock;
+            DelayExecutor pathSearcher;         // mmap.pathThreads workers, see PathSearch
+            std::atomic<uint32> pathSearchCount;
+    };
+
+    // borrows a query from map's pool for one path search, tiles are not added or removed meanwhile
+    class NavMeshQueryHolder
+    {
+        public:
+            explicit NavMeshQueryHolder(uint32 mapId);
+            ~NavMeshQueryHolder();
+
+            dtNavMeshQuery const* GetQuery() const { return m_query; }
+
+        private:
+            NavMeshQueryHolder(NavMeshQueryHolder const&);
+            NavMeshQueryHolder& operator=(NavMeshQueryHolder const&);
+
+            uint32 m_mapId;
+            dtNavMesh const* m_navMesh;
+            dtNavMeshQuery* m_query;
+            ACE_RW_Thread_Mutex* m_tileLock;
     };
 
     // static class
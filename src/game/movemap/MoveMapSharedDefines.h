@@ -38,6 +38,25 @@ struct MmapTileHeader
                        mmapVersion(MMAP_VERSION), size(0), usesLiquids(true) {}
 };
 
+#define MMAP_ARCHIVE_MAGIC 0x4d4d4152   // 'MMAR'
+#define MMAP_ARCHIVE_VERSION 1
+
+// mmaps/MMM.mmtiles holds all tiles of one map: MmapArchiveHeader, tileCount entries
+// and for every entry MmapTileHeader followed by tile data, starting at 4 byte aligned offset
+struct MmapArchiveHeader
+{
+    uint32 archiveMagic;
+    uint32 archiveVersion;
+    uint32 tileCount;
+};
+
+struct MmapArchiveEntry
+{
+    uint32 tileId;                      // x << 16 | y
+    uint32 offset;                      // of MmapTileHeader from start of archive
+    uint32 size;                        // MmapTileHeader and tile data
+};
+
 enum NavTerrain
 {
     NAV_EMPTY   = 0x00,
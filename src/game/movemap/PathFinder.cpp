@@ -22,6 +22,7 @@
 #include "Creature.h"
 #include "PathFinder.h"
 #include "Log.h"
+#include "World.h"
 
 #include "../recastnavigation/Detour/Include/DetourCommon.h"
 
@@ -29,16 +30,19 @@
 PathFinder::PathFinder(const Unit* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH),
-    m_sourceUnit(owner), m_navMesh(NULL), m_navMeshQuery(NULL)
+    m_sourceUnit(owner), m_mapId(owner->GetMapId()), m_sourceGuidLow(owner->GetGUIDLow()), m_terrain(owner->GetTerrain()),
+    m_canFly(false), m_canSwim(false), m_deferNormalize(false),
+    m_navMesh(NULL), m_navMeshQuery(NULL), m_pathCache(NULL)
 {
     //DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
-    if (m_sourceUnit->GetTerrain() && m_sourceUnit->GetTerrain()->IsPathFindingEnabled())
+    if (m_terrain && m_terrain->IsPathFindingEnabled())
     {
-        uint32 mapId = m_sourceUnit->GetMapId();
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        m_navMesh = mmap->GetNavMesh(mapId);
-        m_navMeshQuery = mmap->GetNavMeshQuery(mapId, m_sourceUnit->GetInstanceId());
+        m_navMesh = mmap->GetNavMesh(m_mapId);
+
+        if (sWorld.getConfig(CONFIG_MMAP_PATH_CACHE_SIZE))
+            m_pathCache = mmap->GetPolyPathCache(m_mapId);
     }
 
     createFilter();
@@ -51,6 +55,32 @@ PathFinder::~PathFinder()
 
 bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest)
 {
+    bool result;
+    if (!prepareSearch(destX, destY, destZ, forceDest, result))
+        return result;
+
+    search(false);
+    return true;
+}
+
+PathSearch* PathFinder::calculateAsync(float destX, float destY, float destZ, bool forceDest, bool& result)
+{
+    if (!prepareSearch(destX, destY, destZ, forceDest, result))
+        return NULL;
+
+    if (PathSearch* pathSearch = PathSearch::Queue(*this))
+        return pathSearch;
+
+    // no path worker, search here
+    search(false);
+    result = true;
+    return NULL;
+}
+
+bool PathFinder::prepareSearch(float destX, float destY, float destZ, bool forceDest, bool& result)
+{
+    result = false;
+
     float x, y, z;
     m_sourceUnit->GetPosition(x, y, z);
 
@@ -70,12 +100,13 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
 
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
-    if (!m_navMesh || !m_navMeshQuery || m_sourceUnit->HasUnitState(UNIT_STAT_IGNORE_PATHFINDING) ||
+    if (!m_navMesh || m_sourceUnit->HasUnitState(UNIT_STAT_IGNORE_PATHFINDING) ||
         !HaveTile(start) || !HaveTile(dest))
     {
         BuildShortcut();
         m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
+        result = true;
+        return false;
     }
 
     updateFilter();
@@ -92,12 +123,40 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
         m_pathPoints.erase(m_pathPoints.begin());
         return false;
     }
-    else
+
+    // target moved, so we need to update the poly path
+    // search() may run on other thread, it reads these instead of the unit
+    Creature const* creature = m_sourceUnit->GetTypeId() == TYPEID_UNIT ? m_sourceUnit->ToCreature() : NULL;
+    m_canFly = creature && creature->CanFly();
+    m_canSwim = creature && creature->CanSwim();
+    return true;
+}
+
+void PathFinder::search(bool deferNormalize)
+{
+    m_deferNormalize = deferNormalize;
+
+    // query is borrowed from map's pool only for this search
+    MMAP::NavMeshQueryHolder query(m_mapId);
+    m_navMeshQuery = query.GetQuery();
+    if (!m_navMeshQuery)
     {
-        // target moved, so we need to update the poly path
-        BuildPolyPath(start, dest);
-        return true;
+        BuildShortcut();
+        m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return;
     }
+
+    BuildPolyPath(m_startPosition, m_endPosition);
+    m_navMeshQuery = NULL;
+}
+
+void PathFinder::finishSearch()
+{
+    if (!m_deferNormalize)
+        return;
+
+    m_deferNormalize = false;
+    NormalizePath();
 }
 
 dtPolyRef PathFinder::getPathPolyByPosition(const dtPolyRef *polyPath, uint32 polyPathSize, const float* point, float *distance) const
@@ -186,14 +245,14 @@ void PathFinder::BuildPolyPath(const Vector3 &startPos, const Vector3 &endPos)
         //DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: (startPoly == 0 || endPoly == 0)\n");
         BuildShortcut();
 
-        bool path = m_sourceUnit->GetTypeId() == TYPEID_UNIT && m_sourceUnit->ToCreature()->CanFly();
-        bool waterPath = m_sourceUnit->GetTypeId() == TYPEID_UNIT && m_sourceUnit->ToCreature()->CanSwim();
+        bool path = m_canFly;
+        bool waterPath = m_canSwim;
         if (waterPath)
         {
             // Check both start and end points, if they're both in water, then we can *safely* let the creature move
             for (int i = 0; i < m_pathPoints.size(); ++i)
             {
-                if (waterPath = m_sourceUnit->GetTerrain()->IsInWater(m_pathPoints[i].x, m_pathPoints[i].y, m_pathPoints[i].z))
+                if (waterPath = m_terrain->IsInWater(m_pathPoints[i].x, m_pathPoints[i].y, m_pathPoints[i].z))
                     continue;
 
                 break;
@@ -211,21 +270,19 @@ void PathFinder::BuildPolyPath(const Vector3 &startPos, const Vector3 &endPos)
         //DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: farFromPoly distToStartPoly=%.3f distToEndPoly=%.3f\n", distToStartPoly, distToEndPoly);
 
         bool buildShotrcut = false;
-        if (m_sourceUnit->GetTypeId() == TYPEID_UNIT)
+        if (m_canSwim || m_canFly)
         {
-            Creature* owner = (Creature*)m_sourceUnit;
-
             Vector3 p = (distToStartPoly > 7.0f) ? startPos : endPos;
-            if (m_sourceUnit->GetTerrain()->IsInWater(p.x, p.y, p.z))
+            if (m_terrain->IsInWater(p.x, p.y, p.z))
             {
                 //DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: underWater case\n");
-                if (owner->CanSwim())
+                if (m_canSwim)
                     buildShotrcut = true;
             }
             else
             {
                 //DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: flying case\n");
-                if (owner->CanFly())
+                if (m_canFly)
                     buildShotrcut = true;
             }
         }
@@ -362,7 +419,7 @@ void PathFinder::BuildPolyPath(const Vector3 &startPos, const Vector3 &endPos)
             // this is probably an error state, but we'll leave it
             // and hopefully recover on the next Update
             // we still need to copy our preffix
-            sLog.outLog(LOG_DEFAULT, "ERROR: %u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+            sLog.outLog(LOG_DEFAULT, "ERROR: %u's Path Build failed: 0 length path", m_sourceGuidLow);
         }
 
         //DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n",m_polyLength, prefixPolyLength, suffixPolyLength);
@@ -381,20 +438,12 @@ void PathFinder::BuildPolyPath(const Vector3 &startPos, const Vector3 &endPos)
         // free and invalidate old path data
         clear();
 
-        dtStatus dtResult = m_navMeshQuery->findPath(
-                startPoly,          // start polygon
-                endPoly,            // end polygon
-                startPoint,         // start position
-                endPoint,           // end position
-                &m_filter,           // polygon search filter
-                m_pathPolyRefs,     // [out] path
-                (int*)&m_polyLength,
-                MAX_PATH_LENGTH);   // max number of polygons in output path
+        dtStatus dtResult = findPolyPath(startPoly, endPoly, startPoint, endPoint);
 
         if (!m_polyLength || dtResult != DT_SUCCESS)
         {
             // only happens if we passed bad data to findPath(), or navmesh is messed up
-            sLog.outLog(LOG_DEFAULT, "ERROR: %u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+            sLog.outLog(LOG_DEFAULT, "ERROR: %u's Path Build failed: 0 length path", m_sourceGuidLow);
             BuildShortcut();
             m_type = PATHFIND_NOPATH;
             return;
@@ -411,6 +460,38 @@ void PathFinder::BuildPolyPath(const Vector3 &startPos, const Vector3 &endPos)
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathFinder::findPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, const float* startPoint, const float* endPoint)
+{
+    if (!m_pathCache)
+    {
+        return m_navMeshQuery->findPath(
+                startPoly,          // start polygon
+                endPoly,            // end polygon
+                startPoint,         // start position
+                endPoint,           // end position
+                &m_filter,           // polygon search filter
+                m_pathPolyRefs,     // [out] path
+                (int*)&m_polyLength,
+                MAX_PATH_LENGTH);   // max number of polygons in output path
+    }
+
+    // corridor between two polys does not depend on exact positions inside them much,
+    // so units coming from same poly to same target poly reuse one search
+    MMAP::PolyPathKey key(startPoly, endPoly, m_filter.getIncludeFlags(), m_filter.getExcludeFlags());
+    if (m_pathCache->Get(key, m_pathPolyRefs, m_polyLength, MAX_PATH_LENGTH))
+        return DT_SUCCESS;
+
+    uint32 generation = m_pathCache->GetGeneration();
+    dtStatus dtResult = m_navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &m_filter,
+                                                 m_pathPolyRefs, (int*)&m_polyLength, MAX_PATH_LENGTH);
+
+    // only complete paths, partial ones depend on search limits
+    if (dtResult == DT_SUCCESS && m_polyLength && m_pathPolyRefs[m_polyLength - 1] == endPoly)
+        m_pathCache->Put(key, m_pathPolyRefs, m_polyLength, generation, sWorld.getConfig(CONFIG_MMAP_PATH_CACHE_SIZE));
+
+    return dtResult;
+}
+
 void PathFinder::BuildPointPath(const float *startPoint, const float *endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
@@ -492,6 +573,10 @@ void PathFinder::BuildPointPath(const float *startPoint, const float *endPoint)
 
 void PathFinder::NormalizePath()
 {
+    // heights depend on unit state, see finishSearch()
+    if (m_deferNormalize)
+        return;
+
     for (uint32 i = 0; i < m_pathPoints.size(); ++i)
         m_sourceUnit->UpdateAllowedPositionZ(m_pathPoints[i].x, m_pathPoints[i].y, m_pathPoints[i].z);
 }
@@ -828,3 +913,67 @@ void PathFinder::stepBack(float distance)
 
     setActualEndPosition(m_pathPoints.back());
 }
+
+class PathSearchRequest : public ACE_Method_Request
+{
+    public:
+        PathSearchRequest(PathSearch* pathSearch) : m_pathSearch(pathSearch) {}
+        ~PathSearchRequest() { m_pathSearch->Release(); }
+
+        virtual int call()
+        {
+            m_pathSearch->Search();
+            return 0;
+        }
+
+    private:
+        PathSearch* m_pathSearch;
+};
+
+PathSearch::PathSearch(PathFinder const& path) : m_path(new PathFinder(path)), m_done(false), m_references(2)
+{
+    m_terrain = sTerrainMgr.LoadTerrain(path.m_mapId);
+    m_terrain->AddRef();
+}
+
+PathSearch::~PathSearch()
+{
+    delete m_path;
+
+    if (m_terrain->Release())
+        sTerrainMgr.UnloadTerrain(m_terrain->GetMapId());
+}
+
+PathSearch* PathSearch::Queue(PathFinder const& path)
+{
+    // one reference for the caller, one for the request
+    PathSearch* pathSearch = new PathSearch(path);
+    if (!MMAP::MMapFactory::createOrGetMMapManager()->queuePathSearch(new PathSearchRequest(pathSearch)))
+    {
+        pathSearch->Release();
+        return NULL;
+    }
+
+    return pathSearch;
+}
+
+void PathSearch::Search()
+{
+    m_path->search(true);
+    m_done.store(true, std::memory_order_release);
+}
+
+PathFinder* PathSearch::TakePath()
+{
+    PathFinder* path = m_path;
+    m_path = NULL;
+
+    path->finishSearch();
+    return path;
+}
+
+void PathSearch::Release()
+{
+    if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete this;
+}
@@ -26,10 +26,19 @@
 
 #include "movement/MoveSplineInitArgs.h"
 
+#include <atomic>
+
 using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
+class TerrainInfo;
+class PathSearch;
+
+namespace MMAP
+{
+    class PolyPathCache;
+}
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -63,6 +72,9 @@ class PathFinder
         // Calculate the path from owner to given destination
         // return: true if new path was calculated, false otherwise (no change needed)
         bool calculate(float destX, float destY, float destZ, bool forceDest = false);
+        // same as calculate(), but navmesh search runs on path worker thread when one is needed.
+        // return: queued search, path is then taken from it when done; NULL when calculated here
+        PathSearch* calculateAsync(float destX, float destY, float destZ, bool forceDest, bool& result);
         // after calculating we can make our path a bit shorter (to arive distance before end point)
         void stepBack(float distance);
         // we like to start calculations from begining
@@ -85,6 +97,7 @@ class PathFinder
         PathType getPathType() const { return m_type; }
 
     private:
+        friend class PathSearch;
 
         dtPolyRef      m_pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32         m_polyLength;                      // number of polygons in the path
@@ -100,9 +113,16 @@ class PathFinder
         Vector3        m_endPosition;      // {x, y, z} of the destination
         Vector3        m_actualEndPosition;// {x, y, z} of the closest possible point to given destination
 
-        const Unit* const       m_sourceUnit;       // the unit that is moving
+        const Unit* const       m_sourceUnit;       // the unit that is moving, never read by search()
+        uint32                  m_mapId;
+        uint32                  m_sourceGuidLow;
+        TerrainInfo const*      m_terrain;
+        bool                    m_canFly;           // unit state taken by prepareSearch() for search()
+        bool                    m_canSwim;
+        bool                    m_deferNormalize;   // heights are normalized by finishSearch() on unit's thread
         const dtNavMesh*        m_navMesh;          // the nav mesh
-        const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path, set only during calculate()
+        MMAP::PolyPathCache*    m_pathCache;        // poly paths shared between units on the map
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
@@ -125,9 +145,16 @@ class PathFinder
         bool HaveTile(const Vector3 &p) const;
 
         void BuildPolyPath(const Vector3 &startPos, const Vector3 &endPos);
+        dtStatus findPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, const float* startPoint, const float* endPoint);
         void BuildPointPath(const float *startPoint, const float *endPoint);
         void BuildShortcut();
 
+        // calculate() in steps: prepareSearch() and finishSearch() on unit's thread, search() on any thread
+        // prepareSearch() return: false when no navmesh search is needed, calculate() result is in result
+        bool prepareSearch(float destX, float destY, float destZ, bool forceDest, bool& result);
+        void search(bool deferNormalize);
+        void finishSearch();
+
         void NormalizePath();
 
         NavTerrain getNavTerrain(float x, float y, float z);
@@ -145,4 +172,32 @@ class PathFinder
                               float* smoothPath, int* smoothPathSize, uint32 smoothPathMaxSize);
 };
 
+// path searched by path worker thread for moving unit, which keeps its current spline meanwhile.
+// worker searches on a copy of unit's PathFinder with navmesh query borrowed for the search.
+// shared by unit's movement generator and the worker, whoever releases it last deletes it
+class PathSearch
+{
+    public:
+        // NULL when search can't be queued
+        static PathSearch* Queue(PathFinder const& path);
+
+        bool IsDone() const { return m_done.load(std::memory_order_acquire); }
+        // only when done, on unit's thread. caller owns returned path
+        PathFinder* TakePath();
+        void Release();
+
+    private:
+        friend class PathSearchRequest;
+
+        PathSearch(PathFinder const& path);
+        ~PathSearch();
+
+        void Search();
+
+        PathFinder* m_path;
+        TerrainInfo* m_terrain;                     // keeps terrain and its navmesh loaded while searching
+        std::atomic<bool> m_done;
+        std::atomic<uint32> m_references;
+};
+
 #endif
@@ -43,6 +43,16 @@ namespace VMAP
     #define VMAP_INVALID_HEIGHT       -100000.0f            // for check
     #define VMAP_INVALID_HEIGHT_VALUE -200000.0f            // real assigned value in unknown height case
 
+    // one ray of a batched line of sight query
+    struct LoSRequest
+    {
+        uint32 mapId;
+        float x1, y1, z1;
+        float x2, y2, z2;
+        bool alsom2;
+        bool result;
+    };
+
     //===========================================================
     class IVMapManager
     {
@@ -63,6 +73,8 @@ namespace VMAP
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool alsom2 = false) = 0;
             virtual bool isInLineOfSight2(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool debug = false, bool alsom2 = false) = 0;
+            // fills result of every request, spread over LoSPool threads when enabled
+            virtual void isInLineOfSightBatch(LoSRequest* requests, uint32 count) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx,ry,rz will hold the hit position or the dest position, if no intersection was found
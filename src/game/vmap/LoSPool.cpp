@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2008-2017 Hellground <http://wow-hellground.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "LoSPool.h"
+#include "Log.h"
+
+#include <ace/Thread.h>
+
+namespace VMAP
+{
+    // rays claimed at once, keeps the shared counter off the hot path
+    static const uint32 LOS_POOL_CHUNK = 4;
+
+    struct LoSBatch
+    {
+        LoSBatch(IVMapManager* mgr, LoSRequest* requests, uint32 count) : mgr(mgr), requests(requests), count(count)
+        {
+            next.store(0, std::memory_order_relaxed);
+            done.store(0, std::memory_order_relaxed);
+            refs.store(1, std::memory_order_relaxed);
+        }
+
+        void AddRef() { refs.fetch_add(1, std::memory_order_relaxed); }
+
+        void Release()
+        {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete this;
+        }
+
+        // traces chunks until none is left, returns number of rays traced
+        uint32 Work()
+        {
+            uint32 traced = 0;
+            for (;;)
+            {
+                uint32 begin = next.fetch_add(LOS_POOL_CHUNK, std::memory_order_relaxed);
+                if (begin >= count)
+                    break;
+
+                uint32 end = std::min(begin + LOS_POOL_CHUNK, count);
+                for (uint32 i = begin; i < end; ++i)
+                {
+                    LoSRequest& req = requests[i];
+                    req.result = mgr->isInLineOfSight2(req.mapId, req.x1, req.y1, req.z1, req.x2, req.y2, req.z2, false, req.alsom2);
+                }
+
+                traced += end - begin;
+                done.fetch_add(end - begin, std::memory_order_release);
+            }
+            return traced;
+        }
+
+        IVMapManager* mgr;
+        LoSRequest* requests;
+        uint32 count;
+
+        std::atomic<uint32> next;
+        std::atomic<uint32> done;
+        // helpers queued behind other work may run after the caller returned,
+        // they find nothing to claim and only drop their reference
+        std::atomic<uint32> refs;
+    };
+
+    class LoSPoolRequest : public ACE_Method_Request
+    {
+        public:
+            LoSPoolRequest(LoSBatch* batch, std::atomic<uint64>& helperRays) : m_batch(batch), m_helperRays(helperRays)
+            {
+                m_batch->AddRef();
+            }
+
+            ~LoSPoolRequest()
+            {
+                m_batch->Release();
+            }
+
+            virtual int call()
+            {
+                uint32 traced = m_batch->Work();
+                if (traced)
+                    m_helperRays.fetch_add(traced, std::memory_order_relaxed);
+
+                return 0;
+            }
+
+        private:
+            LoSBatch* m_batch;
+            std::atomic<uint64>& m_helperRays;
+    };
+
+    LoSPool::LoSPool() : m_threads(0)
+    {
+        m_batches.store(0, std::memory_order_relaxed);
+        m_rays.store(0, std::memory_order_relaxed);
+        m_helperRays.store(0, std::memory_order_relaxed);
+    }
+
+    void LoSPool::Start(uint32 threads)
+    {
+        if (!threads || m_executor.activated())
+            return;
+
+        if (m_executor.activate(threads) == -1)
+        {
+            sLog.outLog(LOG_DEFAULT, "ERROR: LoSPool: failed to start %u threads", threads);
+            return;
+        }
+
+        m_threads = threads;
+        sLog.outString("LoSPool: %u line of sight threads started", threads);
+    }
+
+    void LoSPool::Stop()
+    {
+        if (!m_executor.activated())
+            return;
+
+        m_threads = 0;
+        m_executor.deactivate();
+    }
+
+    void LoSPool::Check(IVMapManager* mgr, LoSRequest* requests, uint32 count)
+    {
+        if (!count)
+            return;
+
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+        m_rays.fetch_add(count, std::memory_order_relaxed);
+
+        LoSBatch* batch = new LoSBatch(mgr, requests, count);
+
+        // caller takes the first chunk, helpers only for what is left
+        uint32 helpers = std::min(m_threads, (count - 1) / LOS_POOL_CHUNK);
+        for (uint32 i = 0; i < helpers; ++i)
+        {
+            // executor frees the request on failure
+            if (m_executor.execute(new LoSPoolRequest(batch, m_helperRays)) == -1)
+                break;
+        }
+
+        batch->Work();
+
+        // only chunks already claimed by helpers can be left, each is a few rays
+        while (batch->done.load(std::memory_order_acquire) < count)
+            ACE_Thread::yield();
+
+        batch->Release();
+    }
+
+    LoSPoolStats LoSPool::GetStats() const
+    {
+        LoSPoolStats stats;
+        stats.batches = m_batches.load(std::memory_order_relaxed);
+        stats.rays = m_rays.load(std::memory_order_relaxed);
+        stats.helperRays = m_helperRays.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2008-2017 Hellground <http://wow-hellground.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef HELLGROUND_LOSPOOL_H
+#define HELLGROUND_LOSPOOL_H
+
+#include <ace/Singleton.h>
+#include <ace/Null_Mutex.h>
+
+#include <atomic>
+
+#include "DelayExecutor.h"
+#include "IVMapManager.h"
+
+#define sLoSPool (*ACE_Singleton<VMAP::LoSPool, ACE_Null_Mutex>::instance())
+
+namespace VMAP
+{
+    struct LoSPoolStats
+    {
+        LoSPoolStats() : batches(0), rays(0), helperRays(0) {}
+
+        uint64 batches;
+        uint64 rays;
+        uint64 helperRays;                                  // rays traced by pool threads instead of the caller
+    };
+
+    /**
+     * In process replacement for the vmap cluster.
+     *
+     * Pool threads read the same StaticMapTree data the map threads use, so
+     * a batch of rays is split between the calling thread and the helpers
+     * without copying or serializing anything. Single rays never leave the
+     * calling thread, handing one ray over costs more than tracing it.
+     */
+    class LoSPool
+    {
+        public:
+            LoSPool();
+
+            // number of helper threads, 0 disables the pool
+            void Start(uint32 threads);
+            void Stop();
+
+            uint32 GetThreads() const { return m_threads; }
+
+            // fills result of every request, returns when all are done
+            void Check(IVMapManager* mgr, LoSRequest* requests, uint32 count);
+
+            LoSPoolStats GetStats() const;
+
+        private:
+            DelayExecutor m_executor;
+            uint32 m_threads;
+
+            std::atomic<uint64> m_batches;
+            std::atomic<uint64> m_rays;
+            std::atomic<uint64> m_helperRays;
+    };
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include <string>
 #include <sstream>
 #include "VMapCluster.h"
+#include "LoSPool.h"
 #include "VMapManager2.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
@@ -164,6 +165,24 @@ namespace VMAP
     }
 
 
+    void VMapManager2::isInLineOfSightBatch(LoSRequest* requests, uint32 count)
+    {
+        if (isClusterComputingEnabled())
+        {
+            for (uint32 i = 0; i < count; ++i)
+                requests[i].result = sLoSProxy.isInLineOfSight(requests[i].mapId, requests[i].x1, requests[i].y1, requests[i].z1,
+                    requests[i].x2, requests[i].y2, requests[i].z2, requests[i].alsom2);
+        }
+        else if (count > 1 && sLoSPool.GetThreads())
+            sLoSPool.Check(this, requests, count);
+        else
+        {
+            for (uint32 i = 0; i < count; ++i)
+                requests[i].result = isInLineOfSight2(requests[i].mapId, requests[i].x1, requests[i].y1, requests[i].z1,
+                    requests[i].x2, requests[i].y2, requests[i].z2, false, requests[i].alsom2);
+        }
+    }
+
     bool VMapManager2::isInLineOfSight2(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool debug, bool alsom2)
     {
         bool result = true;
@@ -87,6 +87,7 @@ namespace VMAP
 
             bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool alsom2 = false) ;
             bool isInLineOfSight2(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool debug = false, bool alsom2 = false);
+            void isInLineOfSightBatch(LoSRequest* requests, uint32 count);
             /**
             fill the hit pos and return true, if an object was hit
             */
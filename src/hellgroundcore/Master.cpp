@@ -352,10 +352,11 @@ bool Master::_StartDB()
     }
 
     int nConnections = sConfig.GetIntDefault("WorldDatabaseConnections", 1);
-    sLog.outString("World Database: total connections: %i", nConnections + 1);
+    int nAsyncConnections = sConfig.GetIntDefault("WorldDatabaseAsyncConnections", 1);
+    sLog.outString("World Database: total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the world database
-    if(!GameDataDatabase.Initialize(dbstring.c_str(), nConnections))
+    if(!GameDataDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outLog(LOG_DEFAULT, "ERROR: Cannot connect to world database.");
         return false;
@@ -368,10 +369,11 @@ bool Master::_StartDB()
         return false;
     }
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
-    sLog.outString("Character Database: total connections: %i", nConnections + 1);
+    nAsyncConnections = sConfig.GetIntDefault("CharacterDatabaseAsyncConnections", 1);
+    sLog.outString("Character Database: total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the Character database
-    if(!RealmDataDatabase.Initialize(dbstring.c_str(), nConnections))
+    if(!RealmDataDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
          sLog.outLog(LOG_DEFAULT, "ERROR: Cannot connect to characters database.");
         return false;
@@ -385,9 +387,10 @@ bool Master::_StartDB()
         return false;
     }
     nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+    nAsyncConnections = sConfig.GetIntDefault("LoginDatabaseAsyncConnections", 1);
     ///- Initialise the login database
-    sLog.outString("Login Database: total connections: %i", nConnections + 1);
-    if(!AccountsDatabase.Initialize(dbstring.c_str(), nConnections))
+    sLog.outString("Login Database: total connections: %i", nConnections + nAsyncConnections);
+    if(!AccountsDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outLog(LOG_DEFAULT, "ERROR: Cannot connect to login database.");
         return false;
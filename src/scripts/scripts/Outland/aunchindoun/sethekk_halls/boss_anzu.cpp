@@ -216,8 +216,8 @@ struct npc_anzu_spiritAI : public Scripted_NoMovementAI
     {
         if (_Timer.Expired(diff))
         {
-            const Unit::AuraList& auras = me->GetAurasByType(SPELL_AURA_PERIODIC_HEAL);
-            for (Unit::AuraList::const_iterator i = auras.begin(); i != auras.end(); ++i)
+            const Unit::AuraTypeList& auras = me->GetAurasByType(SPELL_AURA_PERIODIC_HEAL);
+            for (Unit::AuraTypeList::const_iterator i = auras.begin(); i != auras.end(); ++i)
             {
                 if (isDruidHotSpell((*i)->GetSpellProto()))
                 {
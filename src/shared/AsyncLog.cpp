@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2008-2015 Hellground <http://hellground.net/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "AsyncLog.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_time.h>
+
+#include <cstdio>
+#include <cstring>
+
+/// Single producer (owning thread), single consumer (drain) byte ring.
+/// Records are [header][text] padded to 8 bytes, a WRAP header tells the
+/// reader to skip the unused tail of the ring.
+class AsyncLogBuffer
+{
+    struct Header
+    {
+        uint32 length;
+        uint16 target;
+        uint16 unused;
+    };
+
+    static const uint16 WRAP = 0xFFFF;
+
+    static size_t Align(size_t size) { return (size + 7) & ~size_t(7); }
+
+    public:
+        explicit AsyncLogBuffer(size_t size) : m_orphan(false)
+        {
+            m_size = 1024;
+            while (m_size < size)
+                m_size <<= 1;
+
+            m_mask = m_size - 1;
+            m_data = new char[m_size];
+            m_head.store(0, std::memory_order_relaxed);
+            m_tail.store(0, std::memory_order_relaxed);
+        }
+
+        ~AsyncLogBuffer() { delete [] m_data; }
+
+        // producer side, false if there is no room for the record
+        bool Write(uint16 target, const char* data, uint32 length)
+        {
+            // never let one record take more than half of the ring
+            if (sizeof(Header) + Align(length) > m_size / 2)
+                length = uint32(m_size / 2 - sizeof(Header));
+
+            size_t need = sizeof(Header) + Align(length);
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            size_t head = m_head.load(std::memory_order_acquire);
+            size_t offset = tail & m_mask;
+            size_t contiguous = m_size - offset;
+            size_t total = need <= contiguous ? need : contiguous + need;
+
+            if (m_size - (tail - head) < total)
+                return false;
+
+            if (need > contiguous)
+            {
+                reinterpret_cast<Header*>(m_data + offset)->target = WRAP;
+                tail += contiguous;
+                offset = 0;
+            }
+
+            Header* header = reinterpret_cast<Header*>(m_data + offset);
+            header->length = length;
+            header->target = target;
+            memcpy(header + 1, data, length);
+
+            m_tail.store(tail + need, std::memory_order_release);
+            return true;
+        }
+
+        // consumer side, appends every queued record to batches[target]
+        void Read(std::vector<std::string>& batches)
+        {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            size_t tail = m_tail.load(std::memory_order_acquire);
+
+            while (head != tail)
+            {
+                size_t offset = head & m_mask;
+                Header const* header = reinterpret_cast<Header const*>(m_data + offset);
+
+                if (header->target == WRAP)
+                {
+                    head += m_size - offset;
+                    continue;
+                }
+
+                if (header->target < batches.size())
+                    batches[header->target].append(reinterpret_cast<char const*>(header + 1), header->length);
+
+                head += sizeof(Header) + Align(header->length);
+            }
+
+            m_head.store(head, std::memory_order_release);
+        }
+
+        bool Empty() const
+        {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
+        bool HalfFull() const
+        {
+            return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed) > m_size / 2;
+        }
+
+        // set when owning thread exits, drain frees the buffer once empty
+        volatile bool m_orphan;
+
+    private:
+        char* m_data;
+        size_t m_size;
+        size_t m_mask;
+        std::atomic<size_t> m_head;
+        std::atomic<size_t> m_tail;
+};
+
+AsyncLogQueue::BufferHolder::~BufferHolder()
+{
+    if (buffer)
+        buffer->m_orphan = true;
+}
+
+AsyncLogQueue::AsyncLogQueue(Log& log, uint32 targets, size_t bufferSize, AsyncLogPolicy policy) :
+    m_log(log), m_bufferSize(bufferSize), m_policy(policy), m_stopped(false), m_droppedReported(0),
+    m_batches(targets), m_wakeCond(m_wakeLock), m_wakePending(false)
+{
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+AsyncLogQueue::~AsyncLogQueue()
+{
+    Drain();
+
+    for (std::vector<AsyncLogBuffer*>::iterator itr = m_buffers.begin(); itr != m_buffers.end(); ++itr)
+        delete *itr;
+}
+
+AsyncLogBuffer* AsyncLogQueue::GetThreadBuffer()
+{
+    BufferHolder* holder = m_threadBuffer.ts_object();
+    if (!holder)
+        return NULL;
+
+    if (!holder->buffer)
+    {
+        holder->buffer = new AsyncLogBuffer(m_bufferSize);
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_registryLock, NULL);
+        m_buffers.push_back(holder->buffer);
+    }
+
+    return holder->buffer;
+}
+
+void AsyncLogQueue::Push(uint32 target, const char* data, uint32 size)
+{
+    AsyncLogBuffer* buffer = GetThreadBuffer();
+    if (!buffer)
+    {
+        m_dropped++;
+        return;
+    }
+
+    while (!buffer->Write(uint16(target), data, size))
+    {
+        Wake();
+
+        // writer already gone, nobody would ever make room
+        if (m_policy == ASYNC_LOG_DROP || m_stopped)
+        {
+            m_dropped++;
+            return;
+        }
+
+        ACE_Based::Thread::Sleep(1);
+    }
+
+    if (buffer->HalfFull())
+        Wake();
+}
+
+void AsyncLogQueue::WriteV(uint32 target, const char* str, va_list ap)
+{
+    char stackBuf[1024];
+    std::string heapBuf;
+
+    time_t t = time(NULL);
+    tm aTm;
+    ACE_OS::localtime_r(&t, &aTm);
+
+    int prefix = snprintf(stackBuf, sizeof(stackBuf), "%-4d-%02d-%02d %02d:%02d:%02d ",
+        aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
+
+    va_list copy;
+    va_copy(copy, ap);
+    int length = vsnprintf(stackBuf + prefix, sizeof(stackBuf) - prefix - 1, str, copy);
+    va_end(copy);
+
+    if (length < 0)
+        return;
+
+    char* data = stackBuf;
+    if (size_t(prefix + length + 1) >= sizeof(stackBuf))
+    {
+        heapBuf.resize(prefix + length + 2);
+        memcpy(&heapBuf[0], stackBuf, prefix);
+        vsnprintf(&heapBuf[prefix], length + 1, str, ap);
+        data = &heapBuf[0];
+    }
+
+    data[prefix + length] = '\n';
+    Push(target, data, uint32(prefix + length + 1));
+}
+
+void AsyncLogQueue::Write(uint32 target, const char* str, ...)
+{
+    va_list ap;
+    va_start(ap, str);
+    WriteV(target, str, ap);
+    va_end(ap);
+}
+
+void AsyncLogQueue::Drain()
+{
+    ACE_GUARD(ACE_Thread_Mutex, drainGuard, m_drainLock);
+
+    std::vector<AsyncLogBuffer*> buffers;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_registryLock);
+        buffers = m_buffers;
+    }
+
+    bool orphans = false;
+    for (std::vector<AsyncLogBuffer*>::iterator itr = buffers.begin(); itr != buffers.end(); ++itr)
+    {
+        bool orphan = (*itr)->m_orphan;
+        (*itr)->Read(m_batches);
+        orphans |= orphan;
+    }
+
+    uint64 dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_droppedReported && LOG_DEFAULT < m_batches.size())
+    {
+        char buf[128];
+        int length = snprintf(buf, sizeof(buf), "ERROR: AsyncLog: %lu records dropped, thread buffers full\n", (unsigned long)(dropped - m_droppedReported));
+        if (length > 0)
+            m_batches[LOG_DEFAULT].append(buf, length);
+
+        m_droppedReported = dropped;
+    }
+
+    for (uint32 i = 0; i < m_batches.size(); ++i)
+    {
+        if (m_batches[i].empty())
+            continue;
+
+        m_log.writeBatch(i, m_batches[i].data(), m_batches[i].size());
+        m_batches[i].clear();
+    }
+
+    // threads that logged once and finished leave their buffers behind
+    if (orphans)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_registryLock);
+        for (std::vector<AsyncLogBuffer*>::iterator itr = m_buffers.begin(); itr != m_buffers.end();)
+        {
+            if ((*itr)->m_orphan && (*itr)->Empty())
+            {
+                delete *itr;
+                itr = m_buffers.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+}
+
+void AsyncLogQueue::WaitForWork(uint32 msecs)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_wakeLock);
+
+    if (!m_wakePending)
+    {
+        ACE_Time_Value timeout = ACE_OS::gettimeofday() + ACE_Time_Value(msecs / 1000, (msecs % 1000) * 1000);
+        m_wakeCond.wait(&timeout);
+    }
+
+    m_wakePending = false;
+}
+
+void AsyncLogQueue::Wake()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_wakeLock);
+
+    m_wakePending = true;
+    m_wakeCond.signal();
+}
+
+void AsyncLogRunnable::run()
+{
+    while (!m_stop)
+    {
+        m_queue.WaitForWork(m_flushInterval);
+        m_queue.Drain();
+    }
+
+    m_queue.Drain();
+}
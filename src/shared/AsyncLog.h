@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2008-2015 Hellground <http://hellground.net/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef HELLGROUND_ASYNCLOG_H
+#define HELLGROUND_ASYNCLOG_H
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/TSS_T.h>
+
+#include <atomic>
+#include <cstdarg>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+#include "Threading.h"
+
+class Log;
+class AsyncLogBuffer;
+
+enum AsyncLogPolicy
+{
+    ASYNC_LOG_DROP  = 0,                                    // drop records when thread buffer is full
+    ASYNC_LOG_BLOCK = 1                                     // wait until writer makes room
+};
+
+// Owns per thread record buffers and drains them into batched file writes.
+// Records of one thread keep their order, records of different threads
+// going to the same file may interleave between two drains.
+class AsyncLogQueue
+{
+    public:
+        AsyncLogQueue(Log& log, uint32 targets, size_t bufferSize, AsyncLogPolicy policy);
+        ~AsyncLogQueue();
+
+        // formats timestamp + str + '\n' into calling thread buffer
+        void WriteV(uint32 target, const char* str, va_list ap);
+        void Write(uint32 target, const char* str, ...) ATTR_PRINTF(3, 4);
+
+        // moves everything queued so far into files, safe from any thread
+        void Drain();
+
+        void WaitForWork(uint32 msecs);
+        void Wake();
+
+        void SetStopped() { m_stopped = true; }
+        uint64 GetDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    private:
+        struct BufferHolder
+        {
+            BufferHolder() : buffer(NULL) {}
+            ~BufferHolder();
+
+            AsyncLogBuffer* buffer;
+        };
+
+        AsyncLogBuffer* GetThreadBuffer();
+        void Push(uint32 target, const char* data, uint32 size);
+
+        Log& m_log;
+        size_t m_bufferSize;
+        AsyncLogPolicy m_policy;
+        volatile bool m_stopped;
+
+        std::atomic<uint64> m_dropped;
+        uint64 m_droppedReported;
+
+        ACE_TSS<BufferHolder> m_threadBuffer;
+
+        ACE_Thread_Mutex m_registryLock;
+        std::vector<AsyncLogBuffer*> m_buffers;
+
+        // serializes consumers, writer thread and Flush() callers
+        ACE_Thread_Mutex m_drainLock;
+        std::vector<std::string> m_batches;
+
+        ACE_Thread_Mutex m_wakeLock;
+        ACE_Condition_Thread_Mutex m_wakeCond;
+        bool m_wakePending;
+};
+
+class AsyncLogRunnable : public ACE_Based::Runnable
+{
+    public:
+        AsyncLogRunnable(AsyncLogQueue& queue, uint32 flushInterval) :
+            m_queue(queue), m_flushInterval(flushInterval), m_stop(false) {}
+
+        void run();
+        void Stop() { m_stop = true; m_queue.Wake(); }
+
+    private:
+        AsyncLogQueue& m_queue;
+        uint32 m_flushInterval;
+        volatile bool m_stop;
+};
+
+#endif
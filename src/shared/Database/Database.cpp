@@ -21,6 +21,7 @@
 #include "Config/Config.h"
 #include "Database/SqlOperations.h"
 
+#include <algorithm>
 #include <ctime>
 #include <iostream>
 #include <fstream>
@@ -100,7 +101,7 @@ Database::~Database()
     StopServer();
 }
 
-bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char * infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -114,8 +115,10 @@ bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
 
     m_pingIntervalms = (uint32)sConfig.GetIntDefault("MaxPingTime", 60) * IN_MILISECONDS;
     m_minLogTimems = (uint32)sConfig.GetIntDefault("DBDiffLog.LogTime", 10);
+    m_batchRows = (size_t)sConfig.GetIntDefault("DBAsync.BatchRows", 32);
 
     //create DB connections
+    m_infoString = infoString;
 
     //setup connection pool size
     if(nConns < MIN_CONNECTION_POOL_SIZE)
@@ -138,10 +141,25 @@ bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    //create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if(!m_pAsyncConn->Initialize(infoString))
-        return false;
+    //create and initialize connections for async requests
+    if(nAsyncConns < MIN_CONNECTION_POOL_SIZE)
+        nAsyncConns = MIN_CONNECTION_POOL_SIZE;
+    else if(nAsyncConns > MAX_CONNECTION_POOL_SIZE)
+        nAsyncConns = MAX_CONNECTION_POOL_SIZE;
+
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection * pConn = CreateConnection();
+        if(!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConns.push_back(pConn);
+    }
+
+    m_pAsyncConn = m_pAsyncConns[0];
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -159,11 +177,11 @@ void Database::StopServer()
         m_pResultQueue = NULL;
     }
 
-    if(m_pAsyncConn)
-    {
-        delete m_pAsyncConn;
-        m_pAsyncConn = NULL;
-    }
+    for (size_t i = 0; i < m_pAsyncConns.size(); ++i)
+        delete m_pAsyncConns[i];
+
+    m_pAsyncConns.clear();
+    m_pAsyncConn = NULL;
 
     for (size_t i = 0; i < m_pQueryConnections.size(); ++i)
         delete m_pQueryConnections[i];
@@ -172,30 +190,93 @@ void Database::StopServer()
 
 }
 
-SqlDelayThread * Database::CreateDelayThread()
+SqlDelayThread * Database::CreateDelayThread(SqlConnection * conn, uint32 lane)
 {
-    ASSERT(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    ASSERT(conn);
+    return new SqlDelayThread(this, conn, lane);
 }
 
 void Database::InitDelayThread()
 {
-    ASSERT(!m_delayThread);
+    ASSERT(m_delayThreads.empty());
 
-    //New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new ACE_Based::Thread(m_threadBody);
+    //New delay thread for delay execute, one per async connection
+    for (uint32 i = 0; i < m_pAsyncConns.size(); ++i)
+    {
+        SqlDelayThread * body = CreateDelayThread(m_pAsyncConns[i], i);   // will deleted at thread delete
+        m_threadBodies.push_back(body);
+        m_delayThreads.push_back(new ACE_Based::Thread(body));
+    }
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_threadBodies.empty() || m_delayThreads.empty()) return;
+
+    for (size_t i = 0; i < m_threadBodies.size(); ++i)
+        m_threadBodies[i]->Stop();                          //Stop event
+
+    for (size_t i = 0; i < m_delayThreads.size(); ++i)
+        m_delayThreads[i]->wait();                          //Wait for flush to DB
+
+    //requests left behind wait for other threads, go round until every queue is empty
+    for (bool pending = true; pending;)
+    {
+        pending = false;
+        for (size_t i = 0; i < m_threadBodies.size(); ++i)
+            if (!m_threadBodies[i]->ProcessRequests())
+                pending = true;
+    }
+
+    for (size_t i = 0; i < m_delayThreads.size(); ++i)
+        delete m_delayThreads[i];                           //This also deletes thread body
+
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+}
+
+bool Database::DelayOperation(SqlOperation * op)
+{
+    if (m_threadBodies.empty())
+    {
+        delete op;
+        return false;
+    }
+
+    if (m_threadBodies.size() == 1)
+        return m_threadBodies[0]->Delay(op);
+
+    SqlFence fence;
+    uint64 key = GetAsyncKey();
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_asyncLock, false);
+
+    if (!key)
+    {
+        //behave as before pooling, run after everything queued so far
+        for (size_t i = 1; i < m_threadBodies.size(); ++i)
+        {
+            uint64 queued = m_threadBodies[i]->GetQueued();
+            if (m_threadBodies[i]->GetDone() < queued)
+                fence.push_back(std::make_pair(m_threadBodies[i], queued));
+        }
+
+        return m_threadBodies[0]->Delay(op, fence);
+    }
 
-    m_threadBody->Stop();                                   //Stop event
-    m_delayThread->wait();                                  //Wait for flush to DB
-    delete m_delayThread;                                   //This also deletes m_threadBody
-    m_delayThread = NULL;
-    m_threadBody = NULL;
+    //keyed requests only wait for unkeyed ones queued before them
+    uint64 queued = m_threadBodies[0]->GetQueued();
+    if (m_threadBodies[0]->GetDone() < queued)
+        fence.push_back(std::make_pair(m_threadBodies[0], queued));
+
+    return m_threadBodies[1 + key % (m_threadBodies.size() - 1)]->Delay(op, fence);
+}
+
+void Database::GetAsyncStats(std::vector<SqlDelayStats>& stats)
+{
+    stats.resize(m_threadBodies.size());
+    for (size_t i = 0; i < m_threadBodies.size(); ++i)
+        m_threadBodies[i]->GetStats(stats[i]);
 }
 
 void Database::ThreadStart()
@@ -224,8 +305,43 @@ void Database::escape_string(std::string& str)
     delete[] buf;
 }
 
+bool Database::OpenThreadConnection()
+{
+    if (*m_threadConn)
+        return true;
+
+    SqlConnection * pConn = CreateConnection();
+    if (!pConn->Initialize(m_infoString.c_str()))
+    {
+        delete pConn;
+        return false;
+    }
+
+    *m_threadConn = pConn;
+    ++m_threadConnCount;
+    return true;
+}
+
+void Database::CloseThreadConnection()
+{
+    SqlConnection * pConn = *m_threadConn;
+    if (!pConn)
+        return;
+
+    delete pConn;
+    *m_threadConn = NULL;
+    --m_threadConnCount;
+}
+
 SqlConnection * Database::getQueryConnection()
 {
+    // thread connections exist only while startup data loads, skip the TSS lookup otherwise
+    if (m_threadConnCount.value())
+    {
+        if (SqlConnection * pConn = *m_threadConn)
+            return pConn;
+    }
+
     int nCount = 0;
 
     if(m_nQueryCounter == long(1 << 31))
@@ -246,8 +362,9 @@ bool Database::CheckMinLogTime(uint32 time)
 
 void Database::Ping()
 {
+    for (size_t i = 0; i < m_pAsyncConns.size(); ++i)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConns[i]);
         if (guard->Ping())
             abort();
     }
@@ -361,7 +478,7 @@ bool Database::Execute(const char *sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayOperation(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -432,7 +549,7 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     //add SqlTransaction to the async queue
-    m_threadBody->Delay(m_TransStorage->detach());
+    DelayOperation(m_TransStorage->detach());
     return true;
 }
 
@@ -453,6 +570,12 @@ bool Database::CommitTransactionDirect()
     return true;
 }
 
+size_t Database::GetTransactionSize()
+{
+    SqlTransaction * pTrans = m_TransStorage->get();
+    return pTrans ? pTrans->size() : 0;
+}
+
 bool Database::RollbackTransaction()
 {
     if (!m_pAsyncConn)
@@ -571,7 +694,7 @@ bool Database::ExecuteStmt( const SqlStatementID& id, SqlStmtParameters * params
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayOperation(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -598,14 +721,7 @@ SqlStatement Database::CreateStatement(SqlStatementID& index, const char * fmt )
         int nParams = std::count(szFmt.begin(), szFmt.end(), '?');
         //find existing or add a new record in registry
         LOCK_GUARD _guard(m_stmtGuard);
-        PreparedStmtRegistry::const_iterator iter = m_stmtRegistry.find(szFmt);
-        if(iter == m_stmtRegistry.end())
-        {
-            nId = ++m_iStmtIndex;
-            m_stmtRegistry[szFmt] = nId;
-        }
-        else
-            nId = iter->second;
+        nId = RegisterStmt(szFmt);
 
         //save initialized statement index info
         index.init(nId, nParams);
@@ -614,10 +730,25 @@ SqlStatement Database::CreateStatement(SqlStatementID& index, const char * fmt )
     return SqlStatement(index, *this);
 }
 
+int Database::RegisterStmt(const std::string& fmt)
+{
+    PreparedStmtRegistry::const_iterator iter = m_stmtRegistry.find(fmt);
+    if(iter != m_stmtRegistry.end())
+        return iter->second;
+
+    int nId = ++m_iStmtIndex;
+    m_stmtRegistry[fmt] = nId;
+    return nId;
+}
+
 std::string Database::GetStmtString(const int stmtId) const
 {
     LOCK_GUARD _guard(m_stmtGuard);
+    return GetStmtStringUnlocked(stmtId);
+}
 
+std::string Database::GetStmtStringUnlocked(const int stmtId) const
+{
     if(stmtId == -1 || stmtId > m_iStmtIndex)
         return std::string();
 
@@ -631,6 +762,74 @@ std::string Database::GetStmtString(const int stmtId) const
     return std::string();
 }
 
+//"INSERT INTO t (a, b) VALUES (?, ?)" -> "INSERT INTO t (a, b) VALUES (?, ?),(?, ?)..."
+static bool MakeBatchedStmt(const std::string& fmt, int rows, std::string& result)
+{
+    std::string lower(fmt);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    size_t start = lower.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos)
+        return false;
+
+    if (lower.compare(start, 6, "insert") != 0 && lower.compare(start, 7, "replace") != 0)
+        return false;
+
+    if (lower.find("select") != std::string::npos || lower.find("on duplicate") != std::string::npos)
+        return false;
+
+    size_t values = lower.find("values");
+    if (values == std::string::npos)
+        return false;
+
+    size_t open = lower.find('(', values);
+    size_t close = lower.find_last_not_of(" \t\r\n;");
+    if (open == std::string::npos || close == std::string::npos || lower[close] != ')')
+        return false;
+
+    //all parameters must be inside single values tuple
+    if (std::count(lower.begin(), lower.begin() + open, '?'))
+        return false;
+
+    int depth = 0;
+    for (size_t i = open; i <= close; ++i)
+    {
+        if (lower[i] == '(')
+            ++depth;
+        else if (lower[i] == ')' && --depth == 0 && i != close)
+            return false;
+    }
+
+    std::string tuple = fmt.substr(open, close - open + 1);
+    result = fmt.substr(0, close + 1);
+    result.reserve(result.size() + (tuple.size() + 1) * (rows - 1));
+    for (int i = 1; i < rows; ++i)
+        result.append(",").append(tuple);
+
+    return true;
+}
+
+int Database::GetBatchedStmt(int nIndex, int rows)
+{
+    if (rows < 2)
+        return -1;
+
+    LOCK_GUARD _guard(m_stmtGuard);
+
+    std::pair<int, int> key(nIndex, rows);
+    BatchedStmtRegistry::const_iterator iter = m_batchedStmts.find(key);
+    if (iter != m_batchedStmts.end())
+        return iter->second;
+
+    int nBatchId = -1;
+    std::string batched;
+    if (MakeBatchedStmt(GetStmtStringUnlocked(nIndex), rows, batched))
+        nBatchId = RegisterStmt(batched);
+
+    m_batchedStmts[key] = nBatchId;
+    return nBatchId;
+}
+
 Database::TransHelper::~TransHelper()
 {
     reset();
@@ -26,6 +26,7 @@
 #include <ace/Recursive_Thread_Mutex.h>
 #include <ace/TSS_T.h>
 #include <ace/Atomic_Op.h>
+#include <map>
 #include "SqlPreparedStatement.h"
 
 class SqlTransaction;
@@ -33,6 +34,7 @@ class SqlResultQueue;
 class SqlQueryHolder;
 class SqlStmtParameters;
 class SqlParamBinder;
+class SqlOperation;
 class Database;
 
 #define MAX_QUERY_LEN   32*1024
@@ -105,7 +107,7 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char *infoString, int nConns = 1);
+        virtual bool Initialize(const char *infoString, int nConns = 1, int nAsyncConns = 1);
         //start worker thread for async DB request execution
         virtual void InitDelayThread();
         //stop worker thread
@@ -189,6 +191,8 @@ class Database
         bool RollbackTransaction();
         //for sync transaction execution
         bool CommitTransactionDirect();
+        //amount of statements in current thread transaction
+        size_t GetTransactionSize();
 
         //PREPARED STATEMENT API
         //allocate index for prepared statement with SQL request 'fmt'
@@ -206,6 +210,11 @@ class Database
         // must be called before finish thread run (one time for thread using one from existing Database objects)
         virtual void ThreadEnd();
 
+        // open a connection for sync queries used only by current thread instead of the shared pool
+        bool OpenThreadConnection();
+        // close connection opened by OpenThreadConnection, must be called from the same thread
+        void CloseThreadConnection();
+
         // set database-wide result queue. also we should use object-bases and not thread-based result queues
         void ProcessResultQueue();
 
@@ -222,11 +231,35 @@ class Database
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
         void EnableLogging() { m_enableLogging = true; }
 
+        /// Async connection pool
+
+        //queue operation on the async connection selected by current thread key (see SqlAsyncKey)
+        //operations of one key keep their order, keyed operations of different keys may run concurrently
+        //unkeyed operations run on first connection after everything queued before them
+        bool DelayOperation(SqlOperation * op);
+
+        uint64 GetAsyncKey() const { return *m_asyncKey; }
+        void SetAsyncKey(uint64 key) { *m_asyncKey = key; }
+
+        uint32 GetAsyncPoolSize() const { return m_threadBodies.size(); }
+
+        //count of transactions rolled back so far, callers caching what they wrote compare it between writes
+        uint32 GetFailedTransactions() const { return m_failedTransactions.value(); }
+        void AddFailedTransaction() { ++m_failedTransactions; }
+        void GetAsyncStats(std::vector<SqlDelayStats>& stats);
+
+        //max amount of prepared requests merged into one multi-row statement
+        size_t GetBatchRows() const { return m_batchRows; }
+        //statement index of 'rows' tuples version of nIndex INSERT/REPLACE, -1 if statement can't be merged
+        int GetBatchedStmt(int nIndex, int rows);
+
     protected:
-        Database() : m_pAsyncConn(NULL), m_pResultQueue(NULL), m_threadBody(NULL), m_delayThread(NULL),
+        Database() : m_pAsyncConn(NULL), m_pResultQueue(NULL), m_batchRows(0),
             m_logSQL(false), m_pingIntervalms(0), m_nQueryConnPoolSize(1), m_bAllowAsyncTransactions(false), m_iStmtIndex(-1)
         {
             m_nQueryCounter = -1;
+            m_threadConnCount = 0;
+            m_failedTransactions = 0;
             m_enableLogging = false;
         }
 
@@ -235,7 +268,7 @@ class Database
         //factory method to create SqlConnection objects
         virtual SqlConnection * CreateConnection() = 0;
         //factory method to create SqlDelayThread objects
-        virtual SqlDelayThread * CreateDelayThread();
+        virtual SqlDelayThread * CreateDelayThread(SqlConnection * conn, uint32 lane);
 
         class TransHelper
         {
@@ -264,7 +297,7 @@ class Database
 
         /// DB connections
 
-        //round-robin connection selection
+        //own connection of current thread if opened, else round-robin connection selection
         SqlConnection * getQueryConnection();
         //for now return one single connection for async requests
         SqlConnection * getAsyncConnection() const { return m_pAsyncConn; }
@@ -282,15 +315,28 @@ class Database
         //lets use pool of connections for sync queries
         typedef std::vector< SqlConnection * > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
+        ACE_TSS<ACE_TSS_Type_Adapter<SqlConnection*> > m_threadConn;  //own sync connection of current thread, NULL - none
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_threadConnCount;      //open thread connections, m_threadConn is checked only if any
+        std::string m_infoString;                                      //connection info, for thread connections
 
-        //only one single DB connection for transactions
+        //first async connection, unkeyed requests and direct transactions
         SqlConnection * m_pAsyncConn;
+        //whole async pool, m_pAsyncConns[0] == m_pAsyncConn
+        SqlConnectionContainer m_pAsyncConns;
 
         SqlResultQueue *    m_pResultQueue;                  /// Transaction queues from diff. threads
-        SqlDelayThread *    m_threadBody;                    /// Pointer to delay sql executer (owned by m_delayThread)
-        ACE_Based::Thread * m_delayThread;                   /// Pointer to executer thread
+        std::vector<SqlDelayThread*> m_threadBodies;         /// Delay sql executers, one per async connection (owned by m_delayThreads)
+        std::vector<ACE_Based::Thread*> m_delayThreads;      /// Executer threads
+
+        ACE_Thread_Mutex m_asyncLock;                        /// keeps fence snapshots consistent with queue order
+        ACE_TSS<ACE_TSS_Type_Adapter<uint64> > m_asyncKey;   /// ordering key of current thread, 0 - none
+
+        size_t m_batchRows;
+        typedef std::map<std::pair<int, int>, int> BatchedStmtRegistry;
+        BatchedStmtRegistry m_batchedStmts;                  /// (statement, rows) -> multi-row statement
 
         bool m_bAllowAsyncTransactions;                      /// flag which specifies if async transactions are enabled
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_failedTransactions;  /// rolled back transactions, see GetFailedTransactions
 
         //PREPARED STATEMENT REGISTRY
         typedef ACE_Thread_Mutex LOCK_TYPE;
@@ -303,6 +349,10 @@ class Database
 
         int m_iStmtIndex;
 
+        //register fmt and return its index, m_stmtGuard must be held
+        int RegisterStmt(const std::string& fmt);
+        std::string GetStmtStringUnlocked(const int stmtId) const;
+
     private:
 
         bool m_logSQL;
@@ -312,4 +362,16 @@ class Database
         bool m_enableLogging;
 };
 
+//sets async ordering key of current thread for its lifetime, eg. character guid for saves
+class SqlAsyncKey
+{
+    public:
+        SqlAsyncKey(Database& db, uint64 key) : m_db(db), m_prevKey(db.GetAsyncKey()) { m_db.SetAsyncKey(key); }
+        ~SqlAsyncKey() { m_db.SetAsyncKey(m_prevKey); }
+
+    private:
+        Database& m_db;
+        uint64 m_prevKey;
+};
+
 #endif
@@ -22,14 +22,23 @@
 #include "DatabaseEnv.h"
 #include "../Timer.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, uint32 lane) : m_dbEngine(db), m_dbConnection(conn), m_lane(lane), m_running(true),
+    m_doneCondition(m_doneLock)
 {
+    m_queued.store(0);
+    m_done.store(0);
+    m_coalesced.store(0);
+    m_latencySum.store(0);
+    m_latencyCount.store(0);
+    m_latencyMax.store(0);
+
     m_dbEngine->ThreadStart();
 }
 
 SqlDelayThread::~SqlDelayThread()
 {
     //process all requests which might have been queued while thread was stopping
+    //Database::HaltDelayThread already drained requests fenced by other threads
     ProcessRequests();
     m_dbEngine->ThreadEnd();
 }
@@ -53,7 +62,8 @@ void SqlDelayThread::run()
 
         ProcessRequests();
 
-        if((loopCounter++) >= pingEveryLoop)
+        // first thread of the pool keeps all connections alive
+        if (m_lane == 0 && (loopCounter++) >= pingEveryLoop)
         {
             volatile uint32 diff = WorldTimer::getMSTimeDiffToNow(lastPing);
             loopCounter = 0;
@@ -72,12 +82,127 @@ void SqlDelayThread::Stop()
     m_running = false;
 }
 
-void SqlDelayThread::ProcessRequests()
+bool SqlDelayThread::Delay(SqlOperation* sql, const SqlFence& fence)
+{
+    SqlQueuedOperation queued;
+    queued.op = sql;
+    queued.queueTime = WorldTimer::getMSTime();
+    queued.fence = fence;
+
+    m_queued++;
+    m_sqlQueue.add(queued);
+    return true;
+}
+
+bool SqlDelayThread::WaitFence(const SqlFence& fence)
+{
+    for (SqlFence::const_iterator itr = fence.begin(); itr != fence.end(); ++itr)
+        if (!itr->first->WaitDone(itr->second, m_running))
+            return false;
+
+    return true;
+}
+
+bool SqlDelayThread::WaitDone(uint64 done, volatile bool const& waiterRunning)
+{
+    if (GetDone() >= done)
+        return true;
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_doneLock, false);
+    while (GetDone() < done)
+    {
+        // stopping, other thread may be waiting for us in Database::HaltDelayThread
+        if (!waiterRunning)
+            return false;
+
+        // Stop() of waiting thread does not signal us, so do not wait through it
+        ACE_Time_Value timeout = ACE_OS::gettimeofday() + ACE_Time_Value(0, 100000);
+        m_doneCondition.wait(&timeout);
+    }
+
+    return true;
+}
+
+void SqlDelayThread::NotifyDone()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_doneLock);
+    m_doneCondition.broadcast();
+}
+
+void SqlDelayThread::Finish(SqlQueuedOperation& sql)
+{
+    delete sql.op;
+    sql.op = NULL;
+
+    uint32 latency = WorldTimer::getMSTimeDiffToNow(sql.queueTime);
+    m_latencySum += latency;
+    m_latencyCount++;
+
+    uint32 max = m_latencyMax.load(std::memory_order_relaxed);
+    while (latency > max && !m_latencyMax.compare_exchange_weak(max, latency));
+
+    m_done.fetch_add(1, std::memory_order_release);
+}
+
+bool SqlDelayThread::ProcessRequests()
 {
-    SqlOperation* s = NULL;
+    SqlQueuedOperation s;
     while (m_sqlQueue.next(s))
+        m_pending.push_back(s);
+
+    const size_t batchRows = m_dbEngine->GetBatchRows();
+    std::vector<SqlPreparedRequest*> batch;
+
+    size_t i = 0;
+    while (i < m_pending.size() && WaitFence(m_pending[i].fence))
     {
-        s->Execute(m_dbConnection);
-        delete s;
+        SqlPreparedRequest* prepared = m_pending[i].op->ToPreparedRequest();
+        if (!prepared || batchRows < 2)
+        {
+            m_pending[i].op->Execute(m_dbConnection);
+            Finish(m_pending[i]);
+            NotifyDone();
+            ++i;
+            continue;
+        }
+
+        // merge following requests of the same statement into one multi-row execute
+        batch.clear();
+        batch.push_back(prepared);
+
+        size_t end = i + 1;
+        for (; end < m_pending.size() && batch.size() < batchRows; ++end)
+        {
+            SqlPreparedRequest* next = m_pending[end].op->ToPreparedRequest();
+            if (!next || next->GetIndex() != prepared->GetIndex() || !WaitFence(m_pending[end].fence))
+                break;
+
+            batch.push_back(next);
+        }
+
+        SqlPreparedRequest::ExecuteBatch(m_dbConnection, batch);
+
+        if (batch.size() > 1)
+            m_coalesced += batch.size();
+
+        for (; i < end; ++i)
+            Finish(m_pending[i]);
+
+        NotifyDone();
     }
+
+    m_pending.erase(m_pending.begin(), m_pending.begin() + i);
+    return m_pending.empty();
+}
+
+void SqlDelayThread::GetStats(SqlDelayStats& stats)
+{
+    stats.queued = GetQueued();
+    stats.executed = GetDone();
+    stats.coalesced = m_coalesced.load();
+
+    uint64 sum = m_latencySum.exchange(0);
+    uint64 count = m_latencyCount.exchange(0);
+    stats.avgLatency = count ? uint32(sum / count) : 0;
+    stats.maxLatency = m_latencyMax.exchange(0);
 }
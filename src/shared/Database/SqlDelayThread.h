@@ -21,33 +21,81 @@
 #define HELLGROUND_SQLDELAYTHREAD_H
 
 #include "ace/Thread_Mutex.h"
+#include "ace/Condition_Thread_Mutex.h"
 #include "LockedQueue.h"
 #include "Threading.h"
 
+#include <atomic>
+#include <vector>
 
 class Database;
 class SqlOperation;
 class SqlConnection;
+class SqlDelayThread;
+
+/// Requests queued on other delay threads which must finish before a request may run
+typedef std::vector<std::pair<SqlDelayThread*, uint64> > SqlFence;
+
+/// Snapshot of one async connection, latency is measured from Delay() till the end of execution
+struct SqlDelayStats
+{
+    uint64 queued;
+    uint64 executed;
+    uint64 coalesced;                                       // requests merged into multi-row statements
+    uint32 avgLatency;                                      // ms, since previous snapshot
+    uint32 maxLatency;                                      // ms, since previous snapshot
+};
 
 class SqlDelayThread : public ACE_Based::Runnable
 {
-    typedef ACE_Based::LockedQueue<SqlOperation*, ACE_Thread_Mutex> SqlQueue;
+    struct SqlQueuedOperation
+    {
+        SqlOperation* op;
+        uint32 queueTime;
+        SqlFence fence;
+    };
+
+    typedef ACE_Based::LockedQueue<SqlQueuedOperation, ACE_Thread_Mutex> SqlQueue;
 
     private:
         SqlQueue m_sqlQueue;                                /// Queue of SQL statements
         Database* m_dbEngine;                               /// Pointer to used Database engine
         SqlConnection * m_dbConnection;                     /// Pointer to DB connection
+        uint32 m_lane;                                      /// Index in Database async pool, 0 pings connections
         volatile bool m_running;
 
-        //process all enqueued requests
-        void ProcessRequests();
+        std::vector<SqlQueuedOperation> m_pending;          /// Requests taken from queue in current pass
+
+        std::atomic<uint64> m_queued;
+        std::atomic<uint64> m_done;
+        std::atomic<uint64> m_coalesced;
+        std::atomic<uint64> m_latencySum;
+        std::atomic<uint64> m_latencyCount;
+        std::atomic<uint32> m_latencyMax;
+
+        ACE_Thread_Mutex m_doneLock;                        /// Guards m_doneCondition
+        ACE_Condition_Thread_Mutex m_doneCondition;         /// Signalled when executed requests are committed
+
+        //false when stopped while fence is not reached yet
+        bool WaitFence(const SqlFence& fence);
+        //blocks until done requests of this thread reach given count, false when waiter is stopped first
+        bool WaitDone(uint64 done, volatile bool const& waiterRunning);
+        void NotifyDone();
+        void Finish(SqlQueuedOperation& sql);
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, uint32 lane = 0);
         ~SqlDelayThread();
 
-        /// Put sql statement to delay queue
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        /// Put sql statement to delay queue, it runs after every request listed in fence
+        bool Delay(SqlOperation* sql, const SqlFence& fence = SqlFence());
+
+        uint64 GetQueued() const { return m_queued.load(std::memory_order_acquire); }
+        uint64 GetDone() const { return m_done.load(std::memory_order_acquire); }
+        void GetStats(SqlDelayStats& stats);
+
+        //process all enqueued requests, false if some wait for other threads and thread is stopped
+        bool ProcessRequests();
 
         virtual void Stop();                                /// Stop event
         virtual void run();                                 /// Main Thread loop
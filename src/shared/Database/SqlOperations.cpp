@@ -51,18 +51,51 @@ bool SqlTransaction::Execute(SqlConnection *conn)
 
     conn->BeginTransaction();
 
+    const size_t batchRows = conn->DB().GetBatchRows();
+    std::vector<SqlPreparedRequest*> batch;
+
     const int nItems = m_queue.size();
-    for (int i = 0; i < nItems; ++i)
+    for (int i = 0; i < nItems;)
     {
-        SqlOperation * pStmt = m_queue[i];
-        if(!pStmt->Execute(conn))
+        SqlOperation * pStmt = m_queue[i++];
+        SqlPreparedRequest * pPrepared = pStmt->ToPreparedRequest();
+
+        bool result;
+        if (pPrepared && batchRows > 1)
+        {
+            //item/spell/aura saves repeat one statement for every row
+            batch.clear();
+            batch.push_back(pPrepared);
+
+            for (; i < nItems && batch.size() < batchRows; ++i)
+            {
+                SqlPreparedRequest * pNext = m_queue[i]->ToPreparedRequest();
+                if (!pNext || pNext->GetIndex() != pPrepared->GetIndex())
+                    break;
+
+                batch.push_back(pNext);
+            }
+
+            result = SqlPreparedRequest::ExecuteBatch(conn, batch);
+        }
+        else
+            result = pStmt->Execute(conn);
+
+        if(!result)
         {
             conn->RollbackTransaction();
+            conn->DB().AddFailedTransaction();
             return false;
         }
     }
 
-    return conn->CommitTransaction();
+    if (!conn->CommitTransaction())
+    {
+        conn->DB().AddFailedTransaction();
+        return false;
+    }
+
+    return true;
 }
 
 SqlPreparedRequest::SqlPreparedRequest(int nIndex, SqlStmtParameters * arg ) : m_nIndex(nIndex), m_param(arg)
@@ -80,6 +113,39 @@ bool SqlPreparedRequest::Execute( SqlConnection *conn )
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+bool SqlPreparedRequest::ExecuteBatch(SqlConnection *conn, const std::vector<SqlPreparedRequest*>& requests)
+{
+    if (requests.empty())
+        return true;
+
+    LOCK_DB_CONN(conn);
+
+    if (requests.size() > 1)
+    {
+        int nBatchIndex = conn->DB().GetBatchedStmt(requests[0]->m_nIndex, requests.size());
+        if (nBatchIndex != -1)
+        {
+            SqlStmtParameters params(requests.size() * requests[0]->m_param->boundParams());
+            for (size_t i = 0; i < requests.size(); ++i)
+            {
+                SqlStmtParameters::ParameterContainer const& args = requests[i]->m_param->params();
+                for (SqlStmtParameters::ParameterContainer::const_iterator itr = args.begin(); itr != args.end(); ++itr)
+                    params.addParam(*itr);
+            }
+
+            //no row by row retry on failure: on non-transactional tables rows before the failing one
+            //stay inserted and would be applied twice, the transaction is rolled back anyway
+            return conn->ExecuteStmt(nBatchIndex, params);
+        }
+    }
+
+    bool result = true;
+    for (size_t i = 0; i < requests.size(); ++i)
+        result = conn->ExecuteStmt(requests[i]->m_nIndex, *requests[i]->m_param) && result;
+
+    return result;
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection *conn)
@@ -107,15 +173,15 @@ void SqlResultQueue::Update()
     }
 }
 
-bool SqlQueryHolder::Execute(Hellground::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue)
+bool SqlQueryHolder::Execute(Hellground::IQueryCallback * callback, Database *db, SqlResultQueue *queue)
 {
-    if(!callback || !thread || !queue)
+    if(!callback || !db || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
     SqlQueryHolderEx *holderEx = new SqlQueryHolderEx(this, callback, queue);
-    thread->Delay(holderEx);
+    db->DelayOperation(holderEx);
     return true;
 }
 
@@ -34,6 +34,7 @@ class Database;
 class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
+class SqlPreparedRequest;
 
 class SqlOperation
 {
@@ -41,6 +42,9 @@ class SqlOperation
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection *conn) = 0;
         virtual ~SqlOperation() {}
+
+        //requests of the same prepared statement may be merged, see SqlPreparedRequest::ExecuteBatch
+        virtual SqlPreparedRequest* ToPreparedRequest() { return NULL; }
 };
 
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
@@ -65,6 +69,7 @@ class SqlTransaction : public SqlOperation
         ~SqlTransaction();
 
         void DelayExecute(SqlOperation * sql)   {   m_queue.push_back(sql); }
+        size_t size() const { return m_queue.size(); }
 
         bool Execute(SqlConnection *conn);
 };
@@ -76,6 +81,12 @@ class SqlPreparedRequest : public SqlOperation
         ~SqlPreparedRequest();
     
         bool Execute(SqlConnection *conn);
+        SqlPreparedRequest* ToPreparedRequest() { return this; }
+
+        int GetIndex() const { return m_nIndex; }
+
+        //execute requests of one statement as single multi-row INSERT/REPLACE when possible
+        static bool ExecuteBatch(SqlConnection *conn, const std::vector<SqlPreparedRequest*>& requests);
 
     private:
         const int m_nIndex;
@@ -124,7 +135,7 @@ class SqlQueryHolder
         void SetSize(size_t size);
         QueryResultAutoPtr GetResult(size_t index);
         void SetResult(size_t index, QueryResultAutoPtr result);
-        bool Execute(Hellground::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue);
+        bool Execute(Hellground::IQueryCallback * callback, Database *db, SqlResultQueue *queue);
 };
 
 class SqlQueryHolderEx : public SqlOperation
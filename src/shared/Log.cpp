@@ -25,6 +25,7 @@
 #include "Common.h"
 #include "Config/Config.h"
 #include "Util.h"
+#include "AsyncLog.h"
 
 const char* logToStr[LOG_MAX_FILES][3] =
 {     // file name conf        mode  timestamp conf name
@@ -95,6 +96,9 @@ void Log::SetLogFileLevel(char *Level)
 
 void Log::Initialize()
 {
+    /// Files get reopened below, writer thread must not touch them meanwhile
+    StopAsync();
+
     /// Common log files data
     m_logsDir = sConfig.GetStringDefault("LogsDir","");
     if(!m_logsDir.empty())
@@ -164,6 +168,65 @@ void Log::Initialize()
     if(sConfig.GetBoolDefault("LogFilter_VisibilityChanges", true))
         m_logFilter |= LOG_FILTER_VISIBILITY_CHANGES;
 
+    if (sConfig.GetBoolDefault("LogAsync", false))
+        StartAsync();
+}
+
+void Log::StartAsync()
+{
+    size_t bufferSize = sConfig.GetIntDefault("LogAsyncBufferSize", 256) * 1024;
+    AsyncLogPolicy policy = sConfig.GetIntDefault("LogAsyncFullPolicy", ASYNC_LOG_DROP) ? ASYNC_LOG_BLOCK : ASYNC_LOG_DROP;
+    uint32 flushInterval = sConfig.GetIntDefault("LogAsyncFlushInterval", 100);
+
+    m_asyncQueue = new AsyncLogQueue(*this, LOG_MAX_FILES + LOG_CHAT_MAX, bufferSize, policy);
+    m_asyncRunnable = new AsyncLogRunnable(*m_asyncQueue, flushInterval ? flushInterval : 1);
+    m_asyncThread = new ACE_Based::Thread(m_asyncRunnable);
+}
+
+void Log::StopAsync()
+{
+    if (!m_asyncQueue)
+        return;
+
+    m_asyncRunnable->Stop();
+    m_asyncThread->wait();
+    delete m_asyncThread;                                   // this also deletes m_asyncRunnable
+
+    // anything logged after the writer drained for the last time
+    m_asyncQueue->SetStopped();
+    m_asyncQueue->Drain();
+
+    AsyncLogQueue* queue = m_asyncQueue;
+    m_asyncQueue = NULL;
+    m_asyncRunnable = NULL;
+    m_asyncThread = NULL;
+    delete queue;
+}
+
+void Log::Flush()
+{
+    if (m_asyncQueue)
+        m_asyncQueue->Drain();
+}
+
+void Log::writeBatch(uint32 target, const char* data, size_t size)
+{
+    FILE* file = target < LOG_MAX_FILES ? logFile[target] : chatLogFile[target - LOG_MAX_FILES];
+    if (!file)
+        return;
+
+    if (fwrite(data, 1, size, file) != size && target < LOG_MAX_FILES)
+    {
+        // same recovery as synchronous outLog, reopen and retry once
+        logFile[target] = freopen(logFileNames[target].c_str(), logToStr[target][1], file);
+        if (!logFile[target])
+            return;
+
+        file = logFile[target];
+        fwrite(data, 1, size, file);
+    }
+
+    fflush(file);
 }
 
 FILE* Log::openLogFile(LogNames log)
@@ -485,6 +548,12 @@ void Log::outWhisp(uint32 account, const char * str, ...)
 
 void Log::outLog(LogNames log)
 {
+    if (logFile[log] && IsAsync(log))
+    {
+        m_asyncQueue->Write(log, "%s", "");
+        return;
+    }
+
     if (logFile[log])
     {
         // check for errors
@@ -519,7 +588,16 @@ void Log::outLog(LogNames log, const char * str, ...)
 
         printf("\n");
     }
-    
+
+    if (logFile[log] && IsAsync(log))
+    {
+        va_list ap;
+        va_start(ap, str);
+        m_asyncQueue->WriteV(log, str, ap);
+        va_end(ap);
+        return;
+    }
+
     if (logFile[log])
     {
         // check for errors
@@ -556,6 +634,12 @@ void Log::outChat(uint32 type, uint32 faction, const char* who, const char* str)
     if (!m_chatLogEnabled)
         return;
 
+    if (chatLogFile[type] && m_asyncQueue)
+    {
+        m_asyncQueue->Write(LOG_MAX_FILES + type, "%s: %s", who, str);
+        return;
+    }
+
     if (chatLogFile[type])
     {
         outTimestamp(chatLogFile[type]);
@@ -25,6 +25,14 @@
 #include "ace/Thread_Mutex.h"
 #include "Common.h"
 
+class AsyncLogQueue;
+class AsyncLogRunnable;
+
+namespace ACE_Based
+{
+    class Thread;
+}
+
 enum LogLevel
 {
     LOG_LVL_MINIMAL = 0,                                    // unconditional and errors
@@ -97,10 +105,13 @@ enum ChatLogs
 class Log
 {
     friend class ACE_Singleton<Log, ACE_Thread_Mutex>;
+    friend class AsyncLogQueue;
     Log();
 
     ~Log()
     {
+        StopAsync();
+
         for (uint8 i = LOG_DEFAULT; i < LOG_MAX_FILES; i++)
         {
             if (logFile[i] != NULL)
@@ -142,7 +153,15 @@ class Log
 
         bool IsLogEnabled(LogNames log) const { return logFile[log] != NULL; }
 
+        // write out records queued by async mode, no-op otherwise
+        void Flush();
+
     private:
+        void StartAsync();
+        void StopAsync();
+        bool IsAsync(LogNames log) const { return m_asyncQueue && log != LOG_STATUS && log != LOG_CRASH; }
+        void writeBatch(uint32 target, const char* data, size_t size);
+
         FILE* openLogFile(LogNames log);
         FILE* openLogFile(ChatLogs log);
         FILE* openGmlogPerAccount(uint32 account);
@@ -170,6 +189,11 @@ class Log
 
         std::string m_gmlog_filename_format;
         std::string m_whisplog_filename_format;
+
+        // async mode, outLog and outChat records are written by m_asyncThread
+        AsyncLogQueue* m_asyncQueue = NULL;
+        AsyncLogRunnable* m_asyncRunnable = NULL;
+        ACE_Based::Thread* m_asyncThread = NULL;
 };
 
 #define sLog (*ACE_Singleton<Log, ACE_Thread_Mutex>::instance())
@@ -192,6 +216,6 @@ void error_db_log(const char * str, ...) ATTR_PRINTF(1,2);
 //#define ASSERT(assertion) { if(!(assertion)) { fprintf(stderr, "\n%s:%i ASSERTION FAILED:\n  %s\n", __FILE__, __LINE__, #assertion); assert(#assertion &&0); } }
 
 // i think we should use this assert, cause we see asserts in log files, not only on console (mostly we dont't see it cause the server restarts)
-#define ASSERT(assertion) { if(!(assertion)) { error_log("ERROR: %s:%i ASSERTION FAILED:\n  %s\n", __FILE__, __LINE__, #assertion); assert(#assertion &&0); } }
+#define ASSERT(assertion) { if(!(assertion)) { error_log("ERROR: %s:%i ASSERTION FAILED:\n  %s\n", __FILE__, __LINE__, #assertion); sLog.Flush(); assert(#assertion &&0); } }
 
 #endif
@@ -0,0 +1,253 @@
+/*
+* Copyright (C) 2008-2015 Hellground <http://hellground.net/>
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+
+namespace ACE_Based
+{
+
+    /**
+     * Bounded lock-free queue for many producers and one consumer.
+     *
+     * Every slot carries a sequence number telling whether it is free for the
+     * producer owning position pos (seq == pos) or holds data for the consumer
+     * (seq == pos + 1). Producers claim positions with a CAS on the tail, the
+     * consumer owns the head alone, so add() never blocks and next() never
+     * touches a shared counter. Consumers may change between calls as long as
+     * they are externally serialized (eg. world thread vs map thread).
+     *
+     * Items added while the ring is full spill to a mutex guarded deque, up to
+     * limit items in total. Once something spilled, producers keep adding to the
+     * deque until the consumer drains it, so items of one producer stay ordered.
+     * The ring can stay small and memory is only taken by queues that fill up.
+     */
+    template <class T>
+        class MPSCQueue
+    {
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        //! Pad counters to separate cache lines, producers hammer _tail
+        static const size_t CACHE_LINE = 64;
+
+        Cell* _buffer;
+        size_t _mask;
+        char _pad0[CACHE_LINE];
+        std::atomic<size_t> _tail;
+        char _pad1[CACHE_LINE];
+        std::atomic<size_t> _head;
+        char _pad2[CACHE_LINE];
+
+        //! Items added while the ring was full, in order
+        ACE_Thread_Mutex _spillLock;
+        std::deque<T> _spill;
+        size_t _spillLimit;
+        std::atomic<bool> _spilled;
+
+        MPSCQueue(const MPSCQueue&);
+        MPSCQueue& operator=(const MPSCQueue&);
+
+        static size_t RoundCapacity(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+
+            return size;
+        }
+
+        public:
+
+            //! Create a queue with a ring of at least capacity items (rounded up to a power of two),
+            //! holding up to limit items in total. Nothing spills when limit is not above the ring size
+            explicit MPSCQueue(size_t capacity, size_t limit = 0)
+            {
+                size_t size = RoundCapacity(capacity);
+
+                _buffer = new Cell[size];
+                _mask = size - 1;
+                _spillLimit = limit > size ? limit - size : 0;
+                _spilled.store(false, std::memory_order_relaxed);
+
+                for (size_t i = 0; i < size; ++i)
+                    _buffer[i].sequence.store(i, std::memory_order_relaxed);
+
+                _tail.store(0, std::memory_order_relaxed);
+                _head.store(0, std::memory_order_relaxed);
+            }
+
+            //! Destroy a MPSCQueue, items left inside are not freed
+            ~MPSCQueue()
+            {
+                delete [] _buffer;
+            }
+
+            //! Adds an item to the queue, returns false when the queue holds limit items.
+            bool add(const T& item)
+            {
+                if (!_spilled.load(std::memory_order_acquire) && addToRing(item))
+                    return true;
+
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _spillLock, false);
+                if (_spill.size() >= _spillLimit)
+                    return false;
+
+                _spill.push_back(item);
+                _spilled.store(true, std::memory_order_release);
+                return true;
+            }
+
+            //! Gets the next result in the queue, if any.
+            bool next(T& result)
+            {
+                size_t pos = _head.load(std::memory_order_relaxed);
+                Cell& cell = _buffer[pos & _mask];
+
+                if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                    return nextSpilled(result, pos);
+
+                result = cell.data;
+                pop(cell, pos);
+                return true;
+            }
+
+            //! Gets the next result only if check.Process() accepts it, otherwise it stays queued.
+            template<class Checker>
+            bool next(T& result, Checker& check)
+            {
+                size_t pos = _head.load(std::memory_order_relaxed);
+                Cell& cell = _buffer[pos & _mask];
+
+                if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                {
+                    if (!spillReady(pos))
+                        return false;
+
+                    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _spillLock, false);
+                    if (_spill.empty() || !check.Process(_spill.front()))
+                        return false;
+
+                    result = _spill.front();
+                    popSpilled();
+                    return true;
+                }
+
+                result = cell.data;
+                if (!check.Process(result))
+                    return false;
+
+                pop(cell, pos);
+                return true;
+            }
+
+            //! Checks if the queue is empty, only meaningful for the consumer.
+            bool empty() const
+            {
+                size_t pos = _head.load(std::memory_order_relaxed);
+                return _buffer[pos & _mask].sequence.load(std::memory_order_acquire) != pos + 1 && !_spilled.load(std::memory_order_acquire);
+            }
+
+            //! Number of ring slots, allocated up front.
+            size_t capacity() const
+            {
+                return _mask + 1;
+            }
+
+            //! Max number of items the queue can hold.
+            size_t limit() const
+            {
+                return capacity() + _spillLimit;
+            }
+
+        private:
+
+            bool addToRing(const T& item)
+            {
+                Cell* cell;
+                size_t pos = _tail.load(std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    cell = &_buffer[pos & _mask];
+                    size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos);
+
+                    if (diff == 0)
+                    {
+                        if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if (diff < 0)
+                        return false;
+                    else
+                        pos = _tail.load(std::memory_order_relaxed);
+                }
+
+                cell->data = item;
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            //! Spilled items are newer than anything in the ring, including slots claimed but not written yet
+            bool spillReady(size_t head) const
+            {
+                return _spilled.load(std::memory_order_acquire) && _tail.load(std::memory_order_acquire) == head;
+            }
+
+            bool nextSpilled(T& result, size_t head)
+            {
+                if (!spillReady(head))
+                    return false;
+
+                ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _spillLock, false);
+                if (_spill.empty())
+                    return false;
+
+                result = _spill.front();
+                popSpilled();
+                return true;
+            }
+
+            //! Called with _spillLock held, producers go back to the ring once the deque is drained
+            void popSpilled()
+            {
+                _spill.pop_front();
+                if (_spill.empty())
+                    _spilled.store(false, std::memory_order_release);
+            }
+
+            void pop(Cell& cell, size_t pos)
+            {
+                cell.data = T();
+                cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+                _head.store(pos + 1, std::memory_order_relaxed);
+            }
+    };
+}
+
+#endif